@@ -11,7 +11,7 @@
 #include <assert.h>
 
 #define DISK0_BLKSIZE                   PGSIZE
-#define DISK0_BUFSIZE                   (4 * DISK0_BLKSIZE)
+#define DISK0_BUFSIZE                   (16 * DISK0_BLKSIZE)    // ide moves at most 128 sectors per command
 #define DISK0_BLK_NSECT                 (DISK0_BLKSIZE / SECTSIZE)
 
 static char *disk0_buffer;
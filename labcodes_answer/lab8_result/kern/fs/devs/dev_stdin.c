@@ -84,8 +84,8 @@ static int
 stdin_io(struct device *dev, struct iobuf *iob, bool write) {
     if (!write) {
         int ret;
-        if ((ret = dev_stdin_read(iob->io_base, iob->io_resid)) > 0) {
-            iob->io_resid -= ret;
+        if ((ret = dev_stdin_read(iob->io_base, iob->io_seglen)) > 0) {
+            iobuf_skip(iob, ret);
         }
         return ret;
     }
@@ -24,9 +24,9 @@ stdout_close(struct device *dev) {
 static int
 stdout_io(struct device *dev, struct iobuf *iob, bool write) {
     if (write) {
-        char *data = iob->io_base;
-        for (; iob->io_resid != 0; iob->io_resid --) {
-            cputchar(*data ++);
+        while (iob->io_resid != 0) {
+            cputchar(*(char *)(iob->io_base));
+            iobuf_skip(iob, 1);
         }
         return 0;
     }
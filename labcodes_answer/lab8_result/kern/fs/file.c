@@ -208,25 +208,25 @@ file_close(int fd) {
     return 0;
 }
 
-// read file
+// read/write file through iob, at pos or (if pos < 0) at the file position, which is moved on then
 int
-file_read(int fd, void *base, size_t len, size_t *copied_store) {
+file_io(int fd, struct iobuf *iob, off_t pos, bool write, size_t *copied_store) {
     int ret;
     struct file *file;
     *copied_store = 0;
     if ((ret = fd2file(fd, &file)) != 0) {
         return ret;
     }
-    if (!file->readable) {
+    if (!(write ? file->writable : file->readable)) {
         return -E_INVAL;
     }
     fd_array_acquire(file);
 
-    struct iobuf __iob, *iob = iobuf_init(&__iob, base, len, file->pos);
-    ret = vop_read(file->node, iob);
+    iob->io_offset = (pos < 0) ? file->pos : pos;
+    ret = write ? vop_write(file->node, iob) : vop_read(file->node, iob);
 
     size_t copied = iobuf_used(iob);
-    if (file->status == FD_OPENED) {
+    if (pos < 0 && file->status == FD_OPENED) {
         file->pos += copied;
     }
     *copied_store = copied;
@@ -234,30 +234,18 @@ file_read(int fd, void *base, size_t len, size_t *copied_store) {
     return ret;
 }
 
+// read file
+int
+file_read(int fd, void *base, size_t len, size_t *copied_store) {
+    struct iobuf __iob, *iob = iobuf_init(&__iob, base, len, 0);
+    return file_io(fd, iob, -1, 0, copied_store);
+}
+
 // write file
 int
 file_write(int fd, void *base, size_t len, size_t *copied_store) {
-    int ret;
-    struct file *file;
-    *copied_store = 0;
-    if ((ret = fd2file(fd, &file)) != 0) {
-        return ret;
-    }
-    if (!file->writable) {
-        return -E_INVAL;
-    }
-    fd_array_acquire(file);
-
-    struct iobuf __iob, *iob = iobuf_init(&__iob, base, len, file->pos);
-    ret = vop_write(file->node, iob);
-
-    size_t copied = iobuf_used(iob);
-    if (file->status == FD_OPENED) {
-        file->pos += copied;
-    }
-    *copied_store = copied;
-    fd_array_release(file);
-    return ret;
+    struct iobuf __iob, *iob = iobuf_init(&__iob, base, len, 0);
+    return file_io(fd, iob, -1, 1, copied_store);
 }
 
 // seek file
@@ -320,6 +308,27 @@ file_fsync(int fd) {
     return ret;
 }
 
+// allocate disk space for [pos, pos + len) of a regular file
+int
+file_fallocate(int fd, off_t pos, off_t len) {
+    int ret;
+    struct file *file;
+    if ((ret = fd2file(fd, &file)) != 0) {
+        return ret;
+    }
+    if (!file->writable) {
+        return -E_INVAL;
+    }
+    fd_array_acquire(file);
+
+    uint32_t type;
+    if ((ret = vop_gettype(file->node, &type)) == 0) {
+        ret = S_ISREG(type) ? vop_fallocate(file->node, pos, len) : -E_INVAL;
+    }
+    fd_array_release(file);
+    return ret;
+}
+
 // get file entry in DIR
 int
 file_getdirentry(int fd, struct dirent *direntp) {
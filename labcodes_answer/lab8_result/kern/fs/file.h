@@ -10,6 +10,7 @@
 struct inode;
 struct stat;
 struct dirent;
+struct iobuf;
 
 struct file {
     enum {
@@ -33,9 +34,11 @@ int file_open(char *path, uint32_t open_flags);
 int file_close(int fd);
 int file_read(int fd, void *base, size_t len, size_t *copied_store);
 int file_write(int fd, void *base, size_t len, size_t *copied_store);
+int file_io(int fd, struct iobuf *iob, off_t pos, bool write, size_t *copied_store);
 int file_seek(int fd, off_t pos, int whence);
 int file_fstat(int fd, struct stat *stat);
 int file_fsync(int fd);
+int file_fallocate(int fd, off_t pos, off_t len);
 int file_getdirentry(int fd, struct dirent *dirent);
 int file_dup(int fd1, int fd2);
 int file_pipe(int fd[]);
@@ -6,6 +6,7 @@
 #include <file.h>
 #include <sfs.h>
 #include <inode.h>
+#include <proc.h>
 #include <assert.h>
 //called when init_main proc start
 void
@@ -20,6 +21,47 @@ fs_cleanup(void) {
     vfs_cleanup();
 }
 
+/*
+ * The writeback thread syncs all mounted fs every FS_WRITEBACK_INTERVAL ticks, so
+ * dirty inodes and blocks reach the disk without waiting for an explicit sync.
+ * It's a child of init, started by fs_writeback_start, and it quits after one
+ * more sync once fs_writeback_stop is called.
+ */
+
+#define WRITEBACK_STEP                      10
+
+static bool writeback_stopped;
+
+static int
+writeback_main(void *arg) {
+    while (!writeback_stopped) {
+        int ticks;
+        // sleep by short steps, so a stop is seen soon
+        for (ticks = 0; ticks < FS_WRITEBACK_INTERVAL && !writeback_stopped; ticks += WRITEBACK_STEP) {
+            do_sleep(WRITEBACK_STEP);
+        }
+        vfs_sync();
+    }
+    return 0;
+}
+
+// fs_writeback_start - create the writeback thread, return its pid
+int
+fs_writeback_start(void) {
+    int pid;
+    writeback_stopped = 0;
+    if ((pid = kernel_thread(writeback_main, NULL, 0)) > 0) {
+        set_proc_name(find_proc(pid), "writeback");
+    }
+    return pid;
+}
+
+// fs_writeback_stop - ask the writeback thread to quit
+void
+fs_writeback_stop(void) {
+    writeback_stopped = 1;
+}
+
 void
 lock_files(struct files_struct *filesp) {
     down(&(filesp->files_sem));
@@ -13,8 +13,15 @@
 #define DISK0_DEV_NO        2
 #define DISK1_DEV_NO        3
 
+/* ticks between two syncs of the writeback thread, can be set by DEFS */
+#ifndef FS_WRITEBACK_INTERVAL
+#define FS_WRITEBACK_INTERVAL               500
+#endif
+
 void fs_init(void);
 void fs_cleanup(void);
+int fs_writeback_start(void);
+void fs_writeback_stop(void);
 
 struct inode;
 struct file;
@@ -14,7 +14,36 @@ struct iobuf *
 iobuf_init(struct iobuf *iob, void *base, size_t len, off_t offset) {
     iob->io_base = base;
     iob->io_offset = offset;
-    iob->io_len = iob->io_resid = len;
+    iob->io_len = iob->io_resid = iob->io_seglen = len;
+    iob->io_iov = NULL, iob->io_iovcnt = 0;
+    return iob;
+}
+
+// iobuf_nextseg - go on to the next non-empty segment if the current one is used up
+static void
+iobuf_nextseg(struct iobuf *iob) {
+    while (iob->io_seglen == 0 && iob->io_iovcnt != 0) {
+        iob->io_base = iob->io_iov->iov_base, iob->io_seglen = iob->io_iov->iov_len;
+        iob->io_iov ++, iob->io_iovcnt --;
+    }
+}
+
+/*
+ * iobuf_init_iov - init io buffer struct made of segments (iov, iovcnt), which are transferred in order.
+ *                  iov should be kept until the io is done.
+ */
+struct iobuf *
+iobuf_init_iov(struct iobuf *iob, struct iovec *iov, int iovcnt, off_t offset) {
+    int i;
+    iob->io_base = NULL;
+    iob->io_offset = offset;
+    iob->io_len = iob->io_seglen = 0;
+    for (i = 0; i < iovcnt; i ++) {
+        iob->io_len += iov[i].iov_len;
+    }
+    iob->io_resid = iob->io_len;
+    iob->io_iov = iov, iob->io_iovcnt = iovcnt;
+    iobuf_nextseg(iob);
     return iob;
 }
 
@@ -27,21 +56,21 @@ iobuf_init(struct iobuf *iob, void *base, size_t len, off_t offset) {
  */
 int
 iobuf_move(struct iobuf *iob, void *data, size_t len, bool m2b, size_t *copiedp) {
-    size_t alen;
-    if ((alen = iob->io_resid) > len) {
-        alen = len;
-    }
-    if (alen > 0) {
+    size_t alen, copied = 0;
+    while (len != 0 && (alen = iob->io_seglen) != 0) {
+        if (alen > len) {
+            alen = len;
+        }
         void *src = iob->io_base, *dst = data;
         if (m2b) {
             void *tmp = src;
             src = dst, dst = tmp;
         }
         memmove(dst, src, alen);
-        iobuf_skip(iob, alen), len -= alen;
+        iobuf_skip(iob, alen), data += alen, len -= alen, copied += alen;
     }
     if (copiedp != NULL) {
-        *copiedp = alen;
+        *copiedp = copied;
     }
     return (len == 0) ? 0 : -E_NO_MEM;
 }
@@ -52,26 +81,31 @@ iobuf_move(struct iobuf *iob, void *data, size_t len, bool m2b, size_t *copiedp)
  */
 int
 iobuf_move_zeros(struct iobuf *iob, size_t len, size_t *copiedp) {
-    size_t alen;
-    if ((alen = iob->io_resid) > len) {
-        alen = len;
-    }
-    if (alen > 0) {
+    size_t alen, copied = 0;
+    while (len != 0 && (alen = iob->io_seglen) != 0) {
+        if (alen > len) {
+            alen = len;
+        }
         memset(iob->io_base, 0, alen);
-        iobuf_skip(iob, alen), len -= alen;
+        iobuf_skip(iob, alen), len -= alen, copied += alen;
     }
     if (copiedp != NULL) {
-        *copiedp = alen;
+        *copiedp = copied;
     }
     return (len == 0) ? 0 : -E_NO_MEM;
 }
 
 /*
- * iobuf_skip - change the current position of io buffer
+ * iobuf_skip - change the current position of io buffer, across segments if needed
  */
 void
 iobuf_skip(struct iobuf *iob, size_t n) {
     assert(iob->io_resid >= n);
-    iob->io_base += n, iob->io_offset += n, iob->io_resid -= n;
+    while (n != 0) {
+        size_t alen = (iob->io_seglen < n) ? iob->io_seglen : n;
+        iob->io_base += alen, iob->io_offset += alen, iob->io_resid -= alen, iob->io_seglen -= alen;
+        n -= alen;
+        iobuf_nextseg(iob);
+    }
 }
 
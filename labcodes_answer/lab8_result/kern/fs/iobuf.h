@@ -2,20 +2,26 @@
 #define __KERN_FS_IOBUF_H__
 
 #include <defs.h>
+#include <uio.h>
 
 /*
- * iobuf is a buffer Rd/Wr status record
+ * iobuf is a buffer Rd/Wr status record. the buffer may be made of several segments
+ * (iobuf_init_iov), io_base points into the current one, which has io_seglen bytes left.
  */
 struct iobuf {
     void *io_base;     // the base addr of buffer (used for Rd/Wr)
     off_t io_offset;   // current Rd/Wr position in buffer, will have been incremented by the amount transferred
     size_t io_len;     // the length of buffer  (used for Rd/Wr)
     size_t io_resid;   // current resident length need to Rd/Wr, will have been decremented by the amount transferred.
+    size_t io_seglen;  // resident length of the segment io_base points into
+    struct iovec *io_iov;   // segments after the current one
+    int io_iovcnt;     // # of segments in io_iov
 };
 
 #define iobuf_used(iob)                         ((size_t)((iob)->io_len - (iob)->io_resid))
 
 struct iobuf *iobuf_init(struct iobuf *iob, void *base, size_t len, off_t offset);
+struct iobuf *iobuf_init_iov(struct iobuf *iob, struct iovec *iov, int iovcnt, off_t offset);
 int iobuf_move(struct iobuf *iob, void *data, size_t len, bool m2b, size_t *copiedp);
 int iobuf_move_zeros(struct iobuf *iob, size_t len, size_t *copiedp);
 void iobuf_skip(struct iobuf *iob, size_t n);
@@ -8,12 +8,27 @@
 #define WORD_TYPE           uint32_t
 #define WORD_BITS           (sizeof(WORD_TYPE) * CHAR_BIT)
 
+/* words are grouped, and # of set bits in every group is counted, so bitmap_alloc
+ * skips a full group without looking at its words. */
+#define GROUP_WORDS         32
+
 struct bitmap {
     uint32_t nbits;
     uint32_t nwords;
+    uint32_t ngroups;
     WORD_TYPE *map;
+    uint32_t *group_free;               // # of set bits in every group
 };
 
+// word_popcount - # of set bits in word
+static inline uint32_t
+word_popcount(WORD_TYPE word) {
+    word = word - ((word >> 1) & 0x55555555);
+    word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+    word = (word + (word >> 4)) & 0x0F0F0F0F;
+    return (word * 0x01010101) >> 24;
+}
+
 // bitmap_create - allocate a new bitmap object.
 struct bitmap *
 bitmap_create(uint32_t nbits) {
@@ -25,14 +40,16 @@ bitmap_create(uint32_t nbits) {
         return NULL;
     }
 
-    uint32_t nwords = ROUNDUP_DIV(nbits, WORD_BITS);
+    uint32_t nwords = ROUNDUP_DIV(nbits, WORD_BITS), ngroups = ROUNDUP_DIV(nwords, GROUP_WORDS);
     WORD_TYPE *map;
     if ((map = kmalloc(sizeof(WORD_TYPE) * nwords)) == NULL) {
-        kfree(bitmap);
-        return NULL;
+        goto failed_cleanup_bitmap;
+    }
+    if ((bitmap->group_free = kmalloc(sizeof(uint32_t) * ngroups)) == NULL) {
+        goto failed_cleanup_map;
     }
 
-    bitmap->nbits = nbits, bitmap->nwords = nwords;
+    bitmap->nbits = nbits, bitmap->nwords = nwords, bitmap->ngroups = ngroups;
     bitmap->map = memset(map, 0xFF, sizeof(WORD_TYPE) * nwords);
 
     /* mark any leftover bits at the end in use(0) */
@@ -46,30 +63,154 @@ bitmap_create(uint32_t nbits) {
             bitmap->map[ix] ^= (1 << overbits);
         }
     }
+    bitmap_recount(bitmap);
     return bitmap;
+
+failed_cleanup_map:
+    kfree(map);
+failed_cleanup_bitmap:
+    kfree(bitmap);
+    return NULL;
 }
 
-// bitmap_alloc - locate a cleared bit, set it, and return its index.
+// bitmap_recount - count the set bits of every group again after the raw data is changed, return # of set bits
+uint32_t
+bitmap_recount(struct bitmap *bitmap) {
+    uint32_t ix, total = 0;
+    memset(bitmap->group_free, 0, sizeof(uint32_t) * bitmap->ngroups);
+    for (ix = 0; ix < bitmap->nwords; ix ++) {
+        uint32_t n = word_popcount(bitmap->map[ix]);
+        bitmap->group_free[ix / GROUP_WORDS] += n, total += n;
+    }
+    return total;
+}
+
+// bitmap_take - clear the lowest set bit of word ix, which isn't 0
+static uint32_t
+bitmap_take(struct bitmap *bitmap, uint32_t ix, WORD_TYPE word) {
+    uint32_t offset = __builtin_ctz(word);
+    bitmap->map[ix] ^= (1 << offset);
+    bitmap->group_free[ix / GROUP_WORDS] --;
+    return ix * WORD_BITS + offset;
+}
+
+/*
+ * bitmap_alloc - locate a set bit at or after goal (wrapping around at the end), clear it, and
+ *                return its index. the rest of goal's group is searched word by word first, then
+ *                the groups after it, whose free counters tell which ones have any set bit.
+ */
 int
-bitmap_alloc(struct bitmap *bitmap, uint32_t *index_store) {
+bitmap_alloc(struct bitmap *bitmap, uint32_t goal, uint32_t *index_store) {
     WORD_TYPE *map = bitmap->map;
-    uint32_t ix, offset, nwords = bitmap->nwords;
-    for (ix = 0; ix < nwords; ix ++) {
-        if (map[ix] != 0) {
-            for (offset = 0; offset < WORD_BITS; offset ++) {
-                WORD_TYPE mask = (1 << offset);
-                if (map[ix] & mask) {
-                    map[ix] ^= mask;
-                    *index_store = ix * WORD_BITS + offset;
-                    return 0;
-                }
+    if (goal >= bitmap->nbits) {
+        goal = 0;
+    }
+    uint32_t ix = goal / WORD_BITS, group = ix / GROUP_WORDS, end, i;
+    WORD_TYPE word;
+    if (bitmap->group_free[group] != 0) {
+        // bits before goal in its word are skipped
+        if ((word = map[ix] & ~(((WORD_TYPE)1 << (goal % WORD_BITS)) - 1)) != 0) {
+            *index_store = bitmap_take(bitmap, ix, word);
+            return 0;
+        }
+        end = (group + 1) * GROUP_WORDS;
+        for (ix ++; ix < end && ix < bitmap->nwords; ix ++) {
+            if (map[ix] != 0) {
+                *index_store = bitmap_take(bitmap, ix, map[ix]);
+                return 0;
+            }
+        }
+    }
+    // goal's group comes last, for the bits before goal
+    for (i = 1; i <= bitmap->ngroups; i ++) {
+        group = (group + 1) % bitmap->ngroups;
+        if (bitmap->group_free[group] == 0) {
+            continue;
+        }
+        end = (group + 1) * GROUP_WORDS;
+        for (ix = group * GROUP_WORDS; ix < end && ix < bitmap->nwords; ix ++) {
+            if (map[ix] != 0) {
+                *index_store = bitmap_take(bitmap, ix, map[ix]);
+                return 0;
             }
-            assert(0);
         }
     }
     return -E_NO_MEM;
 }
 
+// bitmap_flip_range - flip bits [index, index + n), all of which are set (alloc) or all clear (free), a word at a time
+static void
+bitmap_flip_range(struct bitmap *bitmap, uint32_t index, uint32_t n, bool free) {
+    assert(index + n <= bitmap->nbits && index + n > index);
+    while (n != 0) {
+        uint32_t ix = index / WORD_BITS, offset = index % WORD_BITS;
+        uint32_t cnt = (n < WORD_BITS - offset) ? n : WORD_BITS - offset;
+        WORD_TYPE mask = (cnt == WORD_BITS) ? (WORD_TYPE)-1 : (((WORD_TYPE)1 << cnt) - 1) << offset;
+        assert((bitmap->map[ix] & mask) == (free ? 0 : mask));
+        bitmap->map[ix] ^= mask;
+        if (free) {
+            bitmap->group_free[ix / GROUP_WORDS] += cnt;
+        }
+        else {
+            bitmap->group_free[ix / GROUP_WORDS] -= cnt;
+        }
+        index += cnt, n -= cnt;
+    }
+}
+
+// bitmap_find_run - find n set bits in a row which start in [from, to), full groups and words are skipped
+static bool
+bitmap_find_run(struct bitmap *bitmap, uint32_t from, uint32_t to, uint32_t n, uint32_t *index_store) {
+    uint32_t index = from, len = 0;
+    while (index < to) {
+        uint32_t ix = index / WORD_BITS;
+        WORD_TYPE word = bitmap->map[ix];
+        if (index % (GROUP_WORDS * WORD_BITS) == 0 && bitmap->group_free[ix / GROUP_WORDS] == 0) {
+            index += GROUP_WORDS * WORD_BITS, len = 0;
+            continue;
+        }
+        if (index % WORD_BITS == 0 && (word == 0 || word == (WORD_TYPE)-1)) {
+            index += WORD_BITS, len = (word == 0) ? 0 : len + WORD_BITS;
+        }
+        else {
+            len = (word & ((WORD_TYPE)1 << (index % WORD_BITS))) ? len + 1 : 0;
+            index ++;
+        }
+        if (len >= n) {
+            *index_store = index - len;
+            return 1;
+        }
+    }
+    // a run may go on after to
+    while (len != 0 && index < bitmap->nbits && bitmap_test(bitmap, index)) {
+        if (++ len, ++ index, len >= n) {
+            *index_store = index - len;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * bitmap_alloc_range - locate n set bits in a row, the first such run at or after goal (wrapping
+ *                      around at the end), clear them, and return the index of the first one.
+ */
+int
+bitmap_alloc_range(struct bitmap *bitmap, uint32_t goal, uint32_t n, uint32_t *index_store) {
+    assert(n != 0);
+    if (goal >= bitmap->nbits) {
+        goal = 0;
+    }
+    uint32_t index;
+    if (!bitmap_find_run(bitmap, goal, bitmap->nbits, n, &index)
+            && (goal == 0 || !bitmap_find_run(bitmap, 0, goal, n, &index))) {
+        return -E_NO_MEM;
+    }
+    bitmap_flip_range(bitmap, index, n, 0);
+    *index_store = index;
+    return 0;
+}
+
 // bitmap_translate - according index, get the related word and mask
 static void
 bitmap_translate(struct bitmap *bitmap, uint32_t index, WORD_TYPE **word, WORD_TYPE *mask) {
@@ -94,11 +235,19 @@ bitmap_free(struct bitmap *bitmap, uint32_t index) {
     bitmap_translate(bitmap, index, &word, &mask);
     assert(!(*word & mask));
     *word |= mask;
+    bitmap->group_free[index / WORD_BITS / GROUP_WORDS] ++;
+}
+
+// bitmap_free_range - set bits [index, index + n), which are all clear
+void
+bitmap_free_range(struct bitmap *bitmap, uint32_t index, uint32_t n) {
+    bitmap_flip_range(bitmap, index, n, 1);
 }
 
 // bitmap_destroy - free memory contains bitmap
 void
 bitmap_destroy(struct bitmap *bitmap) {
+    kfree(bitmap->group_free);
     kfree(bitmap->map);
     kfree(bitmap);
 }
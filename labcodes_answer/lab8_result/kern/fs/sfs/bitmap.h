@@ -11,7 +11,10 @@
  *     bitmap_create  - allocate a new bitmap object.
  *                      Returns NULL on error.
  *     bitmap_getdata - return pointer to raw bit data (for I/O).
- *     bitmap_alloc   - locate a cleared bit, set it, and return its index.
+ *     bitmap_alloc   - locate a cleared bit at or after a goal, set it, and return its index.
+ *     bitmap_recount - recount bits after the raw data is changed.
+ *     bitmap_alloc_range - locate cleared bits in a row, set them, and return the first index.
+ *     bitmap_free_range  - clear set bits in a row.
  *     bitmap_mark    - set a clear bit by its index.
  *     bitmap_unmark  - clear a set bit by its index.
  *     bitmap_isset   - return whether a particular bit is set or not.
@@ -22,7 +25,10 @@
 struct bitmap;
 
 struct bitmap *bitmap_create(uint32_t nbits);                     // allocate a new bitmap object.
-int bitmap_alloc(struct bitmap *bitmap, uint32_t *index_store);   // locate a cleared bit, set it, and return its index.
+int bitmap_alloc(struct bitmap *bitmap, uint32_t goal, uint32_t *index_store);   // locate a cleared bit near goal, set it, and return its index.
+uint32_t bitmap_recount(struct bitmap *bitmap);                   // recount bits after raw data is changed, return # of free bits
+int bitmap_alloc_range(struct bitmap *bitmap, uint32_t goal, uint32_t n, uint32_t *index_store);  // locate n cleared bits in a row near goal, set them
+void bitmap_free_range(struct bitmap *bitmap, uint32_t index, uint32_t n);    // set n bits in a row to 1
 bool bitmap_test(struct bitmap *bitmap, uint32_t index);          // return whether a particular bit is set or not.
 void bitmap_free(struct bitmap *bitmap, uint32_t index);          // according index, set related bit to 1
 void bitmap_destroy(struct bitmap *bitmap);                       // free memory contains bitmap
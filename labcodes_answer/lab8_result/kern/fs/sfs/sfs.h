@@ -6,6 +6,7 @@
 #include <list.h>
 #include <sem.h>
 #include <unistd.h>
+#include <kmalloc.h>
 
 /*
  * Simple FS (SFS) definitions visible to ucore. This covers the on-disk format
@@ -19,8 +20,17 @@
 #define SFS_MAX_FNAME_LEN                           FS_MAX_FNAME_LEN        /* max length of filename */
 #define SFS_MAX_FILE_SIZE                           (1024UL * 1024 * 128)   /* max file size (128M) */
 #define SFS_BLKN_SUPER                              0                       /* block the superblock lives in */
-#define SFS_BLKN_ROOT                               1                       /* location of the root dir inode */
+#define SFS_BLKN_ROOT                               1                       /* location of the root dir inode (SFS_VERSION_BLKINODE) */
 #define SFS_BLKN_FREEMAP                            2                       /* 1st block of the freemap */
+#define SFS_INO_ROOT                                1                       /* inode number of the root dir */
+
+/* format revisions, see sfs_super.version */
+#define SFS_VERSION_BLKINODE                        0                       /* one inode per block, ino is its block number */
+#define SFS_VERSION_PACKED                          1                       /* inodes packed in the inode table */
+#define SFS_VERSION_DIRPACK                         2                       /* PACKED, and dir entries packed in dir blocks */
+#define SFS_VERSION_EXTENT                          3                       /* DIRPACK, and blocks of inode mapped by extents */
+#define SFS_VERSION_INLINE                          4                       /* EXTENT, and content of tiny files in inode */
+#define SFS_VERSION_JOURNAL                         5                       /* INLINE, and metadata written through journal */
 
 /* # of bits in a block */
 #define SFS_BLKBITS                                 (SFS_BLKSIZE * CHAR_BIT)
@@ -28,6 +38,9 @@
 /* # of entries in a block */
 #define SFS_BLK_NENTRY                              (SFS_BLKSIZE / sizeof(uint32_t))
 
+/* # of inodes in a block of the inode table */
+#define SFS_BLK_NINODE                              (SFS_BLKSIZE / sizeof(struct sfs_disk_inode))
+
 /* file types */
 #define SFS_TYPE_INVAL                              0       /* Should not appear on disk */
 #define SFS_TYPE_FILE                               1
@@ -42,20 +55,64 @@ struct sfs_super {
     uint32_t blocks;                                /* # of blocks in fs */
     uint32_t unused_blocks;                         /* # of unused blocks in fs */
     char info[SFS_MAX_INFO_LEN + 1];                /* infomation for sfs  */
+    uint32_t version;                               /* format revision, one of SFS_VERSION_* */
+    uint32_t ninodes;                               /* # of inodes in inode table (SFS_VERSION_PACKED) */
+    uint32_t inode_start;                           /* 1st block of inode table (SFS_VERSION_PACKED) */
+    uint32_t inode_blocks;                          /* # of blocks of inode table (SFS_VERSION_PACKED) */
+    uint32_t journal_start;                         /* 1st block of journal (SFS_VERSION_JOURNAL) */
+    uint32_t journal_blocks;                        /* # of blocks of journal (SFS_VERSION_JOURNAL) */
+    uint32_t mounted;                               /* true until the last sync, unused_blocks recounted if so */
 };
 
-/* inode (on disk) */
+/*
+ * extent (on disk) of SFS_VERSION_EXTENT: len blocks of the inode from logical block
+ * lblk on are the disk blocks from start on.
+ */
+struct sfs_extent {
+    uint32_t lblk;                                  /* 1st logical block */
+    uint32_t start;                                 /* 1st disk block */
+    uint32_t len;                                   /* # of blocks */
+};
+
+/* # of extents in inode */
+#define SFS_NEXTENT                                 4
+
+/* # of extents in a leaf block */
+#define SFS_BLK_NEXTENT                             (SFS_BLKSIZE / sizeof(struct sfs_extent))
+
+/*
+ * inode (on disk). In SFS_VERSION_EXTENT, direct/indirect are replaced by a two-level
+ * extent tree. With depth 0, extents[0, nextents) map the blocks, in order of lblk.
+ * With depth 1, every extents[i] is a leaf block (start) holding len extents, whose
+ * lblk is at most the lblk of its 1st extent. In SFS_VERSION_INLINE, a file with no blocks
+ * keeps its content (at most SFS_INLINE_SIZE bytes) in inline_data, and bytes after size are 0.
+ * A file may have holes: blocks not mapped (a 0 entry, or no extent covers them) read as
+ * zeros, and get a disk block when they are written.
+ */
 struct sfs_disk_inode {
     uint32_t size;                                  /* size of the file (in bytes) */
     uint16_t type;                                  /* one of SYS_TYPE_* above */
     uint16_t nlinks;                                /* # of hard links to this file */
-    uint32_t blocks;                                /* # of blocks */
-    uint32_t direct[SFS_NDIRECT];                   /* direct blocks */
-    uint32_t indirect;                              /* indirect blocks */
+    uint32_t blocks;                                /* # of blocks, holes included */
+    union {
+        struct {
+            uint32_t direct[SFS_NDIRECT];           /* direct blocks */
+            uint32_t indirect;                      /* indirect blocks */
+        };
+        struct {
+            uint16_t nextents;                      /* # of extents used */
+            uint16_t depth;                         /* depth of extent tree, 0 or 1 */
+            struct sfs_extent extents[SFS_NEXTENT]; /* extents, or leaves if depth is 1 */
+        };
+        char inline_data[(SFS_NDIRECT + 1) * sizeof(uint32_t)];    /* content of a tiny file */
+    };
 //    uint32_t db_indirect;                           /* double indirect blocks */
 //   unused
 };
 
+/* max size of file content kept in inode */
+#define SFS_INLINE_SIZE                             sizeof(((struct sfs_disk_inode *)0)->inline_data)
+
 /* file entry (on disk) */
 struct sfs_disk_entry {
     uint32_t ino;                                   /* inode number */
@@ -65,6 +122,65 @@ struct sfs_disk_entry {
 #define sfs_dentry_size                             \
     sizeof(((struct sfs_disk_entry *)0)->name)
 
+/*
+ * file entry record (on disk) of SFS_VERSION_DIRPACK, records are packed in dir
+ * blocks and never cross a block, the rec_len of all records in a block adds up
+ * to SFS_BLKSIZE. A record with ino 0 is free.
+ */
+struct sfs_disk_dirent {
+    uint32_t ino;                                   /* inode number */
+    uint16_t rec_len;                               /* length of the record, the next one follows */
+    uint16_t name_len;                              /* length of name, not NUL terminated */
+    char name[0];                                   /* file name */
+};
+
+/* length of the smallest record for a name with name_len chars */
+#define sfs_dirent_reclen(name_len)                 \
+    ROUNDUP(sizeof(struct sfs_disk_dirent) + (name_len), sizeof(uint32_t))
+
+/*
+ * hashed index of a big SFS_VERSION_DIRPACK dir (on disk). It lives in dir block 0
+ * right after the ".." record, whose rec_len covers the rest of the block, so the
+ * block still reads as "." and ".." without the index. entries are sorted by hash
+ * and entries[0].hash is 0: names with hash in [entries[i].hash, entries[i+1].hash)
+ * are all in dir block entries[i].block.
+ */
+#define SFS_DX_MAGIC                                0x78646673              /* "sfdx" */
+
+struct sfs_dx_entry {
+    uint32_t hash;                                  /* lowest hash of names in block */
+    uint32_t block;                                 /* logical index of dir block */
+};
+
+struct sfs_dx_root {
+    uint32_t magic;                                 /* magic number, should be SFS_DX_MAGIC */
+    uint32_t nleaves;                               /* # of entries */
+    struct sfs_dx_entry entries[0];
+};
+
+/*
+ * metadata journal (on disk) of SFS_VERSION_JOURNAL. block 0 of it is the header, transactions
+ * follow from block 1 on: a descriptor block, copies of the nblocks metadata blocks listed in it,
+ * and a commit block. At mount, transactions seq, seq + 1, ... (seq from the header) are written
+ * to their places, up to the first one without its commit block. A block revoked (freed) in a
+ * transaction isn't written from the copies in that or earlier transactions.
+ */
+#define SFS_JOURNAL_MAGIC                           0x6c6e726a              /* "jrnl", header */
+#define SFS_JOURNAL_DESC                            0x63736564              /* "desc", descriptor block */
+#define SFS_JOURNAL_COMMIT                          0x74696d63              /* "cmit", commit block */
+
+struct sfs_journal_block {
+    uint32_t magic;                                 /* one of SFS_JOURNAL_* above */
+    uint32_t seq;                                   /* 1st transaction to replay (header), or transaction */
+    uint32_t nblocks;                               /* # of blocks copied in transaction */
+    uint32_t nrevoked;                              /* # of blocks revoked in transaction (descriptor) */
+    uint32_t blknos[0];                             /* blocks copied, then blocks revoked (descriptor) */
+};
+
+/* # of block numbers in a descriptor block */
+#define SFS_JOURNAL_NTAG                            \
+    ((SFS_BLKSIZE - sizeof(struct sfs_journal_block)) / sizeof(uint32_t))
+
 /* inode for sfs */
 struct sfs_inode {
     struct sfs_disk_inode *din;                     /* on-disk inode */
@@ -74,23 +190,92 @@ struct sfs_inode {
     semaphore_t sem;                                /* semaphore for din */
     list_entry_t inode_link;                        /* entry for linked-list in sfs_fs */
     list_entry_t hash_link;                         /* entry for hash linked-list in sfs_fs */
+    list_entry_t lru_link;                          /* entry for lru linked-list of unused inodes in sfs_fs */
+    list_entry_t dirty_link;                        /* entry for linked-list of dirty inodes in sfs_fs */
+    uint32_t ra_next;                               /* logical block after the last read, a read from it is sequential */
+    uint32_t ra_end;                                /* logical blocks before it have been read ahead */
+    uint32_t ra_size;                               /* read-ahead window (in blocks), 0 if reads aren't sequential */
+    uint32_t *indirect_map;                         /* copy of the indirect block, NULL if not loaded */
 };
 
 #define le2sin(le, member)                          \
     to_struct((le), struct sfs_inode, member)
 
+/* cached disk block for sfs */
+struct sfs_buf {
+    uint32_t blkno;                                 /* block number, valid if in hash list */
+    bool dirty;                                     /* true if data modified */
+    bool jdirty;                                    /* true if metadata modified, and not in journal yet */
+    bool readahead;                                 /* true if loaded by read-ahead and not used yet */
+    void *data;                                     /* content of the block */
+    list_entry_t hash_link;                         /* entry for hash linked-list in sfs_bcache */
+    list_entry_t lru_link;                          /* entry for lru linked-list in sfs_bcache */
+};
+
+#define le2sbuf(le, member)                         \
+    to_struct((le), struct sfs_buf, member)
+
+/* block cache for sfs, between sfs_rwblock_nolock and the device */
+struct sfs_bcache {
+    struct sfs_buf *bufs;                           /* all buffers */
+    list_entry_t *hash_list;                        /* buffer hash linked-list */
+    list_entry_t lru_list;                          /* buffer linked-list, most recently used first */
+    void *ra_data;                                  /* SFS_RA_MAX blocks, a run of blocks is read into it by read-ahead */
+    uint32_t hits;                                  /* # of lookups found in cache */
+    uint32_t misses;                                /* # of lookups not found in cache */
+    uint32_t writebacks;                            /* # of dirty blocks written to disk */
+    uint32_t ra_blocks;                             /* # of blocks loaded by read-ahead */
+    uint32_t ra_hits;                               /* # of blocks loaded by read-ahead and used later */
+};
+
+/* # of runs of freed blocks a transaction keeps, it's committed to free more, can be set by DEFS */
+#ifndef SFS_JOURNAL_NFREE
+#define SFS_JOURNAL_NFREE                           64
+#endif
+
+/* metadata journal of sfs (SFS_VERSION_JOURNAL), see sfs_journal.c */
+struct sfs_journal {
+    uint32_t seq;                                   /* seq of the next transaction */
+    uint32_t pos;                                   /* where the next transaction goes in journal */
+    uint32_t sync_seq;                              /* # of sfs_journal_sync started */
+    uint32_t synced_seq;                            /* sync_seq of the last sfs_journal_sync succeeded */
+    uint32_t *jblocks;                              /* blocks copied in journal since last checkpoint */
+    uint32_t njblocks;                              /* # of blocks in jblocks */
+    uint32_t *revoked;                              /* blocks in jblocks freed in the next transaction */
+    uint32_t nrevoked;                              /* # of blocks in revoked */
+    struct {
+        uint32_t blkno;                             /* 1st block */
+        uint32_t nblks;                             /* # of blocks */
+    } freed[SFS_JOURNAL_NFREE];                     /* runs of blocks freed in the next transaction */
+    uint32_t nfreed;                                /* # of runs in freed */
+    bool syncing;                                   /* true while a commit copies dirty inodes into cache */
+    void *fsinfo;                                   /* superblock, then freemap, as in the last transaction */
+    void *buffer;                                   /* descriptor/commit block */
+    uint32_t commits;                               /* # of transactions written */
+    uint32_t blocks;                                /* # of blocks copied in journal */
+    uint32_t checkpoints;                           /* # of times journal is emptied */
+};
+
 /* filesystem for sfs */
 struct sfs_fs {
     struct sfs_super super;                         /* on-disk superblock */
     struct device *dev;                             /* device mounted on */
     struct bitmap *freemap;                         /* blocks in use are mared 0 */
     bool super_dirty;                               /* true if super/freemap modified */
+    bool *freemap_dirty;                            /* true for every freemap block modified */
+    uint32_t alloc_hint;                            /* where to look for a free block if there is no goal */
     void *sfs_buffer;                               /* buffer for non-block aligned io */
     semaphore_t fs_sem;                             /* semaphore for fs */
     semaphore_t io_sem;                             /* semaphore for io */
     semaphore_t mutex_sem;                          /* semaphore for link/unlink and rename */
     list_entry_t inode_list;                        /* inode linked-list */
     list_entry_t *hash_list;                        /* inode hash linked-list */
+    list_entry_t dirty_list;                        /* dirty inodes, the only ones sfs_sync writes */
+    struct sfs_bcache bcache;                       /* block cache */
+    struct sfs_journal journal;                     /* metadata journal */
+    list_entry_t lru_list;                          /* unused inodes kept in memory, most recently used first */
+    uint32_t lru_count;                             /* # of inodes in lru_list */
+    struct shrinker icache_shrinker;                /* frees unused inodes when memory is short */
 };
 
 /* hash for sfs */
@@ -98,19 +283,61 @@ struct sfs_fs {
 #define SFS_HLIST_SIZE                              (1 << SFS_HLIST_SHIFT)
 #define sin_hashfn(x)                               (hash32(x, SFS_HLIST_SHIFT))
 
+/* block cache for sfs, SFS_BCACHE_NBUF can be set by DEFS */
+#ifndef SFS_BCACHE_NBUF
+#define SFS_BCACHE_NBUF                             64
+#endif
+#define SFS_BCACHE_HSHIFT                           6
+#define SFS_BCACHE_HSIZE                            (1 << SFS_BCACHE_HSHIFT)
+#define sbuf_hashfn(x)                              (hash32(x, SFS_BCACHE_HSHIFT))
+
+/* read-ahead window (in blocks) of a sequential reader, grows from MIN to MAX, can be set by DEFS */
+#ifndef SFS_RA_MIN
+#define SFS_RA_MIN                                  4
+#endif
+#ifndef SFS_RA_MAX
+#define SFS_RA_MAX                                  16
+#endif
+
+/* max # of unused inodes kept in memory, can be set by DEFS */
+#ifndef SFS_ICACHE_NR
+#define SFS_ICACHE_NR                               64
+#endif
+
 /* size of freemap (in bits) */
 #define sfs_freemap_bits(super)                     ROUNDUP((super)->blocks, SFS_BLKBITS)
 
 /* size of freemap (in blocks) */
 #define sfs_freemap_blocks(super)                   ROUNDUP_DIV((super)->blocks, SFS_BLKBITS)
 
+/* true if inodes are packed in the inode table */
+#define sfs_inode_packed(sfs)                       ((sfs)->super.version >= SFS_VERSION_PACKED)
+
+/* true if dir entries are packed in dir blocks */
+#define sfs_dirent_packed(sfs)                      ((sfs)->super.version >= SFS_VERSION_DIRPACK)
+
+/* true if blocks of inodes are mapped by extents */
+#define sfs_inode_extent(sfs)                       ((sfs)->super.version >= SFS_VERSION_EXTENT)
+
+/* true if metadata is written through journal */
+#define sfs_journaled(sfs)                          ((sfs)->super.version >= SFS_VERSION_JOURNAL)
+
+/* max # of blocks copied in a transaction: block cache, superblock and freemap */
+#define sfs_journal_maxtrans(super)                 (SFS_BCACHE_NBUF + 1 + sfs_freemap_blocks(super))
+
+/* true if content of file is kept in inode */
+#define sfs_inode_inline(sfs, din)                  ((sfs)->super.version >= SFS_VERSION_INLINE       \
+                                                        && (din)->type == SFS_TYPE_FILE && (din)->blocks == 0)
+
 struct fs;
 struct inode;
 
 void sfs_init(void);
 int sfs_mount(const char *devname);
+void sfs_inode_cache_init(void);
 
 void lock_sfs_fs(struct sfs_fs *sfs);
+bool try_lock_sfs_fs(struct sfs_fs *sfs);
 void lock_sfs_io(struct sfs_fs *sfs);
 void unlock_sfs_fs(struct sfs_fs *sfs);
 void unlock_sfs_io(struct sfs_fs *sfs);
@@ -119,11 +346,37 @@ int sfs_rblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks);
 int sfs_wblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks);
 int sfs_rbuf(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset);
 int sfs_wbuf(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset);
-int sfs_sync_super(struct sfs_fs *sfs);
-int sfs_sync_freemap(struct sfs_fs *sfs);
+int sfs_wblock_data(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks);
+int sfs_wbuf_data(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset);
+int sfs_rablock(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks);
+int sfs_sync_fsinfo_nolock(struct sfs_fs *sfs);
+void sfs_dirty_freemap(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks);
 int sfs_clear_block(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks);
+int sfs_zbuf(struct sfs_fs *sfs, size_t len, uint32_t blkno, off_t offset);
+int sfs_zbuf_data(struct sfs_fs *sfs, size_t len, uint32_t blkno, off_t offset);
+
+int sfs_bcache_init(struct sfs_fs *sfs);
+void sfs_bcache_destroy(struct sfs_fs *sfs);
+struct sfs_buf *sfs_bcache_find_nolock(struct sfs_fs *sfs, uint32_t blkno);
+struct sfs_buf *sfs_bcache_lookup_nolock(struct sfs_fs *sfs, uint32_t blkno);
+int sfs_bcache_get_nolock(struct sfs_fs *sfs, uint32_t blkno, bool load, struct sfs_buf **sbuf_store);
+int sfs_bcache_readahead_nolock(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks);
+void sfs_bcache_dirty_nolock(struct sfs_fs *sfs, struct sfs_buf *sbuf, bool meta);
+int sfs_bcache_flush_nolock(struct sfs_fs *sfs);
+int sfs_bcache_flush(struct sfs_fs *sfs);
+
+int sfs_journal_init(struct sfs_fs *sfs);
+void sfs_journal_destroy(struct sfs_fs *sfs);
+void sfs_journal_free(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks);
+int sfs_journal_commit_nolock(struct sfs_fs *sfs);
+int sfs_journal_checkpoint_nolock(struct sfs_fs *sfs);
+int sfs_journal_sync(struct sfs_fs *sfs);
 
 int sfs_load_inode(struct sfs_fs *sfs, struct inode **node_store, uint32_t ino);
+int sfs_sync_inode(struct sfs_fs *sfs, struct sfs_inode *sin);
+int sfs_sync_inodes_nolock(struct sfs_fs *sfs);
+void sfs_icache_init(struct sfs_fs *sfs);
+size_t sfs_icache_shrink(struct sfs_fs *sfs);
 
 #endif /* !__KERN_FS_SFS_SFS_H__ */
 
@@ -0,0 +1,273 @@
+#include <defs.h>
+#include <string.h>
+#include <stdlib.h>
+#include <kmalloc.h>
+#include <list.h>
+#include <dev.h>
+#include <sfs.h>
+#include <iobuf.h>
+#include <error.h>
+#include <assert.h>
+
+/*
+ * Block cache of sfs. SFS_BCACHE_NBUF buffers are allocated when sfs is mounted,
+ * and disk blocks are read/written through them (see sfs_rwblock_nolock), only
+ * multi-block requests of file data go to disk directly (see sfs_rwblocks_nolock).
+ * A cached block is found by the hash list, and the least recently used buffer
+ * is reused for a block not in cache. Writes only make the buffer dirty, the
+ * block is written to disk when the buffer is reused or sfs_bcache_flush is
+ * called (by sfs_sync). Blocks a sequential reader will need soon are loaded by
+ * sfs_bcache_readahead_nolock (see sfs_readahead_nolock in sfs_inode.c).
+ * With a journal, modified metadata blocks are kept in cache (jdirty) until they
+ * are committed to the journal, only then they may be written in place.
+ *
+ * All functions with _nolock should be called with lock_sfs_io held.
+ */
+
+/*
+ * sfs_bcache_init - alloc buffers and hash list for block cache, called by sfs_do_mount.
+ */
+int
+sfs_bcache_init(struct sfs_fs *sfs) {
+    struct sfs_bcache *bc = &(sfs->bcache);
+    bc->hits = bc->misses = bc->writebacks = 0;
+    bc->ra_blocks = bc->ra_hits = 0;
+    list_init(&(bc->lru_list));
+
+    if ((bc->hash_list = kmalloc(sizeof(list_entry_t) * SFS_BCACHE_HSIZE)) == NULL) {
+        goto failed;
+    }
+    if ((bc->ra_data = kmalloc(SFS_RA_MAX * SFS_BLKSIZE)) == NULL) {
+        goto failed_cleanup_hash_list;
+    }
+    if ((bc->bufs = kmalloc(sizeof(struct sfs_buf) * SFS_BCACHE_NBUF)) == NULL) {
+        goto failed_cleanup_ra_data;
+    }
+
+    int i;
+    for (i = 0; i < SFS_BCACHE_HSIZE; i ++) {
+        list_init(bc->hash_list + i);
+    }
+    for (i = 0; i < SFS_BCACHE_NBUF; i ++) {
+        struct sfs_buf *sbuf = bc->bufs + i;
+        if ((sbuf->data = kmalloc(SFS_BLKSIZE)) == NULL) {
+            goto failed_cleanup_bufs;
+        }
+        sbuf->dirty = sbuf->jdirty = sbuf->readahead = 0;
+        list_init(&(sbuf->hash_link));
+        list_add_before(&(bc->lru_list), &(sbuf->lru_link));
+    }
+    return 0;
+
+failed_cleanup_bufs:
+    while (-- i >= 0) {
+        kfree(bc->bufs[i].data);
+    }
+    kfree(bc->bufs);
+failed_cleanup_ra_data:
+    kfree(bc->ra_data);
+failed_cleanup_hash_list:
+    kfree(bc->hash_list);
+failed:
+    return -E_NO_MEM;
+}
+
+/*
+ * sfs_bcache_destroy - free block cache, all dirty blocks should have been flushed.
+ */
+void
+sfs_bcache_destroy(struct sfs_fs *sfs) {
+    struct sfs_bcache *bc = &(sfs->bcache);
+    int i;
+    for (i = 0; i < SFS_BCACHE_NBUF; i ++) {
+        assert(!bc->bufs[i].dirty);
+        kfree(bc->bufs[i].data);
+    }
+    kfree(bc->bufs);
+    kfree(bc->ra_data);
+    kfree(bc->hash_list);
+}
+
+/*
+ * sfs_bcache_writeback_nolock - write a dirty buffer into disk.
+ */
+static int
+sfs_bcache_writeback_nolock(struct sfs_fs *sfs, struct sfs_buf *sbuf) {
+    assert(sbuf->dirty && !sbuf->jdirty);
+    struct iobuf __iob, *iob = iobuf_init(&__iob, sbuf->data, SFS_BLKSIZE, sbuf->blkno * SFS_BLKSIZE);
+    int ret;
+    if ((ret = dop_io(sfs->dev, iob, 1)) == 0) {
+        sbuf->dirty = 0;
+        sfs->bcache.writebacks ++;
+    }
+    return ret;
+}
+
+// sfs_bcache_find_nolock - find the buffer of block blkno, return NULL if it isn't in cache
+struct sfs_buf *
+sfs_bcache_find_nolock(struct sfs_fs *sfs, uint32_t blkno) {
+    list_entry_t *list = sfs->bcache.hash_list + sbuf_hashfn(blkno), *le = list;
+    while ((le = list_next(le)) != list) {
+        struct sfs_buf *sbuf = le2sbuf(le, hash_link);
+        if (sbuf->blkno == blkno) {
+            return sbuf;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * sfs_bcache_lookup_nolock - find the buffer of block blkno for use, return NULL if it isn't in cache.
+ *                            the lru order isn't changed, no buffer is reused.
+ */
+struct sfs_buf *
+sfs_bcache_lookup_nolock(struct sfs_fs *sfs, uint32_t blkno) {
+    struct sfs_buf *sbuf;
+    if ((sbuf = sfs_bcache_find_nolock(sfs, blkno)) != NULL && sbuf->readahead) {
+        sbuf->readahead = 0;
+        sfs->bcache.ra_hits ++;
+    }
+    return sbuf;
+}
+
+/*
+ * sfs_bcache_alloc_nolock - reuse the least recently used buffer for block blkno, which isn't in cache.
+ *                           buffers waiting for journal are skipped, they're committed if all are.
+ * @load:       BOOL: read the block from disk
+ */
+static int
+sfs_bcache_alloc_nolock(struct sfs_fs *sfs, uint32_t blkno, bool load, struct sfs_buf **sbuf_store) {
+    struct sfs_bcache *bc = &(sfs->bcache);
+    list_entry_t *le = &(bc->lru_list);
+    struct sfs_buf *sbuf;
+    int ret;
+    do {
+        if ((le = list_prev(le)) == &(bc->lru_list)) {
+            if ((ret = sfs_journal_commit_nolock(sfs)) != 0) {
+                return ret;
+            }
+            le = list_prev(le);
+        }
+        sbuf = le2sbuf(le, lru_link);
+    } while (sbuf->jdirty);
+    if (sbuf->dirty && (ret = sfs_bcache_writeback_nolock(sfs, sbuf)) != 0) {
+        return ret;
+    }
+    list_del_init(&(sbuf->hash_link));
+    sbuf->readahead = 0;
+    if (load) {
+        struct iobuf __iob, *iob = iobuf_init(&__iob, sbuf->data, SFS_BLKSIZE, blkno * SFS_BLKSIZE);
+        if ((ret = dop_io(sfs->dev, iob, 0)) != 0) {
+            return ret;
+        }
+    }
+    sbuf->blkno = blkno;
+    list_add(bc->hash_list + sbuf_hashfn(blkno), &(sbuf->hash_link));
+    list_del(&(sbuf->lru_link));
+    list_add(&(bc->lru_list), &(sbuf->lru_link));
+    *sbuf_store = sbuf;
+    return 0;
+}
+
+/*
+ * sfs_bcache_get_nolock - get the buffer of block blkno, and make it the most recently used one.
+ * @sfs:        sfs_fs which will be process
+ * @blkno:      the NO. of disk block
+ * @load:       BOOL: read the block from disk if it isn't in cache. if false, the caller must
+ *              overwrite the whole block.
+ * @sbuf_store: store the buffer
+ */
+int
+sfs_bcache_get_nolock(struct sfs_fs *sfs, uint32_t blkno, bool load, struct sfs_buf **sbuf_store) {
+    struct sfs_bcache *bc = &(sfs->bcache);
+    struct sfs_buf *sbuf;
+    if ((sbuf = sfs_bcache_lookup_nolock(sfs, blkno)) == NULL) {
+        bc->misses ++;
+        return sfs_bcache_alloc_nolock(sfs, blkno, load, sbuf_store);
+    }
+    bc->hits ++;
+    list_del(&(sbuf->lru_link));
+    list_add(&(bc->lru_list), &(sbuf->lru_link));
+    *sbuf_store = sbuf;
+    return 0;
+}
+
+/*
+ * sfs_bcache_readahead_nolock - load blocks [blkno, blkno + nblks) into cache before they're read.
+ *                               blocks in cache already are skipped, each run of other blocks is
+ *                               read by ONE device request into ra_data, then copied to buffers.
+ *                               it isn't counted as a hit or miss.
+ */
+int
+sfs_bcache_readahead_nolock(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks) {
+    assert(nblks <= SFS_RA_MAX);
+    struct sfs_bcache *bc = &(sfs->bcache);
+    uint32_t i, j, start = 0;
+    int ret;
+    for (i = 0; i <= nblks; i ++) {
+        if (i < nblks && sfs_bcache_find_nolock(sfs, blkno + i) == NULL) {
+            continue;
+        }
+        // blocks [start, i) are not in cache
+        if (start < i) {
+            struct iobuf __iob, *iob = iobuf_init(&__iob, bc->ra_data,
+                    (i - start) * SFS_BLKSIZE, (blkno + start) * SFS_BLKSIZE);
+            if ((ret = dop_io(sfs->dev, iob, 0)) != 0) {
+                return ret;
+            }
+            for (j = start; j < i; j ++) {
+                struct sfs_buf *sbuf;
+                if ((ret = sfs_bcache_alloc_nolock(sfs, blkno + j, 0, &sbuf)) != 0) {
+                    return ret;
+                }
+                memcpy(sbuf->data, bc->ra_data + (j - start) * SFS_BLKSIZE, SFS_BLKSIZE);
+                sbuf->readahead = 1;
+                bc->ra_blocks ++;
+            }
+        }
+        start = i + 1;
+    }
+    return 0;
+}
+
+/*
+ * sfs_bcache_dirty_nolock - mark the buffer modified. a metadata block waits for journal
+ *                           (if there is one) before it's written in place.
+ * @meta:       BOOL: metadata is written, or file data
+ */
+void
+sfs_bcache_dirty_nolock(struct sfs_fs *sfs, struct sfs_buf *sbuf, bool meta) {
+    sbuf->dirty = 1;
+    sbuf->jdirty = (meta && sfs_journaled(sfs));
+}
+
+/*
+ * sfs_bcache_flush_nolock - write all dirty blocks into disk, except those waiting for journal.
+ */
+int
+sfs_bcache_flush_nolock(struct sfs_fs *sfs) {
+    list_entry_t *list = &(sfs->bcache.lru_list), *le = list;
+    while ((le = list_next(le)) != list) {
+        struct sfs_buf *sbuf = le2sbuf(le, lru_link);
+        int ret;
+        if (sbuf->dirty && !sbuf->jdirty && (ret = sfs_bcache_writeback_nolock(sfs, sbuf)) != 0) {
+            return ret;
+        }
+    }
+    return 0;
+}
+
+/*
+ * sfs_bcache_flush - write all dirty blocks into disk with lock protect.
+ */
+int
+sfs_bcache_flush(struct sfs_fs *sfs) {
+    int ret;
+    lock_sfs_io(sfs);
+    {
+        ret = sfs_bcache_flush_nolock(sfs);
+    }
+    unlock_sfs_io(sfs);
+    return ret;
+}
+
@@ -14,30 +14,63 @@
 #include <assert.h>
 
 /*
- * sfs_sync - sync sfs's superblock and freemap in memroy into disk
+ * sfs_sync - sync sfs's dirty inodes, superblock and dirty freemap blocks in memroy into block cache,
+ *            then write all dirty blocks in block cache into disk. with a journal, metadata is
+ *            committed first, and the journal is emptied after all blocks are written.
  */
 static int
 sfs_sync(struct fs *fs) {
     struct sfs_fs *sfs = fsop_info(fs, sfs);
     lock_sfs_fs(sfs);
     {
-        list_entry_t *list = &(sfs->inode_list), *le = list;
-        while ((le = list_next(le)) != list) {
-            struct sfs_inode *sin = le2sin(le, inode_link);
-            vop_fsync(info2node(sin, sfs_inode));
+        // take the dirty inodes off, an inode is taken off this list by sfs_sync_inode once it's written
+        list_entry_t list, *le;
+        list_init(&list);
+        while (!list_empty(&(sfs->dirty_list))) {
+            le = list_next(&(sfs->dirty_list));
+            list_del(le);
+            list_add_before(&list, le);
+        }
+        while (!list_empty(&list)) {
+            le = list_next(&list);
+            sfs_sync_inode(sfs, le2sin(le, dirty_link));
+            if (list_next(&list) == le) {
+                // failed, leave it dirty
+                list_del(le);
+                list_add_before(&(sfs->dirty_list), le);
+            }
         }
     }
     unlock_sfs_fs(sfs);
 
     int ret;
-    if (sfs->super_dirty) {
-        sfs->super_dirty = 0;
-        if ((ret = sfs_sync_super(sfs)) != 0) {
-            sfs->super_dirty = 1;
-            return ret;
+    lock_sfs_io(sfs);
+    {
+        if (!sfs_journaled(sfs)) {
+            if ((ret = sfs_sync_fsinfo_nolock(sfs)) == 0) {
+                ret = sfs_bcache_flush_nolock(sfs);
+            }
+        }
+        else if ((ret = sfs_journal_commit_nolock(sfs)) == 0) {
+            ret = sfs_journal_checkpoint_nolock(sfs);
         }
-        if ((ret = sfs_sync_freemap(sfs)) != 0) {
-            sfs->super_dirty = 1;
+    }
+    unlock_sfs_io(sfs);
+    return ret;
+}
+
+/*
+ * sfs_sync_clean - clear super.mounted once everything else is on disk, so unused_blocks
+ *                  is trusted at the next mount. called after sfs_sync.
+ */
+static int
+sfs_sync_clean(struct fs *fs) {
+    struct sfs_fs *sfs = fsop_info(fs, sfs);
+    int ret;
+    if (!sfs_journaled(sfs) && sfs->super.mounted) {
+        sfs->super.mounted = 0, sfs->super_dirty = 1;
+        if ((ret = sfs_sync(fs)) != 0) {
+            sfs->super.mounted = 1;
             return ret;
         }
     }
@@ -45,28 +78,47 @@ sfs_sync(struct fs *fs) {
 }
 
 /*
- * sfs_get_root - get the root directory inode  from disk (SFS_BLKN_ROOT,1)
+ * sfs_get_root - get the root directory inode  from disk (SFS_INO_ROOT,1)
  */
 static struct inode *
 sfs_get_root(struct fs *fs) {
     struct inode *node;
     int ret;
-    if ((ret = sfs_load_inode(fsop_info(fs, sfs), &node, SFS_BLKN_ROOT)) != 0) {
+    if ((ret = sfs_load_inode(fsop_info(fs, sfs), &node, SFS_INO_ROOT)) != 0) {
         panic("load sfs root failed: %e", ret);
     }
     return node;
 }
 
 /*
- * sfs_unmount - unmount sfs, and free the memorys contain sfs->freemap/sfs_buffer/hash_liskt and sfs itself.
+ * sfs_get_inode - get the inode numbered ino, from the inodes in memory or from disk
+ */
+static int
+sfs_get_inode(struct fs *fs, uint32_t ino, struct inode **node_store) {
+    return sfs_load_inode(fsop_info(fs, sfs), node_store, ino);
+}
+
+/*
+ * sfs_unmount - unmount sfs, and free the memorys contain sfs->freemap/sfs_buffer/hash_liskt/bcache and sfs itself.
  */
 static int
 sfs_unmount(struct fs *fs) {
     struct sfs_fs *sfs = fsop_info(fs, sfs);
+    sfs_icache_shrink(sfs);
     if (!list_empty(&(sfs->inode_list))) {
         return -E_BUSY;
     }
-    assert(!sfs->super_dirty);
+    int ret;
+    if ((ret = sfs_sync_clean(fs)) != 0) {
+        return ret;
+    }
+    assert(!sfs->super_dirty && list_empty(&(sfs->dirty_list)));
+    unregister_shrinker(&(sfs->icache_shrinker));
+    sfs_bcache_destroy(sfs);
+    if (sfs_journaled(sfs)) {
+        sfs_journal_destroy(sfs);
+    }
+    kfree(sfs->freemap_dirty);
     bitmap_destroy(sfs->freemap);
     kfree(sfs->sfs_buffer);
     kfree(sfs->hash_list);
@@ -85,15 +137,23 @@ sfs_cleanup(struct fs *fs) {
     uint32_t blocks = sfs->super.blocks, unused_blocks = sfs->super.unused_blocks;
     cprintf("sfs: cleanup: '%s' (%d/%d/%d)\n", sfs->super.info,
             blocks - unused_blocks, unused_blocks, blocks);
+    cprintf("sfs: block cache: %u hits, %u misses, %u writebacks\n",
+            sfs->bcache.hits, sfs->bcache.misses, sfs->bcache.writebacks);
+    cprintf("sfs: read-ahead: %u blocks, %u hits\n", sfs->bcache.ra_blocks, sfs->bcache.ra_hits);
+    if (sfs_journaled(sfs)) {
+        cprintf("sfs: journal: %u commits, %u blocks, %u checkpoints\n",
+                sfs->journal.commits, sfs->journal.blocks, sfs->journal.checkpoints);
+    }
     int i, ret;
     for (i = 0; i < 32; i ++) {
         if ((ret = fsop_sync(fs)) == 0) {
             break;
         }
     }
-    if (ret != 0) {
+    if (ret != 0 || (ret = sfs_sync_clean(fs)) != 0) {
         warn("sfs: sync error: '%s': %e.\n", sfs->super.info, ret);
     }
+    sfs_icache_shrink(sfs);
 }
 
 /*
@@ -112,6 +172,15 @@ sfs_init_read(struct device *dev, uint32_t blkno, void *blk_buffer) {
     return dop_io(dev, iob, 0);
 }
 
+/*
+ * sfs_init_write - used in sfs_do_mount to write disk block(blkno, 1) directly.
+ */
+static int
+sfs_init_write(struct device *dev, uint32_t blkno, void *blk_buffer) {
+    struct iobuf __iob, *iob = iobuf_init(&__iob, blk_buffer, SFS_BLKSIZE, blkno * SFS_BLKSIZE);
+    return dop_io(dev, iob, 1);
+}
+
 /*
  * sfs_init_freemap - used in sfs_do_mount to read freemap data info in disk block(blkno, nblks) directly.
  *
@@ -119,24 +188,17 @@ sfs_init_read(struct device *dev, uint32_t blkno, void *blk_buffer) {
  * @bitmap:     the bitmap in memroy
  * @blkno:      the NO. of disk block
  * @nblks:      Rd number of disk block
- * @blk_buffer: the buffer used for read
  *
  *      (1) get data addr in bitmap
- *      (2) read dev into iobuf
+ *      (2) read dev into it with one request, the device splits it as it needs
  */
 static int
-sfs_init_freemap(struct device *dev, struct bitmap *freemap, uint32_t blkno, uint32_t nblks, void *blk_buffer) {
+sfs_init_freemap(struct device *dev, struct bitmap *freemap, uint32_t blkno, uint32_t nblks) {
     size_t len;
     void *data = bitmap_getdata(freemap, &len);
     assert(data != NULL && len == nblks * SFS_BLKSIZE);
-    while (nblks != 0) {
-        int ret;
-        if ((ret = sfs_init_read(dev, blkno, data)) != 0) {
-            return ret;
-        }
-        blkno ++, nblks --, data += SFS_BLKSIZE;
-    }
-    return 0;
+    struct iobuf __iob, *iob = iobuf_init(&__iob, data, len, blkno * SFS_BLKSIZE);
+    return dop_io(dev, iob, 0);
 }
 
 /*
@@ -149,6 +211,7 @@ static int
 sfs_do_mount(struct device *dev, struct fs **fs_store) {
     static_assert(SFS_BLKSIZE >= sizeof(struct sfs_super));
     static_assert(SFS_BLKSIZE >= sizeof(struct sfs_disk_inode));
+    static_assert(SFS_BLKSIZE % sizeof(struct sfs_disk_inode) == 0);
     static_assert(SFS_BLKSIZE >= sizeof(struct sfs_disk_entry));
 
     if (dev->d_blocksize != SFS_BLKSIZE) {
@@ -188,9 +251,43 @@ sfs_do_mount(struct device *dev, struct fs **fs_store) {
                 super->blocks, dev->d_blocks);
         goto failed_cleanup_sfs_buffer;
     }
+    if (super->version > SFS_VERSION_JOURNAL) {
+        cprintf("sfs: unknown format version %u.\n", super->version);
+        goto failed_cleanup_sfs_buffer;
+    }
+    if (super->version >= SFS_VERSION_PACKED) {
+        uint32_t start = super->inode_start, nblks = super->inode_blocks;
+        if (start < SFS_BLKN_FREEMAP + sfs_freemap_blocks(super) || start + nblks > super->blocks
+                || super->ninodes <= SFS_INO_ROOT || super->ninodes > nblks * SFS_BLK_NINODE) {
+            cprintf("sfs: bad inode table (%u inodes, blocks %u+%u).\n",
+                    super->ninodes, start, nblks);
+            goto failed_cleanup_sfs_buffer;
+        }
+    }
+    if (super->version >= SFS_VERSION_JOURNAL) {
+        uint32_t start = super->journal_start, nblks = super->journal_blocks;
+        if (start < SFS_BLKN_FREEMAP + sfs_freemap_blocks(super) || start + nblks > super->blocks
+                || nblks < sfs_journal_maxtrans(super) + 3
+                || nblks > SFS_JOURNAL_NTAG - sfs_journal_maxtrans(super)) {
+            cprintf("sfs: bad journal (blocks %u+%u).\n", start, nblks);
+            goto failed_cleanup_sfs_buffer;
+        }
+    }
     super->info[SFS_MAX_INFO_LEN] = '\0';
     sfs->super = *super;
 
+    /* replay journal, which may write superblock too */
+    if (sfs_journaled(sfs)) {
+        if ((ret = sfs_journal_init(sfs)) != 0) {
+            goto failed_cleanup_sfs_buffer;
+        }
+        if ((ret = sfs_init_read(dev, SFS_BLKN_SUPER, sfs_buffer)) != 0) {
+            goto failed_cleanup_journal;
+        }
+        super->info[SFS_MAX_INFO_LEN] = '\0';
+        sfs->super = *super;
+    }
+
     ret = -E_NO_MEM;
 
     uint32_t i;
@@ -198,7 +295,7 @@ sfs_do_mount(struct device *dev, struct fs **fs_store) {
     /* alloc and initialize hash list */
     list_entry_t *hash_list;
     if ((sfs->hash_list = hash_list = kmalloc(sizeof(list_entry_t) * SFS_HLIST_SIZE)) == NULL) {
-        goto failed_cleanup_sfs_buffer;
+        goto failed_cleanup_journal;
     }
     for (i = 0; i < SFS_HLIST_SIZE; i ++) {
         list_init(hash_list + i);
@@ -211,24 +308,55 @@ sfs_do_mount(struct device *dev, struct fs **fs_store) {
         goto failed_cleanup_hash_list;
     }
     uint32_t freemap_size_nblks = sfs_freemap_blocks(super);
-    if ((ret = sfs_init_freemap(dev, freemap, SFS_BLKN_FREEMAP, freemap_size_nblks, sfs_buffer)) != 0) {
+    if (sfs_journaled(sfs)) {
+        /* read by sfs_journal_init after replay */
+        memcpy(bitmap_getdata(freemap, NULL), sfs->journal.fsinfo + SFS_BLKSIZE,
+                freemap_size_nblks * SFS_BLKSIZE);
+    }
+    else if ((ret = sfs_init_freemap(dev, freemap, SFS_BLKN_FREEMAP, freemap_size_nblks)) != 0) {
+        goto failed_cleanup_freemap;
+    }
+
+    /* the per-group free counters always come from the loaded freemap, but unused_blocks
+     * is kept with freemap by journal, or right if unmounted cleanly */
+    uint32_t blocks = sfs->super.blocks, unused_blocks = bitmap_recount(freemap);
+    if (!sfs_journaled(sfs) && sfs->super.mounted) {
+        if (unused_blocks != sfs->super.unused_blocks) {
+            cprintf("sfs: %u unused blocks, should be %u.\n", sfs->super.unused_blocks, unused_blocks);
+            sfs->super.unused_blocks = unused_blocks;
+        }
+    }
+
+    ret = -E_NO_MEM;
+    if ((sfs->freemap_dirty = kmalloc(sizeof(bool) * freemap_size_nblks)) == NULL) {
         goto failed_cleanup_freemap;
     }
+    memset(sfs->freemap_dirty, 0, sizeof(bool) * freemap_size_nblks);
 
-    uint32_t blocks = sfs->super.blocks, unused_blocks = 0;
-    for (i = 0; i < freemap_size_nbits; i ++) {
-        if (bitmap_test(freemap, i)) {
-            unused_blocks ++;
+    /* mark it mounted on disk before anything else is written */
+    if (!sfs_journaled(sfs)) {
+        sfs->super.mounted = 1;
+        memset(sfs_buffer, 0, SFS_BLKSIZE);
+        memcpy(sfs_buffer, &(sfs->super), sizeof(sfs->super));
+        if ((ret = sfs_init_write(dev, SFS_BLKN_SUPER, sfs_buffer)) != 0) {
+            goto failed_cleanup_freemap_dirty;
         }
     }
-    assert(unused_blocks == sfs->super.unused_blocks);
+
+    /* alloc block cache */
+    if ((ret = sfs_bcache_init(sfs)) != 0) {
+        goto failed_cleanup_freemap_dirty;
+    }
 
     /* and other fields */
     sfs->super_dirty = 0;
+    sfs->alloc_hint = 0;
     sem_init(&(sfs->fs_sem), 1);
     sem_init(&(sfs->io_sem), 1);
     sem_init(&(sfs->mutex_sem), 1);
     list_init(&(sfs->inode_list));
+    list_init(&(sfs->dirty_list));
+    sfs_icache_init(sfs);
     cprintf("sfs: mount: '%s' (%d/%d/%d)\n", sfs->super.info,
             blocks - unused_blocks, unused_blocks, blocks);
 
@@ -237,13 +365,20 @@ sfs_do_mount(struct device *dev, struct fs **fs_store) {
     fs->fs_get_root = sfs_get_root;
     fs->fs_unmount = sfs_unmount;
     fs->fs_cleanup = sfs_cleanup;
+    fs->fs_get_inode = sfs_get_inode;
     *fs_store = fs;
     return 0;
 
+failed_cleanup_freemap_dirty:
+    kfree(sfs->freemap_dirty);
 failed_cleanup_freemap:
     bitmap_destroy(freemap);
 failed_cleanup_hash_list:
     kfree(hash_list);
+failed_cleanup_journal:
+    if (sfs_journaled(sfs)) {
+        sfs_journal_destroy(sfs);
+    }
 failed_cleanup_sfs_buffer:
     kfree(sfs_buffer);
 failed_cleanup_fs:
@@ -16,6 +16,21 @@
 static const struct inode_ops sfs_node_dirops;  // dir operations
 static const struct inode_ops sfs_node_fileops; // file operations
 
+static kmem_cache_t *sfs_din_cachep;            // cache for on-disk inodes in memory
+static kmem_cache_t *sfs_entry_cachep;          // cache for temporary dir entries
+
+/*
+ * sfs_inode_cache_init - create the object caches for sfs_disk_inode and sfs_disk_entry
+ */
+void
+sfs_inode_cache_init(void) {
+    sfs_din_cachep = kmem_cache_create("sfs_disk_inode", sizeof(struct sfs_disk_inode), NULL);
+    sfs_entry_cachep = kmem_cache_create("sfs_disk_entry", sizeof(struct sfs_disk_entry), NULL);
+    if (sfs_din_cachep == NULL || sfs_entry_cachep == NULL) {
+        panic("cannot create sfs inode cache.\n");
+    }
+}
+
 /*
  * lock_sin - lock the process of inode Rd/Wr
  */
@@ -32,6 +47,18 @@ unlock_sin(struct sfs_inode *sin) {
     up(&(sin->sem));
 }
 
+/*
+ * sfs_dirty_inode - mark inode modified, and put it in dirty list of sfs if it isn't there,
+ *                   it's taken off by sfs_sync_inode once it's written.
+ */
+static void
+sfs_dirty_inode(struct sfs_fs *sfs, struct sfs_inode *sin) {
+    sin->dirty = 1;
+    if (list_empty(&(sin->dirty_link))) {
+        list_add_before(&(sfs->dirty_list), &(sin->dirty_link));
+    }
+}
+
 /*
  * sfs_get_ops - return function addr of fs_node_dirops/sfs_node_fileops
  */
@@ -84,28 +111,99 @@ sfs_block_inuse(struct sfs_fs *sfs, uint32_t ino) {
 }
 
 /*
- * sfs_block_alloc -  check and get a free disk block
+ * sfs_block_alloc -  check and get a free disk block, the first free one at or after goal,
+ *                    or after the last allocated block if goal is 0
  */
 static int
-sfs_block_alloc(struct sfs_fs *sfs, uint32_t *ino_store) {
+sfs_block_alloc(struct sfs_fs *sfs, uint32_t goal, uint32_t *ino_store) {
     int ret;
-    if ((ret = bitmap_alloc(sfs->freemap, ino_store)) != 0) {
+    if ((ret = bitmap_alloc(sfs->freemap, (goal != 0) ? goal : sfs->alloc_hint, ino_store)) != 0) {
         return ret;
     }
+    sfs->alloc_hint = *ino_store + 1;
     assert(sfs->super.unused_blocks > 0);
-    sfs->super.unused_blocks --, sfs->super_dirty = 1;
+    sfs->super.unused_blocks --;
+    sfs_dirty_freemap(sfs, *ino_store, 1);
     assert(sfs_block_inuse(sfs, *ino_store));
     return sfs_clear_block(sfs, *ino_store, 1);
 }
 
 /*
  * sfs_block_free - set related bits for ino block to 1(means free) in bitmap, add sfs->super.unused_blocks, set superblock dirty *
+ *                  with a journal, it's done when the transaction freeing the block is committed (see sfs_journal_free).
  */
 static void
 sfs_block_free(struct sfs_fs *sfs, uint32_t ino) {
     assert(sfs_block_inuse(sfs, ino));
+    if (sfs_journaled(sfs)) {
+        sfs_journal_free(sfs, ino, 1);
+        return;
+    }
     bitmap_free(sfs->freemap, ino);
-    sfs->super.unused_blocks ++, sfs->super_dirty = 1;
+    sfs->super.unused_blocks ++;
+    sfs_dirty_freemap(sfs, ino, 1);
+}
+
+/*
+ * sfs_block_alloc_range - get nblks contiguous free disk blocks by one search of bitmap, the first
+ *                         run at or after goal (see sfs_block_alloc), store the 1st one to ino_store
+ */
+static int
+sfs_block_alloc_range(struct sfs_fs *sfs, uint32_t goal, uint32_t nblks, uint32_t *ino_store) {
+    int ret;
+    uint32_t ino;
+    if (nblks > sfs->super.unused_blocks) {
+        return -E_NO_MEM;
+    }
+    if ((ret = bitmap_alloc_range(sfs->freemap, (goal != 0) ? goal : sfs->alloc_hint, nblks, &ino)) != 0) {
+        return ret;
+    }
+    sfs->alloc_hint = ino + nblks;
+    sfs->super.unused_blocks -= nblks;
+    sfs_dirty_freemap(sfs, ino, nblks);
+    assert(sfs_block_inuse(sfs, ino) && sfs_block_inuse(sfs, ino + nblks - 1));
+    if ((ret = sfs_clear_block(sfs, ino, nblks)) != 0) {
+        bitmap_free_range(sfs->freemap, ino, nblks);
+        sfs->super.unused_blocks += nblks;
+        return ret;
+    }
+    *ino_store = ino;
+    return 0;
+}
+
+/*
+ * sfs_block_free_range - free nblks contiguous disk blocks from ino, see sfs_block_free
+ */
+static void
+sfs_block_free_range(struct sfs_fs *sfs, uint32_t ino, uint32_t nblks) {
+    assert(sfs_block_inuse(sfs, ino) && sfs_block_inuse(sfs, ino + nblks - 1));
+    if (sfs_journaled(sfs)) {
+        sfs_journal_free(sfs, ino, nblks);
+        return;
+    }
+    bitmap_free_range(sfs->freemap, ino, nblks);
+    sfs->super.unused_blocks += nblks;
+    sfs_dirty_freemap(sfs, ino, nblks);
+}
+
+/*
+ * sfs_inode_locate - get the disk block and the offset in it where on-disk inode ino lives.
+ *                    old format keeps every inode in its own block (ino == blkno), the packed
+ *                    format keeps SFS_BLK_NINODE inodes per block in the inode table.
+ */
+static void
+sfs_inode_locate(struct sfs_fs *sfs, uint32_t ino, uint32_t *blkno_store, off_t *offset_store) {
+    if (sfs_inode_packed(sfs)) {
+        if (ino == 0 || ino >= sfs->super.ninodes) {
+            panic("sfs_inode_locate: called out of range (0, %u) %u.\n", sfs->super.ninodes, ino);
+        }
+        *blkno_store = sfs->super.inode_start + ino / SFS_BLK_NINODE;
+        *offset_store = (ino % SFS_BLK_NINODE) * sizeof(struct sfs_disk_inode);
+    }
+    else {
+        assert(sfs_block_inuse(sfs, ino));
+        *blkno_store = ino, *offset_store = 0;
+    }
 }
 
 /*
@@ -116,9 +214,14 @@ sfs_create_inode(struct sfs_fs *sfs, struct sfs_disk_inode *din, uint32_t ino, s
     struct inode *node;
     if ((node = alloc_inode(sfs_inode)) != NULL) {
         vop_init(node, sfs_get_ops(din->type), info2fs(sfs, sfs));
+        node->in_ino = ino;
         struct sfs_inode *sin = vop_info(node, sfs_inode);
         sin->din = din, sin->ino = ino, sin->dirty = 0, sin->reclaim_count = 1;
         sem_init(&(sin->sem), 1);
+        list_init(&(sin->lru_link));
+        list_init(&(sin->dirty_link));
+        sin->ra_next = sin->ra_end = sin->ra_size = 0;
+        sin->indirect_map = NULL;
         *node_store = node;
         return 0;
     }
@@ -140,6 +243,11 @@ lookup_sfs_nolock(struct sfs_fs *sfs, uint32_t ino) {
             node = info2node(sin, sfs_inode);
             if (vop_ref_inc(node) == 1) {
                 sin->reclaim_count ++;
+                // in use again, take it out of lru list
+                if (!list_empty(&(sin->lru_link))) {
+                    list_del_init(&(sin->lru_link));
+                    sfs->lru_count --;
+                }
             }
             return node;
         }
@@ -147,6 +255,72 @@ lookup_sfs_nolock(struct sfs_fs *sfs, uint32_t ino) {
     return NULL;
 }
 
+/*
+ * The unused inodes (no reference, nlinks != 0) are not freed by sfs_reclaim at once,
+ * they stay clean in hash list and lru list, so sfs_load_inode of a hot file finds it
+ * in memory. At most SFS_ICACHE_NR of them are kept, and all are freed by the shrinker
+ * when pages run out, or when sfs is cleaned up or unmounted.
+ */
+
+/*
+ * sfs_icache_shrink_nolock - free at most nr unused inodes from the tail of lru list
+ */
+static size_t
+sfs_icache_shrink_nolock(struct sfs_fs *sfs, size_t nr) {
+    size_t freed = 0;
+    while (freed < nr && !list_empty(&(sfs->lru_list))) {
+        struct sfs_inode *sin = le2sin(list_prev(&(sfs->lru_list)), lru_link);
+        struct inode *node = info2node(sin, sfs_inode);
+        assert(inode_ref_count(node) == 0 && !sin->dirty);
+        list_del_init(&(sin->lru_link));
+        sfs->lru_count --, freed ++;
+        sfs_remove_links(sin);
+        if (sin->indirect_map != NULL) {
+            kfree(sin->indirect_map);
+        }
+        kmem_cache_free(sfs_din_cachep, sin->din);
+        vop_kill(node);
+    }
+    return freed;
+}
+
+/*
+ * sfs_icache_shrink - free all unused inodes, called when sfs is cleaned up or unmounted
+ */
+size_t
+sfs_icache_shrink(struct sfs_fs *sfs) {
+    size_t freed;
+    lock_sfs_fs(sfs);
+    freed = sfs_icache_shrink_nolock(sfs, sfs->lru_count);
+    unlock_sfs_fs(sfs);
+    return freed;
+}
+
+/*
+ * sfs_icache_shrinker - the shrinker of sfs, frees all unused inodes unless fs is locked
+ */
+static size_t
+sfs_icache_shrinker(struct shrinker *s) {
+    struct sfs_fs *sfs = to_struct(s, struct sfs_fs, icache_shrinker);
+    size_t freed = 0;
+    if (try_lock_sfs_fs(sfs)) {
+        freed = sfs_icache_shrink_nolock(sfs, sfs->lru_count);
+        unlock_sfs_fs(sfs);
+    }
+    return freed;
+}
+
+/*
+ * sfs_icache_init - init lru list and register the shrinker, called by sfs_do_mount
+ */
+void
+sfs_icache_init(struct sfs_fs *sfs) {
+    list_init(&(sfs->lru_list));
+    sfs->lru_count = 0;
+    sfs->icache_shrinker.shrink = sfs_icache_shrinker;
+    register_shrinker(&(sfs->icache_shrinker));
+}
+
 /*
  * sfs_load_inode - If the inode isn't existed, load inode related ino disk block data into a new created inode.
  *                  If the inode is in memory alreadily, then do nothing
@@ -161,12 +335,14 @@ sfs_load_inode(struct sfs_fs *sfs, struct inode **node_store, uint32_t ino) {
 
     int ret = -E_NO_MEM;
     struct sfs_disk_inode *din;
-    if ((din = kmalloc(sizeof(struct sfs_disk_inode))) == NULL) {
+    if ((din = kmem_cache_alloc(sfs_din_cachep)) == NULL) {
         goto failed_unlock;
     }
 
-    assert(sfs_block_inuse(sfs, ino));
-    if ((ret = sfs_rbuf(sfs, din, sizeof(struct sfs_disk_inode), ino, 0)) != 0) {
+    uint32_t blkno;
+    off_t offset;
+    sfs_inode_locate(sfs, ino, &blkno, &offset);
+    if ((ret = sfs_rbuf(sfs, din, sizeof(struct sfs_disk_inode), blkno, offset)) != 0) {
         goto failed_cleanup_din;
     }
 
@@ -182,7 +358,7 @@ out_unlock:
     return 0;
 
 failed_cleanup_din:
-    kfree(din);
+    kmem_cache_free(sfs_din_cachep, din);
 failed_unlock:
     unlock_sfs_fs(sfs);
     return ret;
@@ -195,10 +371,11 @@ failed_unlock:
  * @entp:     the pointer of index of entry disk block
  * @index:    the index of block in indrect block
  * @create:   BOOL, if the block isn't allocated, if create = 1 the alloc a block,  otherwise just do nothing
+ * @goal:     where to look for free blocks to alloc, see sfs_block_alloc
  * @ino_store: 0 OR the index of already inused block or new allocated block.
  */
 static int
-sfs_bmap_get_sub_nolock(struct sfs_fs *sfs, uint32_t *entp, uint32_t index, bool create, uint32_t *ino_store) {
+sfs_bmap_get_sub_nolock(struct sfs_fs *sfs, uint32_t *entp, uint32_t index, bool create, uint32_t goal, uint32_t *ino_store) {
     assert(index < SFS_BLK_NENTRY);
     int ret;
     uint32_t ent, ino = 0;
@@ -217,12 +394,12 @@ sfs_bmap_get_sub_nolock(struct sfs_fs *sfs, uint32_t *entp, uint32_t index, bool
             goto out;
         }
 		//if entry block isn't existd, allocated a entry block (for indrect block)
-        if ((ret = sfs_block_alloc(sfs, &ent)) != 0) {
+        if ((ret = sfs_block_alloc(sfs, goal, &ent)) != 0) {
             return ret;
         }
     }
     
-    if ((ret = sfs_block_alloc(sfs, &ino)) != 0) {
+    if ((ret = sfs_block_alloc(sfs, goal, &ino)) != 0) {
         goto failed_cleanup;
     }
     if ((ret = sfs_wbuf(sfs, &ino, sizeof(uint32_t), ent, offset)) != 0) {
@@ -244,6 +421,368 @@ failed_cleanup:
     return ret;
 }
 
+/*
+ * Blocks of a SFS_VERSION_EXTENT inode are mapped by extents (see struct sfs_disk_inode),
+ * in order of lblk. A hole of the file is a range no extent covers, so the last extent ends
+ * at or before din->blocks. Blocks are mostly added after the last extent, which is cheap;
+ * a block for a hole is put in place by sfs_extent_insert_nolock.
+ */
+
+// sfs_extent_rw_nolock - Rd/Wr the index-th extent in leaf block
+static int
+sfs_extent_rw_nolock(struct sfs_fs *sfs, struct sfs_extent *ext, uint32_t leaf, uint32_t index, bool write) {
+    assert(index < SFS_BLK_NEXTENT);
+    off_t offset = index * sizeof(struct sfs_extent);
+    if (write) {
+        return sfs_wbuf(sfs, ext, sizeof(struct sfs_extent), leaf, offset);
+    }
+    return sfs_rbuf(sfs, ext, sizeof(struct sfs_extent), leaf, offset);
+}
+
+/*
+ * sfs_extent_find_nolock - find the disk block of logical block index, store 0 if it isn't mapped.
+ *                          the extents in a leaf are searched by bisection.
+ */
+static int
+sfs_extent_find_nolock(struct sfs_fs *sfs, struct sfs_disk_inode *din, uint32_t index, uint32_t *ino_store) {
+    int i = din->nextents - 1, ret;
+    while (i >= 0 && din->extents[i].lblk > index) {
+        i --;
+    }
+    *ino_store = 0;
+    if (i < 0) {
+        return 0;
+    }
+    struct sfs_extent ext = din->extents[i];
+    if (din->depth != 0) {
+        uint32_t leaf = ext.start, lo = 0, hi = ext.len;
+        while (hi - lo > 1) {
+            uint32_t mid = (lo + hi) / 2;
+            if ((ret = sfs_extent_rw_nolock(sfs, &ext, leaf, mid, 0)) != 0) {
+                return ret;
+            }
+            if (ext.lblk <= index) {
+                lo = mid;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        if ((ret = sfs_extent_rw_nolock(sfs, &ext, leaf, lo, 0)) != 0) {
+            return ret;
+        }
+    }
+    if (index - ext.lblk < ext.len) {
+        *ino_store = ext.start + (index - ext.lblk);
+    }
+    return 0;
+}
+
+// sfs_extent_last_nolock - get the last extent of inode, which must have one
+static int
+sfs_extent_last_nolock(struct sfs_fs *sfs, struct sfs_disk_inode *din, struct sfs_extent *ext) {
+    assert(din->nextents != 0);
+    struct sfs_extent *root = din->extents + din->nextents - 1;
+    if (din->depth == 0) {
+        *ext = *root;
+        return 0;
+    }
+    return sfs_extent_rw_nolock(sfs, ext, root->start, root->len - 1, 0);
+}
+
+/*
+ * sfs_extent_deepen_nolock - move the extents of inode into a new leaf block (depth 0 -> 1)
+ */
+static int
+sfs_extent_deepen_nolock(struct sfs_fs *sfs, struct sfs_inode *sin) {
+    struct sfs_disk_inode *din = sin->din;
+    struct sfs_extent *root = din->extents;
+    uint32_t n = din->nextents, leaf;
+    int ret;
+    assert(din->depth == 0);
+    if ((ret = sfs_block_alloc(sfs, 0, &leaf)) != 0) {
+        return ret;
+    }
+    if ((ret = sfs_wbuf(sfs, root, sizeof(struct sfs_extent) * n, leaf, 0)) != 0) {
+        sfs_block_free(sfs, leaf);
+        return ret;
+    }
+    memset(root, 0, sizeof(struct sfs_extent) * SFS_NEXTENT);
+    root[0].lblk = 0, root[0].start = leaf, root[0].len = n;
+    din->nextents = 1, din->depth = 1;
+    sfs_dirty_inode(sfs, sin);
+    return 0;
+}
+
+/*
+ * sfs_extent_insert_nolock - map disk blocks [start, start + nblks) to the hole at lblk, which is
+ *                            before the last extent. the extents of inode (or of the leaf which
+ *                            covers lblk) are read, the new one is merged into a neighbour it's
+ *                            contiguous with or put in place, and they are written back. a full
+ *                            inode is deepened, and a full leaf is split into two.
+ */
+static int
+sfs_extent_insert_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t lblk, uint32_t start, uint32_t nblks) {
+    struct sfs_disk_inode *din = sin->din;
+    struct sfs_extent *root = din->extents, *exts = root;
+    uint32_t n = din->nextents, cap = SFS_NEXTENT, i = 0, p, half, leaf;
+    int ret = 0;
+    if (din->depth != 0) {
+        if ((exts = kmalloc(SFS_BLKSIZE)) == NULL) {
+            return -E_NO_MEM;
+        }
+        for (i = din->nextents - 1; i > 0 && root[i].lblk > lblk; i --)
+            /* nothing */;
+        n = root[i].len, cap = SFS_BLK_NEXTENT;
+        if ((ret = sfs_rbuf(sfs, exts, sizeof(struct sfs_extent) * n, root[i].start, 0)) != 0) {
+            goto out;
+        }
+    }
+    for (p = 0; p < n && exts[p].lblk < lblk; p ++)
+        /* nothing */;
+
+    if (p != 0 && exts[p - 1].lblk + exts[p - 1].len == lblk && exts[p - 1].start + exts[p - 1].len == start) {
+        exts[p - 1].len += nblks;
+        // the hole is filled up, the extents on both sides become one
+        if (p < n && exts[p].lblk == lblk + nblks && exts[p].start == start + nblks) {
+            exts[p - 1].len += exts[p].len;
+            memmove(exts + p, exts + p + 1, sizeof(struct sfs_extent) * (n - p - 1));
+            memset(exts + (-- n), 0, sizeof(struct sfs_extent));
+        }
+    }
+    else if (p < n && exts[p].lblk == lblk + nblks && exts[p].start == start + nblks) {
+        exts[p].lblk = lblk, exts[p].start = start, exts[p].len += nblks;
+    }
+    else if (n < cap) {
+        memmove(exts + p + 1, exts + p, sizeof(struct sfs_extent) * (n - p));
+        exts[p].lblk = lblk, exts[p].start = start, exts[p].len = nblks;
+        n ++;
+    }
+    else {
+        // no room for one more extent, make room and try again
+        if (din->depth == 0) {
+            if ((ret = sfs_extent_deepen_nolock(sfs, sin)) == 0) {
+                ret = sfs_extent_insert_nolock(sfs, sin, lblk, start, nblks);
+            }
+            return ret;
+        }
+        if (din->nextents == SFS_NEXTENT) {
+            ret = -E_TOO_BIG;
+            goto out;
+        }
+        if ((ret = sfs_block_alloc(sfs, 0, &leaf)) != 0) {
+            goto out;
+        }
+        half = n / 2;
+        if ((ret = sfs_wbuf(sfs, exts + half, sizeof(struct sfs_extent) * (n - half), leaf, 0)) != 0) {
+            sfs_block_free(sfs, leaf);
+            goto out;
+        }
+        memmove(root + i + 2, root + i + 1, sizeof(struct sfs_extent) * (din->nextents - i - 1));
+        root[i + 1].lblk = exts[half].lblk, root[i + 1].start = leaf, root[i + 1].len = n - half;
+        root[i].len = half;
+        din->nextents ++;
+        sfs_dirty_inode(sfs, sin);
+        kfree(exts);
+        return sfs_extent_insert_nolock(sfs, sin, lblk, start, nblks);
+    }
+
+    if (din->depth == 0) {
+        din->nextents = n;
+    }
+    else {
+        if ((ret = sfs_wbuf(sfs, exts, sizeof(struct sfs_extent) * n, root[i].start, 0)) != 0) {
+            goto out;
+        }
+        root[i].len = n;
+        if (root[i].lblk > exts[0].lblk) {
+            root[i].lblk = exts[0].lblk;
+        }
+    }
+    sfs_dirty_inode(sfs, sin);
+
+out:
+    if (exts != root) {
+        kfree(exts);
+    }
+    return ret;
+}
+
+/*
+ * sfs_extent_map_nolock - map disk blocks [start, start + nblks) to the unmapped logical blocks from
+ *                         lblk. past the last extent, the last extent grows if the blocks follow
+ *                         it on disk, or a new extent is added: when the inode is full, it's
+ *                         deepened, and a new leaf is added after a full one. a hole before the
+ *                         last extent goes to sfs_extent_insert_nolock.
+ *                         din->blocks is left to the caller.
+ */
+static int
+sfs_extent_map_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t lblk, uint32_t start, uint32_t nblks) {
+    struct sfs_disk_inode *din = sin->din;
+    struct sfs_extent last, ext, *root = din->extents;
+    uint32_t n = din->nextents, leaf;
+    int ret;
+    if (n != 0) {
+        if ((ret = sfs_extent_last_nolock(sfs, din, &last)) != 0) {
+            return ret;
+        }
+        if (lblk < last.lblk + last.len) {
+            assert(lblk + nblks <= last.lblk);
+            return sfs_extent_insert_nolock(sfs, sin, lblk, start, nblks);
+        }
+        if (last.lblk + last.len == lblk && last.start + last.len == start) {
+            last.len += nblks;
+            if (din->depth == 0) {
+                root[n - 1] = last;
+            }
+            else if ((ret = sfs_extent_rw_nolock(sfs, &last, root[n - 1].start, root[n - 1].len - 1, 1)) != 0) {
+                return ret;
+            }
+            goto out;
+        }
+    }
+
+    ext.lblk = lblk, ext.start = start, ext.len = nblks;
+    if (din->depth == 0 && n < SFS_NEXTENT) {
+        root[din->nextents ++] = ext;
+        goto out;
+    }
+    if (din->depth == 0) {
+        if ((ret = sfs_extent_deepen_nolock(sfs, sin)) != 0) {
+            return ret;
+        }
+        n = 1;
+    }
+    if (root[n - 1].len < SFS_BLK_NEXTENT) {
+        if ((ret = sfs_extent_rw_nolock(sfs, &ext, root[n - 1].start, root[n - 1].len, 1)) != 0) {
+            return ret;
+        }
+        root[n - 1].len ++;
+        goto out;
+    }
+    if (n == SFS_NEXTENT) {
+        return -E_TOO_BIG;
+    }
+    if ((ret = sfs_block_alloc(sfs, 0, &leaf)) != 0) {
+        return ret;
+    }
+    if ((ret = sfs_extent_rw_nolock(sfs, &ext, leaf, 0, 1)) != 0) {
+        sfs_block_free(sfs, leaf);
+        return ret;
+    }
+    root[n].lblk = ext.lblk, root[n].start = leaf, root[n].len = 1;
+    din->nextents ++;
+
+out:
+    sfs_dirty_inode(sfs, sin);
+    return 0;
+}
+
+/*
+ * sfs_extent_end_nolock - get the logical block after the last extent of inode, and the disk block
+ *                         after it (0 if inode has no extent)
+ */
+static int
+sfs_extent_end_nolock(struct sfs_fs *sfs, struct sfs_disk_inode *din, uint32_t *end_store, uint32_t *goal_store) {
+    struct sfs_extent last;
+    int ret;
+    *end_store = *goal_store = 0;
+    if (din->nextents != 0) {
+        if ((ret = sfs_extent_last_nolock(sfs, din, &last)) != 0) {
+            return ret;
+        }
+        *end_store = last.lblk + last.len, *goal_store = last.start + last.len;
+    }
+    return 0;
+}
+
+/*
+ * sfs_extent_alloc_nolock - alloc a disk block for the unmapped logical block index, near goal, or
+ *                           right after the last extent if goal is 0, and map it.
+ */
+static int
+sfs_extent_alloc_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index, uint32_t goal, uint32_t *ino_store) {
+    uint32_t ino, end;
+    int ret;
+    if (goal == 0 && (ret = sfs_extent_end_nolock(sfs, sin->din, &end, &goal)) != 0) {
+        return ret;
+    }
+    if ((ret = sfs_block_alloc(sfs, goal, &ino)) != 0) {
+        return ret;
+    }
+    if ((ret = sfs_extent_map_nolock(sfs, sin, index, ino, 1)) != 0) {
+        sfs_block_free(sfs, ino);
+        return ret;
+    }
+    *ino_store = ino;
+    return 0;
+}
+
+/*
+ * sfs_extent_truncate_nolock - free the blocks of inode from tblks to the end, a whole run of an
+ *                              extent at a time. the extent (and the leaf) which becomes empty is
+ *                              removed. din->blocks is left to the caller.
+ */
+static int
+sfs_extent_truncate_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t tblks) {
+    struct sfs_disk_inode *din = sin->din;
+    struct sfs_extent last, *root;
+    uint32_t cut;
+    int ret;
+    while (din->nextents != 0) {
+        root = din->extents + din->nextents - 1;
+        if ((ret = sfs_extent_last_nolock(sfs, din, &last)) != 0) {
+            return ret;
+        }
+        assert(last.len != 0 && last.lblk + last.len <= din->blocks);
+        if (last.lblk + last.len <= tblks) {
+            break;
+        }
+        cut = (last.lblk >= tblks) ? last.len : last.lblk + last.len - tblks;
+        // dirty before the blocks are freed, a commit in sfs_block_free writes the inode
+        sfs_dirty_inode(sfs, sin);
+        if ((last.len -= cut) != 0) {
+            if (din->depth == 0) {
+                *root = last;
+            }
+            else if ((ret = sfs_extent_rw_nolock(sfs, &last, root->start, root->len - 1, 1)) != 0) {
+                return ret;
+            }
+        }
+        else if (din->depth == 0 || -- root->len == 0) {
+            if (din->depth != 0) {
+                sfs_block_free(sfs, root->start);
+            }
+            memset(root, 0, sizeof(struct sfs_extent));
+            if (-- din->nextents == 0) {
+                din->depth = 0;
+            }
+        }
+        sfs_block_free_range(sfs, last.start + last.len, cut);
+    }
+    return 0;
+}
+
+/*
+ * sfs_bmap_cache_nolock - load the indirect block of inode into sin->indirect_map, so the blocks it
+ *                         maps are found without reading it again. the map is updated whenever an
+ *                         entry is set or cleared, and freed with the inode. if there is no memory
+ *                         for it, it's left NULL, and the indirect block is read every time.
+ */
+static int
+sfs_bmap_cache_nolock(struct sfs_fs *sfs, struct sfs_inode *sin) {
+    uint32_t ent = sin->din->indirect, *map;
+    if (sin->indirect_map == NULL && ent != 0 && (map = kmalloc(SFS_BLKSIZE)) != NULL) {
+        int ret;
+        if ((ret = sfs_rblock(sfs, map, ent, 1)) != 0) {
+            kfree(map);
+            return ret;
+        }
+        sin->indirect_map = map;
+    }
+    return 0;
+}
+
 /*
  * sfs_bmap_get_nolock - according sfs_inode and index of block, find the NO. of disk block
  *                       no lock protect
@@ -251,35 +790,56 @@ failed_cleanup:
  * @sin:      sfs inode in memory
  * @index:    the index of block in inode
  * @create:   BOOL, if the block isn't allocated, if create = 1 the alloc a block,  otherwise just do nothing
+ * @goal:     where to look for free blocks to alloc, see sfs_block_alloc
  * @ino_store: 0 OR the index of already inused block or new allocated block.
  */
 static int
-sfs_bmap_get_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index, bool create, uint32_t *ino_store) {
+sfs_bmap_get_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index, bool create, uint32_t goal, uint32_t *ino_store) {
     struct sfs_disk_inode *din = sin->din;
     int ret;
     uint32_t ent, ino;
+    if (sfs_inode_extent(sfs)) {
+        if ((ret = sfs_extent_find_nolock(sfs, din, index, &ino)) != 0) {
+            return ret;
+        }
+        if (ino == 0 && create) {
+            if ((ret = sfs_extent_alloc_nolock(sfs, sin, index, goal, &ino)) != 0) {
+                return ret;
+            }
+        }
+        goto out;
+    }
 	// the index of disk block is in the fist SFS_NDIRECT  direct blocks
     if (index < SFS_NDIRECT) {
         if ((ino = din->direct[index]) == 0 && create) {
-            if ((ret = sfs_block_alloc(sfs, &ino)) != 0) {
+            if ((ret = sfs_block_alloc(sfs, goal, &ino)) != 0) {
                 return ret;
             }
             din->direct[index] = ino;
-            sin->dirty = 1;
+            sfs_dirty_inode(sfs, sin);
         }
         goto out;
     }
     // the index of disk block is in the indirect blocks.
     index -= SFS_NDIRECT;
     if (index < SFS_BLK_NENTRY) {
+        if ((ret = sfs_bmap_cache_nolock(sfs, sin)) != 0) {
+            return ret;
+        }
+        if (sin->indirect_map != NULL && ((ino = sin->indirect_map[index]) != 0 || !create)) {
+            goto out;
+        }
         ent = din->indirect;
-        if ((ret = sfs_bmap_get_sub_nolock(sfs, &ent, index, create, &ino)) != 0) {
+        if ((ret = sfs_bmap_get_sub_nolock(sfs, &ent, index, create, goal, &ino)) != 0) {
             return ret;
         }
         if (ent != din->indirect) {
             assert(din->indirect == 0);
             din->indirect = ent;
-            sin->dirty = 1;
+            sfs_dirty_inode(sfs, sin);
+        }
+        if (sin->indirect_map != NULL) {
+            sin->indirect_map[index] = ino;
         }
         goto out;
     } else {
@@ -325,7 +885,7 @@ sfs_bmap_free_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index)
 			// free the block
             sfs_block_free(sfs, ino);
             din->direct[index] = 0;
-            sin->dirty = 1;
+            sfs_dirty_inode(sfs, sin);
         }
         return 0;
     }
@@ -337,52 +897,228 @@ sfs_bmap_free_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index)
             if ((ret = sfs_bmap_free_sub_nolock(sfs, ent, index)) != 0) {
                 return ret;
             }
+            if (sin->indirect_map != NULL) {
+                sin->indirect_map[index] = 0;
+            }
+        }
+        return 0;
+    }
+    return 0;
+}
+
+/*
+ * sfs_bmap_load_nolock - according to the DIR's inode and the logical index of block in inode, find the NO. of disk block.
+ *                        a hole (or a block past the end) is allocated, next to the block before it if possible,
+ *                        and the file grows to include index.
+ * @sfs:      sfs file system
+ * @sin:      sfs inode in memory
+ * @index:    the logical index of disk block in inode
+ * @ino_store:the NO. of disk block
+ */
+static int
+sfs_bmap_load_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index, uint32_t *ino_store) {
+    struct sfs_disk_inode *din = sin->din;
+    int ret;
+    uint32_t ino, goal = 0;
+    if ((ret = sfs_bmap_get_nolock(sfs, sin, index, 0, 0, &ino)) != 0) {
+        return ret;
+    }
+    if (ino == 0) {
+        // a new block goes right after the one before it, so the file stays contiguous on disk
+        if (index != 0 && index <= din->blocks) {
+            if ((ret = sfs_bmap_get_nolock(sfs, sin, index - 1, 0, 0, &goal)) != 0) {
+                return ret;
+            }
+            if (goal != 0) {
+                goal ++;
+            }
+        }
+        if ((ret = sfs_bmap_get_nolock(sfs, sin, index, 1, goal, &ino)) != 0) {
+            return ret;
+        }
+    }
+    assert(sfs_block_inuse(sfs, ino));
+    if (index >= din->blocks) {
+        din->blocks = index + 1;
+        sfs_dirty_inode(sfs, sin);
+    }
+    if (ino_store != NULL) {
+        *ino_store = ino;
+    }
+    return 0;
+}
+
+/*
+ * sfs_bmap_alloc_nolock - alloc disk blocks for the holes in logical blocks [from, to) of file, and
+ *                         grow the file to to blocks if it's shorter. if all of them are after the
+ *                         last extent of an extent inode, they are got as ONE contiguous run by one
+ *                         search of bitmap if there is such a run, otherwise one by one.
+ */
+static int
+sfs_bmap_alloc_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t from, uint32_t to) {
+    struct sfs_disk_inode *din = sin->din;
+    uint32_t end, goal, ino;
+    int ret;
+    assert(from < to);
+    if (to - from > 1 && sfs_inode_extent(sfs)) {
+        if ((ret = sfs_extent_end_nolock(sfs, din, &end, &goal)) != 0) {
+            return ret;
+        }
+        if (end <= from && sfs_block_alloc_range(sfs, goal, to - from, &ino) == 0) {
+            if ((ret = sfs_extent_map_nolock(sfs, sin, from, ino, to - from)) != 0) {
+                sfs_block_free_range(sfs, ino, to - from);
+                return ret;
+            }
+            if (din->blocks < to) {
+                din->blocks = to;
+            }
+            return 0;
+        }
+    }
+    for (; from < to; from ++) {
+        if ((ret = sfs_bmap_load_nolock(sfs, sin, from, NULL)) != 0) {
+            return ret;
+        }
+    }
+    return 0;
+}
+
+/*
+ * sfs_bmap_truncate_nolock - free the disk blocks of file from tblks to the end. runs of blocks
+ *                            contiguous on disk are freed at once: an extent at a time, or by
+ *                            looking through the cached indirect block.
+ */
+static int
+sfs_bmap_truncate_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t tblks) {
+    struct sfs_disk_inode *din = sin->din;
+    assert(tblks <= din->blocks);
+    int ret;
+    if (sfs_inode_extent(sfs)) {
+        if ((ret = sfs_extent_truncate_nolock(sfs, sin, tblks)) != 0) {
+            return ret;
+        }
+        din->blocks = tblks;
+        sfs_dirty_inode(sfs, sin);
+        return 0;
+    }
+    if (din->blocks > SFS_NDIRECT) {
+        uint32_t lo = (tblks > SFS_NDIRECT) ? tblks - SFS_NDIRECT : 0, hi = din->blocks - SFS_NDIRECT;
+        uint32_t *map, i, start = 0, len = 0;
+        if ((ret = sfs_bmap_cache_nolock(sfs, sin)) != 0) {
+            return ret;
+        }
+        if ((map = sin->indirect_map) == NULL) {
+            while (din->blocks > tblks && din->blocks > SFS_NDIRECT) {
+                if ((ret = sfs_bmap_free_nolock(sfs, sin, din->blocks - 1)) != 0) {
+                    return ret;
+                }
+                din->blocks --;
+                sfs_dirty_inode(sfs, sin);
+            }
+        }
+        else {
+            // clear the entries on disk first, so no freed block is left mapped
+            if ((ret = sfs_zbuf(sfs, (hi - lo) * sizeof(uint32_t), din->indirect, lo * sizeof(uint32_t))) != 0) {
+                return ret;
+            }
+            for (i = lo; i < hi; i ++) {
+                if (map[i] != 0 && map[i] == start + len) {
+                    len ++;
+                }
+                else {
+                    if (len != 0) {
+                        sfs_block_free_range(sfs, start, len);
+                    }
+                    start = map[i], len = (start != 0);
+                }
+                map[i] = 0;
+            }
+            if (len != 0) {
+                sfs_block_free_range(sfs, start, len);
+            }
+            din->blocks = lo + SFS_NDIRECT;
+            sfs_dirty_inode(sfs, sin);
         }
-        return 0;
+    }
+    while (din->blocks > tblks) {
+        if ((ret = sfs_bmap_free_nolock(sfs, sin, din->blocks - 1)) != 0) {
+            return ret;
+        }
+        din->blocks --;
+        sfs_dirty_inode(sfs, sin);
     }
     return 0;
 }
 
 /*
- * sfs_bmap_load_nolock - according to the DIR's inode and the logical index of block in inode, find the NO. of disk block.
- * @sfs:      sfs file system
- * @sin:      sfs inode in memory
- * @index:    the logical index of disk block in inode
- * @ino_store:the NO. of disk block
+ * Entries of a DIR are addressed by slot. In the old format every entry takes a
+ * whole block and slot is the index of the block; in SFS_VERSION_DIRPACK entries
+ * are variable-length records (struct sfs_disk_dirent), and slot is the byte
+ * offset of the record in DIR. sfs_dirent_nslots is the end of the slots.
+ */
+#define sfs_dirent_nslots(sfs, din)                 \
+    (sfs_dirent_packed(sfs) ? (din)->blocks * SFS_BLKSIZE : (din)->blocks)
+
+/*
+ * sfs_dirent_load_rec_nolock - read and check the header of a packed file entry record
+ * @sfs:         sfs file system
+ * @sin:         sfs inode in memory
+ * @slot:        the offset of the record in DIR
+ * @rec:         the record header
+ * @blkno_store: the disk block which contains this record
  */
 static int
-sfs_bmap_load_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index, uint32_t *ino_store) {
-    struct sfs_disk_inode *din = sin->din;
-    assert(index <= din->blocks);
+sfs_dirent_load_rec_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, int slot, struct sfs_disk_dirent *rec, uint32_t *blkno_store) {
     int ret;
-    uint32_t ino;
-    bool create = (index == din->blocks);
-    if ((ret = sfs_bmap_get_nolock(sfs, sin, index, create, &ino)) != 0) {
+    uint32_t ino, blkoff = slot % SFS_BLKSIZE;
+    if ((ret = sfs_bmap_load_nolock(sfs, sin, slot / SFS_BLKSIZE, &ino)) != 0) {
         return ret;
     }
     assert(sfs_block_inuse(sfs, ino));
-    if (create) {
-        din->blocks ++;
+    if ((ret = sfs_rbuf(sfs, rec, sizeof(struct sfs_disk_dirent), ino, blkoff)) != 0) {
+        return ret;
     }
-    if (ino_store != NULL) {
-        *ino_store = ino;
+    if (rec->rec_len < sizeof(struct sfs_disk_dirent) || rec->rec_len % sizeof(uint32_t) != 0
+            || blkoff + rec->rec_len > SFS_BLKSIZE || rec->name_len > SFS_MAX_FNAME_LEN
+            || sizeof(struct sfs_disk_dirent) + rec->name_len > rec->rec_len) {
+        warn("sfs: bad dir entry (inode %u, offset %d).\n", sin->ino, slot);
+        return -E_INVAL;
     }
+    *blkno_store = ino;
     return 0;
 }
 
 /*
- * sfs_bmap_truncate_nolock - free the disk block at the end of file
+ * sfs_dirent_next_nolock - get the ino (and the length of name if known) of the file entry at slot,
+ *                          and the slot of the next entry, without reading the name
+ * @sfs:       sfs file system
+ * @sin:       sfs inode in memory
+ * @slot:      the slot of file entry
+ * @next:      the slot of the next file entry
+ * @ino_store: the ino of file entry, 0 if the entry is free
+ * @name_len:  length of name, -1 if it's unknown before the name is read (the old format)
  */
 static int
-sfs_bmap_truncate_nolock(struct sfs_fs *sfs, struct sfs_inode *sin) {
-    struct sfs_disk_inode *din = sin->din;
-    assert(din->blocks != 0);
+sfs_dirent_next_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, int slot, int *next, uint32_t *ino_store, int *name_len) {
+    assert(sin->din->type == SFS_TYPE_DIR && (slot >= 0 && slot < sfs_dirent_nslots(sfs, sin->din)));
     int ret;
-    if ((ret = sfs_bmap_free_nolock(sfs, sin, din->blocks - 1)) != 0) {
+    uint32_t ino;
+    if (sfs_dirent_packed(sfs)) {
+        struct sfs_disk_dirent rec;
+        if ((ret = sfs_dirent_load_rec_nolock(sfs, sin, slot, &rec, &ino)) != 0) {
+            return ret;
+        }
+        *next = slot + rec.rec_len, *ino_store = rec.ino, *name_len = rec.name_len;
+        return 0;
+    }
+    if ((ret = sfs_bmap_load_nolock(sfs, sin, slot, &ino)) != 0) {
         return ret;
     }
-    din->blocks --;
-    sin->dirty = 1;
+    assert(sfs_block_inuse(sfs, ino));
+    if ((ret = sfs_rbuf(sfs, ino_store, sizeof(uint32_t), ino, 0)) != 0) {
+        return ret;
+    }
+    *next = slot + 1, *name_len = -1;
     return 0;
 }
 
@@ -390,14 +1126,28 @@ sfs_bmap_truncate_nolock(struct sfs_fs *sfs, struct sfs_inode *sin) {
  * sfs_dirent_read_nolock - read the file entry from disk block which contains this entry
  * @sfs:      sfs file system
  * @sin:      sfs inode in memory
- * @slot:     the index of file entry
+ * @slot:     the slot of file entry
  * @entry:    file entry
  */
 static int
 sfs_dirent_read_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, int slot, struct sfs_disk_entry *entry) {
-    assert(sin->din->type == SFS_TYPE_DIR && (slot >= 0 && slot < sin->din->blocks));
+    assert(sin->din->type == SFS_TYPE_DIR && (slot >= 0 && slot < sfs_dirent_nslots(sfs, sin->din)));
     int ret;
     uint32_t ino;
+    if (sfs_dirent_packed(sfs)) {
+        struct sfs_disk_dirent rec;
+        if ((ret = sfs_dirent_load_rec_nolock(sfs, sin, slot, &rec, &ino)) != 0) {
+            return ret;
+        }
+        off_t offset = slot % SFS_BLKSIZE + sizeof(struct sfs_disk_dirent);
+        if ((ret = sfs_rbuf(sfs, entry->name, rec.name_len, ino, offset)) != 0) {
+            return ret;
+        }
+        // the whole name buffer is copied out by getdirentry
+        memset(entry->name + rec.name_len, 0, sizeof(entry->name) - rec.name_len);
+        entry->ino = rec.ino;
+        return 0;
+    }
 	// according to the DIR's inode and the slot of file entry, find the index of disk block which contains this file entry
     if ((ret = sfs_bmap_load_nolock(sfs, sin, slot, &ino)) != 0) {
         return ret;
@@ -411,6 +1161,93 @@ sfs_dirent_read_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, int slot, stru
     return 0;
 }
 
+/*
+ * sfs_dx_hash - hash of file name used by the dir index (32-bit FNV-1a)
+ */
+static uint32_t
+sfs_dx_hash(const char *name, int len) {
+    uint32_t hash = 2166136261U;
+    while (len -- > 0) {
+        hash ^= (uint8_t)(*name ++);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+/*
+ * sfs_dx_lookup_nolock - find the dir block which may contain name by the hashed index of DIR
+ *                        (see struct sfs_dx_root)
+ * @sfs:        sfs file system
+ * @sin:        DIR sfs inode in memory
+ * @name:       the file name, len is its length
+ * @leaf_store: the logical index of the dir block, -1 if DIR has no index or name is "."/".."
+ */
+static int
+sfs_dx_lookup_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, const char *name, int len, int *leaf_store) {
+    *leaf_store = -1;
+    if (!sfs_dirent_packed(sfs) || sin->din->blocks < 2
+            || (name[0] == '.' && (len == 1 || (len == 2 && name[1] == '.')))) {
+        return 0;
+    }
+
+    int ret, dotdot, name_len;
+    uint32_t ino, blkno;
+    struct sfs_disk_dirent rec;
+    if ((ret = sfs_dirent_next_nolock(sfs, sin, 0, &dotdot, &ino, &name_len)) != 0) {
+        return ret;
+    }
+    if (name_len != 1 || dotdot >= SFS_BLKSIZE) {
+        return 0;
+    }
+    if ((ret = sfs_dirent_load_rec_nolock(sfs, sin, dotdot, &rec, &blkno)) != 0) {
+        return ret;
+    }
+
+    struct sfs_dx_root root;
+    off_t offset = dotdot + sfs_dirent_reclen(rec.name_len), end = dotdot + rec.rec_len;
+    if (rec.name_len != 2 || offset + sizeof(struct sfs_dx_root) > end) {
+        return 0;
+    }
+    if ((ret = sfs_rbuf(sfs, &root, sizeof(struct sfs_dx_root), blkno, offset)) != 0) {
+        return ret;
+    }
+    if (root.magic != SFS_DX_MAGIC) {
+        return 0;
+    }
+    offset += sizeof(struct sfs_dx_root);
+    if (root.nleaves == 0 || root.nleaves > (end - offset) / sizeof(struct sfs_dx_entry)) {
+        goto bad_index;
+    }
+
+    // binary search the last entry with entry.hash <= hash
+    struct sfs_dx_entry entry;
+    uint32_t hash = sfs_dx_hash(name, len), lo = 0, hi = root.nleaves;
+    while (hi - lo > 1) {
+        uint32_t mid = (lo + hi) / 2;
+        if ((ret = sfs_rbuf(sfs, &entry, sizeof(entry), blkno, offset + mid * sizeof(entry))) != 0) {
+            return ret;
+        }
+        if (entry.hash <= hash) {
+            lo = mid;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    if ((ret = sfs_rbuf(sfs, &entry, sizeof(entry), blkno, offset + lo * sizeof(entry))) != 0) {
+        return ret;
+    }
+    if (entry.block >= sin->din->blocks) {
+        goto bad_index;
+    }
+    *leaf_store = entry.block;
+    return 0;
+
+bad_index:
+    warn("sfs: bad dir index (inode %u).\n", sin->ino);
+    return -E_INVAL;
+}
+
 #define sfs_dirent_link_nolock_check(sfs, sin, slot, lnksin, name)                  \
     do {                                                                            \
         int err;                                                                    \
@@ -429,33 +1266,49 @@ sfs_dirent_read_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, int slot, stru
 
 /*
  * sfs_dirent_search_nolock - read every file entry in the DIR, compare file name with each entry->name
- *                            If equal, then return slot and NO. of disk of this file's inode
+ *                            If equal, then return slot and NO. of disk of this file's inode.
+ *                            If DIR has a hashed index, only the dir block given by it is read.
  * @sfs:        sfs file system
  * @sin:        sfs inode in memory
  * @name:       the filename
  * @ino_store:  NO. of disk of this file (with the filename)'s inode
- * @slot:       logical index of file entry (NOTICE: each file entry ocupied one  disk block)
- * @empty_slot: the empty logical index of file entry.
+ * @slot:       slot of file entry (see sfs_dirent_nslots)
+ * @empty_slot: the slot of a free file entry.
  */
 static int
 sfs_dirent_search_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, const char *name, uint32_t *ino_store, int *slot, int *empty_slot) {
     assert(strlen(name) <= SFS_MAX_FNAME_LEN);
     struct sfs_disk_entry *entry;
-    if ((entry = kmalloc(sizeof(struct sfs_disk_entry))) == NULL) {
+    if ((entry = kmem_cache_alloc(sfs_entry_cachep)) == NULL) {
         return -E_NO_MEM;
     }
 
 #define set_pvalue(x, v)            do { if ((x) != NULL) { *(x) = (v); } } while (0)
-    int ret, i, nslots = sin->din->blocks;
+    int ret, i, next, name_len, leaf, len = strlen(name), nslots = sfs_dirent_nslots(sfs, sin->din);
+    uint32_t ino;
     set_pvalue(empty_slot, nslots);
-    for (i = 0; i < nslots; i ++) {
-        if ((ret = sfs_dirent_read_nolock(sfs, sin, i, entry)) != 0) {
+    if ((ret = sfs_dx_lookup_nolock(sfs, sin, name, len, &leaf)) != 0) {
+        goto out;
+    }
+    i = 0;
+    if (leaf != -1) {
+        i = leaf * SFS_BLKSIZE, nslots = i + SFS_BLKSIZE;
+    }
+    for (; i < nslots; i = next) {
+        if ((ret = sfs_dirent_next_nolock(sfs, sin, i, &next, &ino, &name_len)) != 0) {
             goto out;
         }
-        if (entry->ino == 0) {
+        if (ino == 0) {
             set_pvalue(empty_slot, i);
             continue ;
         }
+        // only read the names which may match
+        if (name_len != -1 && name_len != len) {
+            continue ;
+        }
+        if ((ret = sfs_dirent_read_nolock(sfs, sin, i, entry)) != 0) {
+            goto out;
+        }
         if (strcmp(name, entry->name) == 0) {
             set_pvalue(slot, i);
             set_pvalue(ino_store, entry->ino);
@@ -465,7 +1318,7 @@ sfs_dirent_search_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, const char *
 #undef set_pvalue
     ret = -E_NOENT;
 out:
-    kfree(entry);
+    kmem_cache_free(sfs_entry_cachep, entry);
     return ret;
 }
 
@@ -475,13 +1328,14 @@ out:
 
 static int
 sfs_dirent_findino_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t ino, struct sfs_disk_entry *entry) {
-    int ret, i, nslots = sin->din->blocks;
-    for (i = 0; i < nslots; i ++) {
-        if ((ret = sfs_dirent_read_nolock(sfs, sin, i, entry)) != 0) {
+    int ret, i, next, name_len, nslots = sfs_dirent_nslots(sfs, sin->din);
+    uint32_t ent_ino;
+    for (i = 0; i < nslots; i = next) {
+        if ((ret = sfs_dirent_next_nolock(sfs, sin, i, &next, &ent_ino, &name_len)) != 0) {
             return ret;
         }
-        if (entry->ino == ino) {
-            return 0;
+        if (ent_ino == ino) {
+            return sfs_dirent_read_nolock(sfs, sin, i, entry);
         }
     }
     return -E_NOENT;
@@ -493,7 +1347,7 @@ sfs_dirent_findino_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t in
  * @sin:        DIR sfs inode in memory
  * @name:       the file name in DIR
  * @node_store: the inode corresponding the file name in DIR
- * @slot:       the logical index of file entry
+ * @slot:       the slot of file entry
  */
 static int
 sfs_lookup_once(struct sfs_fs *sfs, struct sfs_inode *sin, const char *name, struct inode **node_store, int *slot) {
@@ -537,7 +1391,107 @@ sfs_openfile(struct inode *node, uint32_t open_flags) {
 // sfs_close - close file
 static int
 sfs_close(struct inode *node) {
-    return vop_fsync(node);
+    return sfs_sync_inode(fsop_info(vop_fs(node), sfs), vop_info(node, sfs_inode));
+}
+
+/*
+ * sfs_readahead_nolock - called after blocks [start, end) of file are read. a read starting where
+ *                        the last one stopped is sequential (the last block may be read again if it
+ *                        was read partly), then the window grows from SFS_RA_MIN to SFS_RA_MAX blocks,
+ *                        and when no more than half of the window is left ahead of the reader, blocks
+ *                        up to end + window are loaded into block cache. any other read closes the window.
+ */
+static void
+sfs_readahead_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t start, uint32_t end) {
+    bool sequential = (start == sin->ra_next || start + 1 == sin->ra_next);
+    sin->ra_next = end;
+    if (!sequential) {
+        sin->ra_size = 0, sin->ra_end = end;
+        return;
+    }
+    if (sin->ra_end < end) {
+        sin->ra_end = end;
+    }
+    if (sin->ra_size != 0 && sin->ra_end - end > sin->ra_size / 2) {
+        return;
+    }
+    sin->ra_size = (sin->ra_size == 0) ? SFS_RA_MIN : sin->ra_size * 2;
+    if (sin->ra_size > SFS_RA_MAX) {
+        sin->ra_size = SFS_RA_MAX;
+    }
+
+    struct sfs_disk_inode *din = sin->din;
+    uint32_t last = ROUNDUP_DIV(din->size, SFS_BLKSIZE), ino;
+    if (last > din->blocks) {
+        last = din->blocks;
+    }
+    if (last > end + sin->ra_size) {
+        last = end + sin->ra_size;
+    }
+    // read-ahead is a hint, stop quietly on error. blocks next to each other on disk are
+    // loaded together, [blkno, blkno + nblks) is the run found so far.
+    uint32_t blkno = 0, nblks = 0;
+    for (; sin->ra_end < last; sin->ra_end ++) {
+        if (sfs_bmap_get_nolock(sfs, sin, sin->ra_end, 0, 0, &ino) != 0) {
+            break;
+        }
+        if (nblks != 0 && ino != blkno + nblks) {
+            if (sfs_rablock(sfs, blkno, nblks) != 0) {
+                return;
+            }
+            nblks = 0;
+        }
+        if (ino != 0 && nblks ++ == 0) {
+            blkno = ino;
+        }
+    }
+    if (nblks != 0) {
+        sfs_rablock(sfs, blkno, nblks);
+    }
+}
+
+/*
+ * sfs_inline_spill_nolock - move the content of an inline file into its 1st block, before the
+ *                           file grows beyond SFS_INLINE_SIZE.
+ */
+static int
+sfs_inline_spill_nolock(struct sfs_fs *sfs, struct sfs_inode *sin) {
+    struct sfs_disk_inode *din = sin->din;
+    assert(sfs_inode_inline(sfs, din));
+    if (din->size == 0) {
+        // nothing to move, the file may begin with a hole
+        return 0;
+    }
+    char data[SFS_INLINE_SIZE];
+    uint32_t ino;
+    int ret;
+    memcpy(data, din->inline_data, SFS_INLINE_SIZE);
+    memset(din->inline_data, 0, SFS_INLINE_SIZE);
+    if ((ret = sfs_bmap_load_nolock(sfs, sin, 0, &ino)) != 0) {
+        goto failed_restore;
+    }
+    if ((ret = sfs_wbuf_data(sfs, data, din->size, ino, 0)) != 0) {
+        sfs_bmap_truncate_nolock(sfs, sin, 0);
+        goto failed_restore;
+    }
+    sfs_dirty_inode(sfs, sin);
+    return 0;
+
+failed_restore:
+    memcpy(din->inline_data, data, SFS_INLINE_SIZE);
+    return ret;
+}
+
+/*
+ * sfs_bmap_rw_nolock - find the disk block of logical block index for Rd/Wr. a block to write is
+ *                      allocated if it's in a hole, and 0 is stored for a hole to read.
+ */
+static inline int
+sfs_bmap_rw_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index, bool write, uint32_t *ino_store) {
+    if (write) {
+        return sfs_bmap_load_nolock(sfs, sin, index, ino_store);
+    }
+    return sfs_bmap_get_nolock(sfs, sin, index, 0, 0, ino_store);
 }
 
 /*  
@@ -577,7 +1531,7 @@ sfs_io_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, void *buf, off_t offset
     int (*sfs_buf_op)(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset);
     int (*sfs_block_op)(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks);
     if (write) {
-        sfs_buf_op = sfs_wbuf, sfs_block_op = sfs_wblock;
+        sfs_buf_op = sfs_wbuf_data, sfs_block_op = sfs_wblock_data;
     }
     else {
         sfs_buf_op = sfs_rbuf, sfs_block_op = sfs_rblock;
@@ -589,6 +1543,23 @@ sfs_io_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, void *buf, off_t offset
     uint32_t blkno = offset / SFS_BLKSIZE;          // The NO. of Rd/Wr begin block
     uint32_t nblks = endpos / SFS_BLKSIZE - blkno;  // The size of Rd/Wr blocks
 
+    if (sfs_inode_inline(sfs, din)) {
+        if (!write || endpos <= SFS_INLINE_SIZE) {
+            alen = endpos - offset;
+            if (write) {
+                memcpy(din->inline_data + offset, buf, alen);
+                sfs_dirty_inode(sfs, sin);
+            }
+            else {
+                memcpy(buf, din->inline_data + offset, alen);
+            }
+            goto out;
+        }
+        if ((ret = sfs_inline_spill_nolock(sfs, sin)) != 0) {
+            goto out;
+        }
+    }
+
   //LAB8:EXERCISE1 YOUR CODE HINT: call sfs_bmap_load_nolock, sfs_rbuf, sfs_rblock,etc. read different kind of blocks in file
 	/*
 	 * (1) If offset isn't aligned with the first block, Rd/Wr some content from offset to the end of the first block
@@ -601,10 +1572,13 @@ sfs_io_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, void *buf, off_t offset
 	*/
     if ((blkoff = offset % SFS_BLKSIZE) != 0) {
         size = (nblks != 0) ? (SFS_BLKSIZE - blkoff) : (endpos - offset);
-        if ((ret = sfs_bmap_load_nolock(sfs, sin, blkno, &ino)) != 0) {
+        if ((ret = sfs_bmap_rw_nolock(sfs, sin, blkno, write, &ino)) != 0) {
             goto out;
         }
-        if ((ret = sfs_buf_op(sfs, buf, size, ino, blkoff)) != 0) {
+        if (ino == 0) {
+            memset(buf, 0, size);
+        }
+        else if ((ret = sfs_buf_op(sfs, buf, size, ino, blkoff)) != 0) {
             goto out;
         }
         alen += size;
@@ -614,31 +1588,46 @@ sfs_io_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, void *buf, off_t offset
         buf += size, blkno ++, nblks --;
     }
 
-    size = SFS_BLKSIZE;
     while (nblks != 0) {
-        if ((ret = sfs_bmap_load_nolock(sfs, sin, blkno, &ino)) != 0) {
+        if ((ret = sfs_bmap_rw_nolock(sfs, sin, blkno, write, &ino)) != 0) {
             goto out;
         }
-        if ((ret = sfs_block_op(sfs, buf, ino, 1)) != 0) {
+        // Rd/Wr the run of blocks which are adjacent on disk in one request, a run of a hole reads as zeros
+        uint32_t len = 1, next_ino;
+        while (len < nblks && sfs_bmap_rw_nolock(sfs, sin, blkno + len, write, &next_ino) == 0
+                && next_ino == ((ino == 0) ? 0 : ino + len)) {
+            len ++;
+        }
+        if (ino == 0) {
+            memset(buf, 0, len * SFS_BLKSIZE);
+        }
+        else if ((ret = sfs_block_op(sfs, buf, ino, len)) != 0) {
             goto out;
         }
-        alen += size, buf += size, blkno ++, nblks --;
+        size = len * SFS_BLKSIZE;
+        alen += size, buf += size, blkno += len, nblks -= len;
     }
 
     if ((size = endpos % SFS_BLKSIZE) != 0) {
-        if ((ret = sfs_bmap_load_nolock(sfs, sin, blkno, &ino)) != 0) {
+        if ((ret = sfs_bmap_rw_nolock(sfs, sin, blkno, write, &ino)) != 0) {
             goto out;
         }
-        if ((ret = sfs_buf_op(sfs, buf, size, ino, 0)) != 0) {
+        if (ino == 0) {
+            memset(buf, 0, size);
+        }
+        else if ((ret = sfs_buf_op(sfs, buf, size, ino, 0)) != 0) {
             goto out;
         }
         alen += size;
     }
 out:
     *alenp = alen;
+    if (!write && ret == 0) {
+        sfs_readahead_nolock(sfs, sin, offset / SFS_BLKSIZE, ROUNDUP_DIV(offset + alen, SFS_BLKSIZE));
+    }
     if (offset + alen > sin->din->size) {
         sin->din->size = offset + alen;
-        sin->dirty = 1;
+        sfs_dirty_inode(sfs, sin);
     }
     return ret;
 }
@@ -654,11 +1643,15 @@ sfs_io(struct inode *node, struct iobuf *iob, bool write) {
     int ret;
     lock_sin(sin);
     {
-        size_t alen = iob->io_resid;
-        ret = sfs_io_nolock(sfs, sin, iob->io_base, iob->io_offset, &alen, write);
-        if (alen != 0) {
-            iobuf_skip(iob, alen);
-        }
+        // a segment at a time, up to the first one done short (end of file, or error)
+        size_t seglen, alen;
+        do {
+            alen = seglen = iob->io_seglen;
+            ret = sfs_io_nolock(sfs, sin, iob->io_base, iob->io_offset, &alen, write);
+            if (alen != 0) {
+                iobuf_skip(iob, alen);
+            }
+        } while (ret == 0 && alen == seglen && iob->io_resid != 0);
     }
     unlock_sin(sin);
     return ret;
@@ -694,20 +1687,22 @@ sfs_fstat(struct inode *node, struct stat *stat) {
 }
 
 /*
- * sfs_fsync - Force any dirty inode info associated with this file to stable storage.
+ * sfs_sync_inode - write the dirty inode info into block cache, and take it off dirty list of sfs.
  */
-static int
-sfs_fsync(struct inode *node) {
-    struct sfs_fs *sfs = fsop_info(vop_fs(node), sfs);
-    struct sfs_inode *sin = vop_info(node, sfs_inode);
+int
+sfs_sync_inode(struct sfs_fs *sfs, struct sfs_inode *sin) {
     int ret = 0;
     if (sin->dirty) {
         lock_sin(sin);
         {
             if (sin->dirty) {
-                sin->dirty = 0;
-                if ((ret = sfs_wbuf(sfs, sin->din, sizeof(struct sfs_disk_inode), sin->ino, 0)) != 0) {
-                    sin->dirty = 1;
+                uint32_t blkno;
+                off_t offset;
+                sfs_inode_locate(sfs, sin->ino, &blkno, &offset);
+                // it's still dirty until it's in cache, see sfs_sync_inodes_nolock
+                if ((ret = sfs_wbuf(sfs, sin->din, sizeof(struct sfs_disk_inode), blkno, offset)) == 0) {
+                    sin->dirty = 0;
+                    list_del_init(&(sin->dirty_link));
                 }
             }
         }
@@ -716,6 +1711,49 @@ sfs_fsync(struct inode *node) {
     return ret;
 }
 
+/*
+ * sfs_sync_inodes_nolock - copy all dirty inodes into block cache, called by sfs_journal_commit_nolock
+ *                          with lock_sfs_io held, so a block freed is never committed as free while
+ *                          the inode on disk still maps it. lock_sin can't be taken here: an inode
+ *                          may be in the middle of an operation, but a block is always unmapped
+ *                          before it's freed. the inodes are left dirty for sfs_sync_inode.
+ */
+int
+sfs_sync_inodes_nolock(struct sfs_fs *sfs) {
+    list_entry_t *list = &(sfs->inode_list), *le = list;
+    while ((le = list_next(le)) != list) {
+        // a dirty inode isn't reclaimed meanwhile, sfs_reclaim has to write it first
+        struct sfs_inode *sin = le2sin(le, inode_link);
+        if (sin->dirty) {
+            struct sfs_buf *sbuf;
+            uint32_t blkno;
+            off_t offset;
+            int ret;
+            sfs_inode_locate(sfs, sin->ino, &blkno, &offset);
+            if ((ret = sfs_bcache_get_nolock(sfs, blkno, 1, &sbuf)) != 0) {
+                return ret;
+            }
+            memcpy(sbuf->data + offset, sin->din, sizeof(struct sfs_disk_inode));
+            sfs_bcache_dirty_nolock(sfs, sbuf, 1);
+        }
+    }
+    return 0;
+}
+
+/*
+ * sfs_fsync - Force any dirty inode info associated with this file to stable storage.
+ *             with a journal, the inode and all other metadata in cache are committed to it.
+ */
+static int
+sfs_fsync(struct inode *node) {
+    struct sfs_fs *sfs = fsop_info(vop_fs(node), sfs);
+    int ret;
+    if ((ret = sfs_sync_inode(sfs, vop_info(node, sfs_inode))) == 0 && sfs_journaled(sfs)) {
+        ret = sfs_journal_sync(sfs);
+    }
+    return ret;
+}
+
 /*
  *sfs_namefile -Compute pathname relative to filesystem root of the file and copy to the specified io buffer.
  *  
@@ -723,7 +1761,7 @@ sfs_fsync(struct inode *node) {
 static int
 sfs_namefile(struct inode *node, struct iobuf *iob) {
     struct sfs_disk_entry *entry;
-    if (iob->io_resid <= 2 || (entry = kmalloc(sizeof(struct sfs_disk_entry))) == NULL) {
+    if (iob->io_resid <= 2 || (entry = kmem_cache_alloc(sfs_entry_cachep)) == NULL) {
         return -E_NO_MEM;
     }
 
@@ -771,14 +1809,14 @@ sfs_namefile(struct inode *node, struct iobuf *iob) {
     ptr = memmove(iob->io_base + 1, ptr, alen);
     ptr[-1] = '/', ptr[alen] = '\0';
     iobuf_skip(iob, alen);
-    kfree(entry);
+    kmem_cache_free(sfs_entry_cachep, entry);
     return 0;
 
 failed_nomem:
     ret = -E_NO_MEM;
 failed:
     vop_ref_dec(node);
-    kfree(entry);
+    kmem_cache_free(sfs_entry_cachep, entry);
     return ret;
 }
 
@@ -787,14 +1825,15 @@ failed:
  */
 static int
 sfs_getdirentry_sub_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, int slot, struct sfs_disk_entry *entry) {
-    int ret, i, nslots = sin->din->blocks;
-    for (i = 0; i < nslots; i ++) {
-        if ((ret = sfs_dirent_read_nolock(sfs, sin, i, entry)) != 0) {
+    int ret, i, next, name_len, nslots = sfs_dirent_nslots(sfs, sin->din);
+    uint32_t ino;
+    for (i = 0; i < nslots; i = next) {
+        if ((ret = sfs_dirent_next_nolock(sfs, sin, i, &next, &ino, &name_len)) != 0) {
             return ret;
         }
-        if (entry->ino != 0) {
+        if (ino != 0) {
             if (slot == 0) {
-                return 0;
+                return sfs_dirent_read_nolock(sfs, sin, i, entry);
             }
             slot --;
         }
@@ -809,7 +1848,7 @@ sfs_getdirentry_sub_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, int slot,
 static int
 sfs_getdirentry(struct inode *node, struct iobuf *iob) {
     struct sfs_disk_entry *entry;
-    if ((entry = kmalloc(sizeof(struct sfs_disk_entry))) == NULL) {
+    if ((entry = kmem_cache_alloc(sfs_entry_cachep)) == NULL) {
         return -E_NO_MEM;
     }
 
@@ -819,11 +1858,11 @@ sfs_getdirentry(struct inode *node, struct iobuf *iob) {
     int ret, slot;
     off_t offset = iob->io_offset;
     if (offset < 0 || offset % sfs_dentry_size != 0) {
-        kfree(entry);
+        kmem_cache_free(sfs_entry_cachep, entry);
         return -E_INVAL;
     }
-    if ((slot = offset / sfs_dentry_size) > sin->din->blocks) {
-        kfree(entry);
+    if ((slot = offset / sfs_dentry_size) > sfs_dirent_nslots(sfs, sin->din)) {
+        kmem_cache_free(sfs_entry_cachep, entry);
         return -E_NOENT;
     }
     lock_sin(sin);
@@ -834,7 +1873,7 @@ sfs_getdirentry(struct inode *node, struct iobuf *iob) {
     unlock_sin(sin);
     ret = iobuf_move(iob, entry->name, sfs_dentry_size, 1, NULL);
 out:
-    kfree(entry);
+    kmem_cache_free(sfs_entry_cachep, entry);
     return ret;
 }
 
@@ -857,22 +1896,41 @@ sfs_reclaim(struct inode *node) {
         if ((ret = vop_truncate(node, 0)) != 0) {
             goto failed_unlock;
         }
+        // a packed inode is free once nlinks 0 is written to its slot
+        if (sfs_inode_packed(sfs)) {
+            sfs_dirty_inode(sfs, sin);
+        }
     }
     if (sin->dirty) {
-        if ((ret = vop_fsync(node)) != 0) {
+        if ((ret = sfs_sync_inode(sfs, sin)) != 0) {
             goto failed_unlock;
         }
     }
+    if (sin->din->nlinks != 0) {
+        // keep the clean inode in memory, drop the lru ones if there are too many
+        list_add(&(sfs->lru_list), &(sin->lru_link));
+        if (++ sfs->lru_count > SFS_ICACHE_NR) {
+            sfs_icache_shrink_nolock(sfs, sfs->lru_count - SFS_ICACHE_NR);
+        }
+        unlock_sfs_fs(sfs);
+        return 0;
+    }
     sfs_remove_links(sin);
     unlock_sfs_fs(sfs);
 
     if (sin->din->nlinks == 0) {
-        sfs_block_free(sfs, sin->ino);
-        if ((ent = sin->din->indirect) != 0) {
+        if (!sfs_inode_packed(sfs)) {
+            sfs_block_free(sfs, sin->ino);
+        }
+        if (!sfs_inode_extent(sfs) && (ent = sin->din->indirect) != 0) {
             sfs_block_free(sfs, ent);
         }
     }
-    kfree(sin->din);
+    assert(list_empty(&(sin->dirty_link)));
+    if (sin->indirect_map != NULL) {
+        kfree(sin->indirect_map);
+    }
+    kmem_cache_free(sfs_din_cachep, sin->din);
     vop_kill(node);
     return 0;
 
@@ -917,51 +1975,102 @@ sfs_tryseek(struct inode *node, off_t pos) {
 }
 
 /*
- * sfs_truncfile : reszie the file with new length
+ * sfs_truncfile_nolock - reszie the file with new length. a file grows by a hole, no block is
+ *                        allocated; blocks past the new end are freed in runs by sfs_bmap_truncate_nolock,
+ *                        and the tail of the new last block is cleared, so it reads as zeros if the
+ *                        file grows again.
  */
 static int
-sfs_truncfile(struct inode *node, off_t len) {
-    if (len < 0 || len > SFS_MAX_FILE_SIZE) {
-        return -E_INVAL;
-    }
-    struct sfs_fs *sfs = fsop_info(vop_fs(node), sfs);
-    struct sfs_inode *sin = vop_info(node, sfs_inode);
+sfs_truncfile_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, off_t len) {
     struct sfs_disk_inode *din = sin->din;
-
-    int ret = 0;
+    int ret;
 	//new number of disk blocks of file
-    uint32_t nblks, tblks = ROUNDUP_DIV(len, SFS_BLKSIZE);
+    uint32_t tblks = ROUNDUP_DIV(len, SFS_BLKSIZE);
     if (din->size == len) {
-        assert(tblks == din->blocks);
+        assert(tblks == din->blocks || sfs_inode_inline(sfs, din));
         return 0;
     }
 
-    lock_sin(sin);
-	// old number of disk blocks of file
-    nblks = din->blocks;
-    if (nblks < tblks) {
-		// try to enlarge the file size by add new disk block at the end of file
-        while (nblks != tblks) {
-            if ((ret = sfs_bmap_load_nolock(sfs, sin, nblks, NULL)) != 0) {
-                goto out_unlock;
+    if (sfs_inode_inline(sfs, din)) {
+        if (len <= SFS_INLINE_SIZE) {
+            if (len < din->size) {
+                memset(din->inline_data + len, 0, din->size - len);
             }
-            nblks ++;
+            goto out;
+        }
+        if ((ret = sfs_inline_spill_nolock(sfs, sin)) != 0) {
+            return ret;
         }
     }
-    else if (tblks < nblks) {
-		// try to reduce the file size 
-        while (tblks != nblks) {
-            if ((ret = sfs_bmap_truncate_nolock(sfs, sin)) != 0) {
-                goto out_unlock;
+    if (din->blocks < tblks) {
+		// enlarge the file size by a hole at the end of file
+        din->blocks = tblks;
+    }
+    else if (len < din->size) {
+		// try to reduce the file size
+        uint32_t ino;
+        if (tblks < din->blocks && (ret = sfs_bmap_truncate_nolock(sfs, sin, tblks)) != 0) {
+            return ret;
+        }
+        if (len % SFS_BLKSIZE != 0) {
+            off_t blkoff = len % SFS_BLKSIZE;
+            if ((ret = sfs_bmap_get_nolock(sfs, sin, tblks - 1, 0, 0, &ino)) != 0) {
+                return ret;
+            }
+            if (ino != 0 && (ret = sfs_zbuf_data(sfs, SFS_BLKSIZE - blkoff, ino, blkoff)) != 0) {
+                return ret;
             }
-            nblks --;
         }
     }
     assert(din->blocks == tblks);
+
+out:
     din->size = len;
-    sin->dirty = 1;
+    sfs_dirty_inode(sfs, sin);
+    return 0;
+}
 
-out_unlock:
+/*
+ * sfs_truncfile : reszie the file with new length
+ */
+static int
+sfs_truncfile(struct inode *node, off_t len) {
+    if (len < 0 || len > SFS_MAX_FILE_SIZE) {
+        return -E_INVAL;
+    }
+    struct sfs_fs *sfs = fsop_info(vop_fs(node), sfs);
+    struct sfs_inode *sin = vop_info(node, sfs_inode);
+    int ret;
+    lock_sin(sin);
+    {
+        ret = sfs_truncfile_nolock(sfs, sin, len);
+    }
+    unlock_sin(sin);
+    return ret;
+}
+
+/*
+ * sfs_fallocate - make sure the disk blocks for [pos, pos + len) of file are allocated, so later
+ *                 writes to the range don't fail for lack of space. holes in the range are filled,
+ *                 and the file is extended to pos + len if it's shorter (as posix_fallocate does).
+ */
+static int
+sfs_fallocate(struct inode *node, off_t pos, off_t len) {
+    if (pos < 0 || len <= 0 || pos > SFS_MAX_FILE_SIZE || len > SFS_MAX_FILE_SIZE - pos) {
+        return -E_INVAL;
+    }
+    struct sfs_fs *sfs = fsop_info(vop_fs(node), sfs);
+    struct sfs_inode *sin = vop_info(node, sfs_inode);
+    int ret = 0;
+    lock_sin(sin);
+    {
+        if (pos + len > sin->din->size) {
+            ret = sfs_truncfile_nolock(sfs, sin, pos + len);
+        }
+        if (ret == 0 && !sfs_inode_inline(sfs, sin->din)) {
+            ret = sfs_bmap_alloc_nolock(sfs, sin, pos / SFS_BLKSIZE, ROUNDUP_DIV(pos + len, SFS_BLKSIZE));
+        }
+    }
     unlock_sin(sin);
     return ret;
 }
@@ -969,26 +2078,46 @@ out_unlock:
 /*
  * sfs_lookup - Parse path relative to the passed directory
  *              DIR, and hand back the inode for the file it
- *              refers to.
+ *              refers to. path is walked one component at a time,
+ *              and it's left unchanged.
  */
 static int
 sfs_lookup(struct inode *node, char *path, struct inode **node_store) {
     struct sfs_fs *sfs = fsop_info(vop_fs(node), sfs);
     assert(*path != '\0' && *path != '/');
     vop_ref_inc(node);
-    struct sfs_inode *sin = vop_info(node, sfs_inode);
-    if (sin->din->type != SFS_TYPE_DIR) {
+    while (1) {
+        struct sfs_inode *sin = vop_info(node, sfs_inode);
+        if (sin->din->type != SFS_TYPE_DIR) {
+            vop_ref_dec(node);
+            return -E_NOTDIR;
+        }
+        char *slash = strchr(path, '/');
+        if (slash != NULL) {
+            *slash = '\0';
+        }
+        struct inode *subnode;
+        int ret = sfs_lookup_once(sfs, sin, path, &subnode, NULL);
         vop_ref_dec(node);
-        return -E_NOTDIR;
-    }
-    struct inode *subnode;
-    int ret = sfs_lookup_once(sfs, sin, path, &subnode, NULL);
-
-    vop_ref_dec(node);
-    if (ret != 0) {
-        return ret;
+        if (slash != NULL) {
+            *slash = '/';
+        }
+        if (ret != 0) {
+            return ret;
+        }
+        node = subnode;
+        if (slash == NULL) {
+            break;
+        }
+        path = slash + 1;
+        while (*path == '/') {
+            path ++;
+        }
+        if (*path == '\0') {
+            break;
+        }
     }
-    *node_store = subnode;
+    *node_store = node;
     return 0;
 }
 
@@ -1018,5 +2147,6 @@ static const struct inode_ops sfs_node_fileops = {
     .vop_gettype                    = sfs_gettype,
     .vop_tryseek                    = sfs_tryseek,
     .vop_truncate                   = sfs_truncfile,
+    .vop_fallocate                  = sfs_fallocate,
 };
 
@@ -8,40 +8,97 @@
 
 //Basic block-level I/O routines
 
-/* sfs_rwblock_nolock - Basic block-level I/O routine for Rd/Wr one disk block,
+/* sfs_rwblock_nolock - Basic block-level I/O routine for Rd/Wr one disk block through block cache,
  *                      without lock protect for mutex process on Rd/Wr disk block
  * @sfs:   sfs_fs which will be process
  * @buf:   the buffer uesed for Rd/Wr
  * @blkno: the NO. of disk block
  * @write: BOOL: Read or Write
  * @check: BOOL: if check (blono < sfs super.blocks)
+ * @meta:  BOOL: metadata is written (through journal), or file data
  */
 static int
-sfs_rwblock_nolock(struct sfs_fs *sfs, void *buf, uint32_t blkno, bool write, bool check) {
+sfs_rwblock_nolock(struct sfs_fs *sfs, void *buf, uint32_t blkno, bool write, bool check, bool meta) {
     assert((blkno != 0 || !check) && blkno < sfs->super.blocks);
-    struct iobuf __iob, *iob = iobuf_init(&__iob, buf, SFS_BLKSIZE, blkno * SFS_BLKSIZE);
-    return dop_io(sfs->dev, iob, write);
+    struct sfs_buf *sbuf;
+    int ret;
+    // a whole block is written, no need to read it from disk
+    if ((ret = sfs_bcache_get_nolock(sfs, blkno, !write, &sbuf)) == 0) {
+        if (write) {
+            memcpy(sbuf->data, buf, SFS_BLKSIZE);
+            sfs_bcache_dirty_nolock(sfs, sbuf, meta);
+        }
+        else {
+            memcpy(buf, sbuf->data, SFS_BLKSIZE);
+        }
+    }
+    return ret;
+}
+
+/* sfs_rwblocks_nolock - Block-level I/O routine for Rd/Wr N continuous disk blocks,
+ *                       without lock protect for mutex process on Rd/Wr disk block
+ *                       the blocks in block cache are copied from/to their buffers, and each run of
+ *                       blocks not in cache is moved by ONE device request, without passing the cache.
+ *                       only file data is written this way, metadata must go through journal.
+ * @sfs:   sfs_fs which will be process
+ * @buf:   the buffer uesed for Rd/Wr
+ * @blkno: the NO. of the first disk block
+ * @nblks: Rd/Wr number of disk block
+ * @write: BOOL: Read - 0 or Write - 1
+ */
+static int
+sfs_rwblocks_nolock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks, bool write) {
+    assert(blkno != 0 && blkno + nblks <= sfs->super.blocks);
+    uint32_t i, start = 0;
+    for (i = 0; i <= nblks; i ++) {
+        struct sfs_buf *sbuf = NULL;
+        if (i < nblks && (sbuf = sfs_bcache_lookup_nolock(sfs, blkno + i)) == NULL) {
+            continue;
+        }
+        // blocks [start, i) are not in cache
+        if (start < i) {
+            struct iobuf __iob, *iob = iobuf_init(&__iob, buf + start * SFS_BLKSIZE,
+                    (i - start) * SFS_BLKSIZE, (blkno + start) * SFS_BLKSIZE);
+            int ret;
+            if ((ret = dop_io(sfs->dev, iob, write)) != 0) {
+                return ret;
+            }
+        }
+        if (sbuf != NULL) {
+            if (write) {
+                memcpy(sbuf->data, buf + i * SFS_BLKSIZE, SFS_BLKSIZE);
+                sfs_bcache_dirty_nolock(sfs, sbuf, 0);
+            }
+            else {
+                memcpy(buf + i * SFS_BLKSIZE, sbuf->data, SFS_BLKSIZE);
+            }
+        }
+        start = i + 1;
+    }
+    return 0;
 }
 
 /* sfs_rwblock - Basic block-level I/O routine for Rd/Wr N disk blocks ,
  *               with lock protect for mutex process on Rd/Wr disk block
+ *               one block goes through block cache, more blocks are moved by sfs_rwblocks_nolock.
  * @sfs:   sfs_fs which will be process
  * @buf:   the buffer uesed for Rd/Wr
  * @blkno: the NO. of disk block
  * @nblks: Rd/Wr number of disk block
  * @write: BOOL: Read - 0 or Write - 1
+ * @meta:  BOOL: metadata is written (one block only), or file data
  */
 static int
-sfs_rwblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks, bool write) {
+sfs_rwblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks, bool write, bool meta) {
+    assert(nblks <= 1 || !meta);
     int ret = 0;
     lock_sfs_io(sfs);
     {
-        while (nblks != 0) {
-            if ((ret = sfs_rwblock_nolock(sfs, buf, blkno, write, 1)) != 0) {
-                break;
-            }
-            blkno ++, nblks --;
-            buf += SFS_BLKSIZE;
+        if (nblks == 1) {
+            ret = sfs_rwblock_nolock(sfs, buf, blkno, write, 1, meta);
+        }
+        else if (nblks != 0) {
+            ret = sfs_rwblocks_nolock(sfs, buf, blkno, nblks, write);
         }
     }
     unlock_sfs_io(sfs);
@@ -57,22 +114,34 @@ sfs_rwblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks, bool
  */
 int
 sfs_rblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks) {
-    return sfs_rwblock(sfs, buf, blkno, nblks, 0);
+    return sfs_rwblock(sfs, buf, blkno, nblks, 0, 0);
 }
 
-/* sfs_wblock - The Wrap of sfs_rwblock function for Wr N disk blocks ,
+/* sfs_wblock - The Wrap of sfs_rwblock function for Wr one metadata disk block ,
  *
  * @sfs:   sfs_fs which will be process
  * @buf:   the buffer uesed for Rd/Wr
  * @blkno: the NO. of disk block
- * @nblks: Rd/Wr number of disk block
+ * @nblks: Rd/Wr number of disk block, must be 1
  */
 int
 sfs_wblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks) {
-    return sfs_rwblock(sfs, buf, blkno, nblks, 1);
+    return sfs_rwblock(sfs, buf, blkno, nblks, 1, 1);
+}
+
+/* sfs_wblock_data - The Wrap of sfs_rwblock function for Wr N disk blocks of file data,
+ *                   which don't go through journal.
+ * @sfs:   sfs_fs which will be process
+ * @buf:   the buffer uesed for Rd/Wr
+ * @blkno: the NO. of disk block
+ * @nblks: Rd/Wr number of disk block
+ */
+int
+sfs_wblock_data(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks) {
+    return sfs_rwblock(sfs, buf, blkno, nblks, 1, 0);
 }
 
-/* sfs_rbuf - The Basic block-level I/O routine for  Rd( non-block & non-aligned io) one disk block(using sfs->sfs_buffer)
+/* sfs_rbuf - The Basic block-level I/O routine for  Rd( non-block & non-aligned io) one disk block(using block cache)
  *            with lock protect for mutex process on Rd/Wr disk block
  * @sfs:    sfs_fs which will be process
  * @buf:    the buffer uesed for Rd
@@ -83,18 +152,40 @@ sfs_wblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks) {
 int
 sfs_rbuf(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset) {
     assert(offset >= 0 && offset < SFS_BLKSIZE && offset + len <= SFS_BLKSIZE);
+    assert(blkno != 0 && blkno < sfs->super.blocks);
+    struct sfs_buf *sbuf;
     int ret;
     lock_sfs_io(sfs);
     {
-        if ((ret = sfs_rwblock_nolock(sfs, sfs->sfs_buffer, blkno, 0, 1)) == 0) {
-            memcpy(buf, sfs->sfs_buffer + offset, len);
+        if ((ret = sfs_bcache_get_nolock(sfs, blkno, 1, &sbuf)) == 0) {
+            memcpy(buf, sbuf->data + offset, len);
         }
     }
     unlock_sfs_io(sfs);
     return ret;
 }
 
-/* sfs_wbuf - The Basic block-level I/O routine for  Wr( non-block & non-aligned io) one disk block(using sfs->sfs_buffer)
+/* sfs_rwbuf_write - write part of one disk block through block cache, with lock protect.
+ * @meta:   BOOL: metadata is written (through journal), or file data
+ */
+static int
+sfs_rwbuf_write(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset, bool meta) {
+    assert(offset >= 0 && offset < SFS_BLKSIZE && offset + len <= SFS_BLKSIZE);
+    assert(blkno != 0 && blkno < sfs->super.blocks);
+    struct sfs_buf *sbuf;
+    int ret;
+    lock_sfs_io(sfs);
+    {
+        if ((ret = sfs_bcache_get_nolock(sfs, blkno, 1, &sbuf)) == 0) {
+            memcpy(sbuf->data + offset, buf, len);
+            sfs_bcache_dirty_nolock(sfs, sbuf, meta);
+        }
+    }
+    unlock_sfs_io(sfs);
+    return ret;
+}
+
+/* sfs_wbuf - The Basic block-level I/O routine for  Wr( non-block & non-aligned io) one metadata disk block(using block cache)
  *            with lock protect for mutex process on Rd/Wr disk block
  * @sfs:    sfs_fs which will be process
  * @buf:    the buffer uesed for Wr
@@ -104,60 +195,120 @@ sfs_rbuf(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset
  */
 int
 sfs_wbuf(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset) {
-    assert(offset >= 0 && offset < SFS_BLKSIZE && offset + len <= SFS_BLKSIZE);
+    return sfs_rwbuf_write(sfs, buf, len, blkno, offset, 1);
+}
+
+/* sfs_wbuf_data - same as sfs_wbuf, for part of a block of file data, which doesn't go through journal.
+ */
+int
+sfs_wbuf_data(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset) {
+    return sfs_rwbuf_write(sfs, buf, len, blkno, offset, 0);
+}
+
+/* sfs_rablock - load N continuous disk blocks into block cache before they're read (read-ahead),
+ *               with lock protect for mutex process on Rd/Wr disk block
+ * @sfs:    sfs_fs which will be process
+ * @blkno:  the NO. of the first disk block
+ * @nblks:  number of disk blocks, at most SFS_RA_MAX
+ */
+int
+sfs_rablock(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks) {
+    assert(blkno != 0 && blkno + nblks <= sfs->super.blocks);
     int ret;
     lock_sfs_io(sfs);
     {
-        if ((ret = sfs_rwblock_nolock(sfs, sfs->sfs_buffer, blkno, 0, 1)) == 0) {
-            memcpy(sfs->sfs_buffer + offset, buf, len);
-            ret = sfs_rwblock_nolock(sfs, sfs->sfs_buffer, blkno, 1, 1);
-        }
+        ret = sfs_bcache_readahead_nolock(sfs, blkno, nblks);
     }
     unlock_sfs_io(sfs);
     return ret;
 }
 
 /*
- * sfs_sync_super - write sfs->super (in memory) into disk (SFS_BLKN_SUPER, 1) with lock protect.
+ * sfs_sync_super_nolock - write sfs->super (in memory) into block cache (SFS_BLKN_SUPER, 1) without lock protect.
  */
-int
-sfs_sync_super(struct sfs_fs *sfs) {
+static int
+sfs_sync_super_nolock(struct sfs_fs *sfs) {
+    struct sfs_buf *sbuf;
     int ret;
-    lock_sfs_io(sfs);
-    {
-        memset(sfs->sfs_buffer, 0, SFS_BLKSIZE);
-        memcpy(sfs->sfs_buffer, &(sfs->super), sizeof(sfs->super));
-        ret = sfs_rwblock_nolock(sfs, sfs->sfs_buffer, SFS_BLKN_SUPER, 1, 0);
+    if ((ret = sfs_bcache_get_nolock(sfs, SFS_BLKN_SUPER, 0, &sbuf)) == 0) {
+        memset(sbuf->data, 0, SFS_BLKSIZE);
+        memcpy(sbuf->data, &(sfs->super), sizeof(sfs->super));
+        sfs_bcache_dirty_nolock(sfs, sbuf, 1);
     }
-    unlock_sfs_io(sfs);
     return ret;
 }
 
 /*
- * sfs_sync_freemap - write sfs bitmap into disk (SFS_BLKN_FREEMAP, nblks)  without lock protect.
+ * sfs_sync_freemap_nolock - write the dirty blocks of sfs bitmap into block cache (SFS_BLKN_FREEMAP, nblks)
+ *                           without lock protect.
+ */
+static int
+sfs_sync_freemap_nolock(struct sfs_fs *sfs) {
+    uint32_t i, nblks = sfs_freemap_blocks(&(sfs->super));
+    void *data = bitmap_getdata(sfs->freemap, NULL);
+    int ret;
+    for (i = 0; i < nblks; i ++) {
+        if (sfs->freemap_dirty[i]) {
+            sfs->freemap_dirty[i] = 0;
+            if ((ret = sfs_rwblock_nolock(sfs, data + i * SFS_BLKSIZE, SFS_BLKN_FREEMAP + i, 1, 1, 1)) != 0) {
+                sfs->freemap_dirty[i] = 1;
+                return ret;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * sfs_sync_fsinfo_nolock - write superblock and dirty freemap blocks into block cache if they're modified,
+ *                          without lock protect.
  */
 int
-sfs_sync_freemap(struct sfs_fs *sfs) {
-    uint32_t nblks = sfs_freemap_blocks(&(sfs->super));
-    return sfs_wblock(sfs, bitmap_getdata(sfs->freemap, NULL), SFS_BLKN_FREEMAP, nblks);
+sfs_sync_fsinfo_nolock(struct sfs_fs *sfs) {
+    int ret = 0;
+    if (sfs->super_dirty) {
+        sfs->super_dirty = 0;
+        if ((ret = sfs_sync_super_nolock(sfs)) != 0 || (ret = sfs_sync_freemap_nolock(sfs)) != 0) {
+            sfs->super_dirty = 1;
+        }
+    }
+    return ret;
+}
+
+/*
+ * sfs_dirty_freemap - mark the freemap blocks which hold the bits of blocks [blkno, blkno + nblks)
+ *                     dirty, so sfs_sync_freemap writes them (and only them).
+ */
+void
+sfs_dirty_freemap(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks) {
+    assert(nblks != 0 && blkno + nblks <= sfs->super.blocks);
+    uint32_t i;
+    for (i = blkno / SFS_BLKBITS; i <= (blkno + nblks - 1) / SFS_BLKBITS; i ++) {
+        sfs->freemap_dirty[i] = 1;
+    }
+    sfs->super_dirty = 1;
 }
 
 /*
- * sfs_clear_block - write zero info into disk (blkno, nblks)  with lock protect.
+ * sfs_clear_block - write zero info into block cache (blkno, nblks)  with lock protect.
+ *                   blocks just allocated are cleared, they're journaled once metadata is written in them.
  * @sfs:   sfs_fs which will be process
  * @blkno: the NO. of disk block
  * @nblks: Rd/Wr number of disk block
  */
 int
 sfs_clear_block(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks) {
-    int ret;
+    assert(blkno != 0 && blkno + nblks <= sfs->super.blocks);
+    struct sfs_buf *sbuf;
+    int ret = 0;
     lock_sfs_io(sfs);
     {
-        memset(sfs->sfs_buffer, 0, SFS_BLKSIZE);
         while (nblks != 0) {
-            if ((ret = sfs_rwblock_nolock(sfs, sfs->sfs_buffer, blkno, 1, 1)) != 0) {
+            if ((ret = sfs_bcache_get_nolock(sfs, blkno, 0, &sbuf)) != 0) {
                 break;
             }
+            memset(sbuf->data, 0, SFS_BLKSIZE);
+            sfs_bcache_dirty_nolock(sfs, sbuf, 0);
             blkno ++, nblks --;
         }
     }
@@ -165,3 +316,41 @@ sfs_clear_block(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks) {
     return ret;
 }
 
+/* sfs_zbuf_write - zero part of one disk block through block cache, with lock protect.
+ * @meta:   BOOL: metadata is written (through journal), or file data
+ */
+static int
+sfs_zbuf_write(struct sfs_fs *sfs, size_t len, uint32_t blkno, off_t offset, bool meta) {
+    assert(offset >= 0 && offset < SFS_BLKSIZE && offset + len <= SFS_BLKSIZE);
+    assert(blkno != 0 && blkno < sfs->super.blocks);
+    struct sfs_buf *sbuf;
+    int ret;
+    lock_sfs_io(sfs);
+    {
+        if ((ret = sfs_bcache_get_nolock(sfs, blkno, 1, &sbuf)) == 0) {
+            memset(sbuf->data + offset, 0, len);
+            sfs_bcache_dirty_nolock(sfs, sbuf, meta);
+        }
+    }
+    unlock_sfs_io(sfs);
+    return ret;
+}
+
+/*
+ * sfs_zbuf - write zero info into part of a metadata disk block (blkno, offset, len) with lock protect.
+ * @sfs:    sfs_fs which will be process
+ * @len:    the length need to Wr
+ * @blkno:  the NO. of disk block
+ * @offset: the offset in the content of disk block
+ */
+int
+sfs_zbuf(struct sfs_fs *sfs, size_t len, uint32_t blkno, off_t offset) {
+    return sfs_zbuf_write(sfs, len, blkno, offset, 1);
+}
+
+/* sfs_zbuf_data - same as sfs_zbuf, for part of a block of file data, which doesn't go through journal.
+ */
+int
+sfs_zbuf_data(struct sfs_fs *sfs, size_t len, uint32_t blkno, off_t offset) {
+    return sfs_zbuf_write(sfs, len, blkno, offset, 0);
+}
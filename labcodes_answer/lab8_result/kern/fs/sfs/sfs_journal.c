@@ -0,0 +1,448 @@
+#include <defs.h>
+#include <stdio.h>
+#include <string.h>
+#include <kmalloc.h>
+#include <dev.h>
+#include <sfs.h>
+#include <iobuf.h>
+#include <bitmap.h>
+#include <error.h>
+#include <assert.h>
+
+/*
+ * Metadata journal of sfs (SFS_VERSION_JOURNAL). A modified metadata block stays in
+ * block cache (jdirty, see sfs_bcache_dirty_nolock) until a commit copies all such
+ * blocks into the journal as one transaction, written in sequence after the last one.
+ * Dirty file data in cache is written in place before that, so committed metadata
+ * never points to stale data. A committed block may be written in place at any time
+ * later. When the journal is nearly full, or sfs_sync is called, all dirty blocks are
+ * written in place and the journal is emptied (checkpoint) by moving the header on.
+ *
+ * Superblock and freemap don't go through block cache: a commit copies them from memory
+ * (fsinfo) into the transaction, and a checkpoint writes that copy in place. Blocks freed
+ * are kept in use until the transaction freeing them is committed, and their copies in
+ * journal are revoked, so they don't overwrite what the blocks hold after reuse. Inodes
+ * are kept in memory, so every commit which frees blocks copies the dirty ones first.
+ *
+ * fsync commits by sfs_journal_sync, callers which wait for the commit of another one
+ * started after their changes return without a commit of their own (group commit).
+ *
+ * All functions with _nolock should be called with lock_sfs_io held.
+ */
+
+#define fsinfo_block(jnl, i)                        ((jnl)->fsinfo + (i) * SFS_BLKSIZE)
+
+/*
+ * sfs_journal_rw - read/write block (index) of journal directly.
+ */
+static int
+sfs_journal_rw(struct sfs_fs *sfs, void *buf, uint32_t index, bool write) {
+    assert(index < sfs->super.journal_blocks);
+    struct iobuf __iob, *iob = iobuf_init(&__iob, buf, SFS_BLKSIZE,
+            (sfs->super.journal_start + index) * SFS_BLKSIZE);
+    return dop_io(sfs->dev, iob, write);
+}
+
+/*
+ * sfs_journal_rw_fsinfo - read/write the superblock and the whole freemap in place from/to fsinfo.
+ */
+static int
+sfs_journal_rw_fsinfo(struct sfs_fs *sfs, bool write) {
+    struct iobuf __iob, *iob = iobuf_init(&__iob, fsinfo_block(&(sfs->journal), 0), SFS_BLKSIZE,
+            SFS_BLKN_SUPER * SFS_BLKSIZE);
+    int ret;
+    if ((ret = dop_io(sfs->dev, iob, write)) == 0) {
+        iob = iobuf_init(&__iob, fsinfo_block(&(sfs->journal), 1),
+                sfs_freemap_blocks(&(sfs->super)) * SFS_BLKSIZE, SFS_BLKN_FREEMAP * SFS_BLKSIZE);
+        ret = dop_io(sfs->dev, iob, write);
+    }
+    return ret;
+}
+
+/*
+ * sfs_journal_write_header - write the header, transactions from seq on (at block 1) are replayed at mount.
+ */
+static int
+sfs_journal_write_header(struct sfs_fs *sfs, uint32_t seq) {
+    struct sfs_journal_block *hdr = sfs->journal.buffer;
+    memset(hdr, 0, SFS_BLKSIZE);
+    hdr->magic = SFS_JOURNAL_MAGIC, hdr->seq = seq;
+    return sfs_journal_rw(sfs, hdr, 0, 1);
+}
+
+/*
+ * sfs_journal_read_trans - read the descriptor of transaction seq at block pos into desc,
+ *                          return true if the whole transaction (with commit block) is there.
+ */
+static bool
+sfs_journal_read_trans(struct sfs_fs *sfs, struct sfs_journal_block *desc, uint32_t pos, uint32_t seq) {
+    struct sfs_journal_block *commit = sfs->sfs_buffer;
+    uint32_t nblocks;
+    if (pos + 2 > sfs->super.journal_blocks || sfs_journal_rw(sfs, desc, pos, 0) != 0) {
+        return 0;
+    }
+    if (desc->magic != SFS_JOURNAL_DESC || desc->seq != seq || (nblocks = desc->nblocks) > SFS_JOURNAL_NTAG
+            || desc->nrevoked > SFS_JOURNAL_NTAG - nblocks || pos + nblocks + 2 > sfs->super.journal_blocks) {
+        return 0;
+    }
+    if (sfs_journal_rw(sfs, commit, pos + nblocks + 1, 0) != 0) {
+        return 0;
+    }
+    return commit->magic == SFS_JOURNAL_COMMIT && commit->seq == seq && commit->nblocks == nblocks;
+}
+
+// sfs_journal_find - return the index of blkno in blknos[0, n), or n if it isn't there
+static uint32_t
+sfs_journal_find(uint32_t *blknos, uint32_t n, uint32_t blkno) {
+    uint32_t i;
+    for (i = 0; i < n && blknos[i] != blkno; i ++)
+        /* nothing */ ;
+    return i;
+}
+
+/*
+ * sfs_journal_replay - write the blocks of all committed transactions in place, called by sfs_journal_init.
+ *                      revoked/jblocks hold the revoke records meanwhile: block revoked[i] isn't written
+ *                      from the transactions up to jblocks[i].
+ */
+static int
+sfs_journal_replay(struct sfs_fs *sfs, uint32_t seq, uint32_t *seq_store) {
+    struct sfs_journal *jnl = &(sfs->journal);
+    struct sfs_journal_block *desc = jnl->buffer;
+    uint32_t i, j, n, pos, end, nrevoked = 0;
+    int ret;
+
+    // pass 1: find the committed transactions and their revoke records
+    for (pos = 1, end = seq; sfs_journal_read_trans(sfs, desc, pos, end); pos += desc->nblocks + 2, end ++) {
+        for (i = 0; i < desc->nrevoked; i ++) {
+            uint32_t blkno = desc->blknos[desc->nblocks + i];
+            if ((j = sfs_journal_find(jnl->revoked, nrevoked, blkno)) == nrevoked) {
+                if (nrevoked == sfs->super.journal_blocks) {
+                    return -E_INVAL;
+                }
+                jnl->revoked[nrevoked ++] = blkno;
+            }
+            jnl->jblocks[j] = end;
+        }
+    }
+
+    // pass 2: write the copies in order, a later copy overwrites an earlier one
+    for (pos = 1, n = seq; n != end; pos += desc->nblocks + 2, n ++) {
+        if (!sfs_journal_read_trans(sfs, desc, pos, n)) {
+            return -E_INVAL;
+        }
+        for (i = 0; i < desc->nblocks; i ++) {
+            uint32_t blkno = desc->blknos[i];
+            if ((j = sfs_journal_find(jnl->revoked, nrevoked, blkno)) < nrevoked && jnl->jblocks[j] >= n) {
+                continue;
+            }
+            if (blkno >= sfs->super.blocks || (blkno >= sfs->super.journal_start
+                        && blkno < sfs->super.journal_start + sfs->super.journal_blocks)) {
+                return -E_INVAL;
+            }
+            struct iobuf __iob, *iob = iobuf_init(&__iob, sfs->sfs_buffer, SFS_BLKSIZE, blkno * SFS_BLKSIZE);
+            if ((ret = sfs_journal_rw(sfs, sfs->sfs_buffer, pos + 1 + i, 0)) != 0
+                    || (ret = dop_io(sfs->dev, iob, 1)) != 0) {
+                return ret;
+            }
+        }
+    }
+    if (end != seq) {
+        cprintf("sfs: journal: replayed %u transactions.\n", end - seq);
+    }
+    *seq_store = end;
+    return 0;
+}
+
+/*
+ * sfs_journal_init - alloc the journal and replay it, called by sfs_do_mount before the freemap
+ *                    is loaded. the superblock has to be read again after it, the freemap is
+ *                    copied from fsinfo.
+ */
+int
+sfs_journal_init(struct sfs_fs *sfs) {
+    struct sfs_journal *jnl = &(sfs->journal);
+    uint32_t nfsinfo = 1 + sfs_freemap_blocks(&(sfs->super));
+    int ret = -E_NO_MEM;
+
+    memset(jnl, 0, sizeof(struct sfs_journal));
+    if ((jnl->buffer = kmalloc(SFS_BLKSIZE)) == NULL) {
+        goto failed;
+    }
+    if ((jnl->fsinfo = kmalloc(SFS_BLKSIZE * nfsinfo)) == NULL) {
+        goto failed_cleanup_buffer;
+    }
+    if ((jnl->jblocks = kmalloc(sizeof(uint32_t) * sfs->super.journal_blocks)) == NULL) {
+        goto failed_cleanup_fsinfo;
+    }
+    if ((jnl->revoked = kmalloc(sizeof(uint32_t) * sfs->super.journal_blocks)) == NULL) {
+        goto failed_cleanup_jblocks;
+    }
+
+    struct sfs_journal_block *hdr = jnl->buffer;
+    if ((ret = sfs_journal_rw(sfs, hdr, 0, 0)) != 0) {
+        goto failed_cleanup_revoked;
+    }
+    if (hdr->magic != SFS_JOURNAL_MAGIC) {
+        cprintf("sfs: wrong magic in journal. (%08x should be %08x).\n", hdr->magic, SFS_JOURNAL_MAGIC);
+        ret = -E_INVAL;
+        goto failed_cleanup_revoked;
+    }
+    if ((ret = sfs_journal_replay(sfs, hdr->seq, &(jnl->seq))) != 0) {
+        cprintf("sfs: replay journal failed: %e.\n", ret);
+        goto failed_cleanup_revoked;
+    }
+    if ((ret = sfs_journal_write_header(sfs, jnl->seq)) != 0) {
+        goto failed_cleanup_revoked;
+    }
+    if ((ret = sfs_journal_rw_fsinfo(sfs, 0)) != 0) {
+        goto failed_cleanup_revoked;
+    }
+    jnl->pos = 1;
+    return 0;
+
+failed_cleanup_revoked:
+    kfree(jnl->revoked);
+failed_cleanup_jblocks:
+    kfree(jnl->jblocks);
+failed_cleanup_fsinfo:
+    kfree(jnl->fsinfo);
+failed_cleanup_buffer:
+    kfree(jnl->buffer);
+failed:
+    return ret;
+}
+
+/*
+ * sfs_journal_destroy - free the journal, called by sfs_unmount after the last checkpoint.
+ */
+void
+sfs_journal_destroy(struct sfs_fs *sfs) {
+    struct sfs_journal *jnl = &(sfs->journal);
+    assert(jnl->nfreed == 0);
+    kfree(jnl->revoked);
+    kfree(jnl->jblocks);
+    kfree(jnl->fsinfo);
+    kfree(jnl->buffer);
+}
+
+/*
+ * sfs_journal_free - free blocks [blkno, blkno + nblks) in the next transaction. they're kept in
+ *                    use until it's committed, so nothing is written to them before the metadata
+ *                    freeing them is in journal. what is in cache for them isn't written at all
+ *                    (it may be uncommitted metadata), and their copies in journal are revoked.
+ */
+void
+sfs_journal_free(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks) {
+    struct sfs_journal *jnl = &(sfs->journal);
+    uint32_t i;
+    int ret;
+    lock_sfs_io(sfs);
+    {
+        if (jnl->nfreed == SFS_JOURNAL_NFREE && (ret = sfs_journal_commit_nolock(sfs)) != 0) {
+            warn("sfs: journal: commit failed: %e.\n", ret);
+        }
+        assert(jnl->nfreed < SFS_JOURNAL_NFREE);
+        if (jnl->nfreed != 0 && jnl->freed[jnl->nfreed - 1].blkno + jnl->freed[jnl->nfreed - 1].nblks == blkno) {
+            jnl->freed[jnl->nfreed - 1].nblks += nblks;
+        }
+        else {
+            jnl->freed[jnl->nfreed].blkno = blkno, jnl->freed[jnl->nfreed].nblks = nblks;
+            jnl->nfreed ++;
+        }
+        for (i = 0; i < nblks; i ++) {
+            struct sfs_buf *sbuf;
+            if ((sbuf = sfs_bcache_find_nolock(sfs, blkno + i)) != NULL) {
+                sbuf->dirty = sbuf->jdirty = 0;
+            }
+        }
+        for (i = 0; i < jnl->njblocks; i ++) {
+            uint32_t jblk = jnl->jblocks[i];
+            if (jblk >= blkno && jblk < blkno + nblks
+                    && sfs_journal_find(jnl->revoked, jnl->nrevoked, jblk) == jnl->nrevoked) {
+                jnl->revoked[jnl->nrevoked ++] = jblk;
+            }
+        }
+    }
+    unlock_sfs_io(sfs);
+}
+
+/*
+ * sfs_journal_commit_nolock - copy dirty inodes into cache and write dirty file data in place, then
+ *                             copy the superblock and freemap (if modified), all blocks waiting for
+ *                             journal and the revoke records into journal as one transaction. the
+ *                             journal is emptied if there may be no room for the next one.
+ */
+int
+sfs_journal_commit_nolock(struct sfs_fs *sfs) {
+    struct sfs_journal *jnl = &(sfs->journal);
+    struct sfs_bcache *bc = &(sfs->bcache);
+    struct sfs_journal_block *desc = jnl->buffer;
+    uint32_t i, nfsinfo = 0, nblocks, nrevoked = 0;
+    uint32_t nfm = sfs_freemap_blocks(&(sfs->super));
+    int ret;
+
+    // an inode which freed blocks may not be in cache yet, so all dirty inodes are copied first, and the
+    // frees go with them. a commit to make room in cache meanwhile leaves the frees and revoke records.
+    bool frees = !jnl->syncing;
+    if (frees) {
+        jnl->syncing = 1;
+        ret = sfs_sync_inodes_nolock(sfs);
+        jnl->syncing = 0;
+        if (ret != 0) {
+            return ret;
+        }
+        // the blocks freed may be allocated again now, they're written with lock_sfs_io held, after the commit
+        for (i = 0; i < jnl->nfreed; i ++) {
+            bitmap_free_range(sfs->freemap, jnl->freed[i].blkno, jnl->freed[i].nblks);
+            sfs->super.unused_blocks += jnl->freed[i].nblks;
+            sfs_dirty_freemap(sfs, jnl->freed[i].blkno, jnl->freed[i].nblks);
+        }
+        jnl->nfreed = 0;
+    }
+    if ((ret = sfs_bcache_flush_nolock(sfs)) != 0) {
+        return ret;
+    }
+
+    // nothing blocks from here on to the descriptor, so the copies agree with each other
+    if (sfs->super_dirty) {
+        void *data = bitmap_getdata(sfs->freemap, NULL);
+        for (i = 0; i < nfm; i ++) {
+            if (sfs->freemap_dirty[i]) {
+                memcpy(fsinfo_block(jnl, i + 1), data + i * SFS_BLKSIZE, SFS_BLKSIZE);
+                desc->blknos[nfsinfo ++] = SFS_BLKN_FREEMAP + i;
+            }
+        }
+        memset(fsinfo_block(jnl, 0), 0, SFS_BLKSIZE);
+        memcpy(fsinfo_block(jnl, 0), &(sfs->super), sizeof(sfs->super));
+        desc->blknos[nfsinfo ++] = SFS_BLKN_SUPER;
+    }
+    nblocks = nfsinfo;
+    for (i = 0; i < SFS_BCACHE_NBUF; i ++) {
+        if (bc->bufs[i].jdirty) {
+            desc->blknos[nblocks ++] = bc->bufs[i].blkno;
+        }
+    }
+    // a block copied by this transaction needn't be revoked, the copy is the last one
+    for (i = 0; frees && i < jnl->nrevoked; i ++) {
+        if (sfs_journal_find(desc->blknos, nblocks, jnl->revoked[i]) == nblocks) {
+            desc->blknos[nblocks + nrevoked ++] = jnl->revoked[i];
+        }
+    }
+    if (nblocks == 0 && nrevoked == 0) {
+        if (frees) {
+            jnl->nrevoked = 0;
+        }
+        return 0;
+    }
+    if (nfsinfo != 0) {
+        sfs->super_dirty = 0;
+        memset(sfs->freemap_dirty, 0, sizeof(bool) * nfm);
+    }
+
+    assert(jnl->pos + nblocks + 2 <= sfs->super.journal_blocks);
+    desc->magic = SFS_JOURNAL_DESC, desc->seq = jnl->seq;
+    desc->nblocks = nblocks, desc->nrevoked = nrevoked;
+    if ((ret = sfs_journal_rw(sfs, desc, jnl->pos, 1)) != 0) {
+        goto failed;
+    }
+    for (i = 0; i < nblocks; i ++) {
+        uint32_t blkno = desc->blknos[i];
+        void *data;
+        if (i < nfsinfo) {
+            data = fsinfo_block(jnl, (blkno == SFS_BLKN_SUPER) ? 0 : blkno - SFS_BLKN_FREEMAP + 1);
+        }
+        else {
+            struct sfs_buf *sbuf = sfs_bcache_find_nolock(sfs, blkno);
+            assert(sbuf != NULL && sbuf->jdirty);
+            data = sbuf->data;
+        }
+        if ((ret = sfs_journal_rw(sfs, data, jnl->pos + 1 + i, 1)) != 0) {
+            goto failed;
+        }
+    }
+
+    // the transaction is committed once this block is written
+    struct sfs_journal_block *commit = sfs->sfs_buffer;
+    memset(commit, 0, SFS_BLKSIZE);
+    commit->magic = SFS_JOURNAL_COMMIT, commit->seq = jnl->seq, commit->nblocks = nblocks;
+    if ((ret = sfs_journal_rw(sfs, commit, jnl->pos + 1 + nblocks, 1)) != 0) {
+        goto failed;
+    }
+    for (i = nfsinfo; i < nblocks; i ++) {
+        uint32_t blkno = desc->blknos[i];
+        sfs_bcache_find_nolock(sfs, blkno)->jdirty = 0;
+        if (sfs_journal_find(jnl->jblocks, jnl->njblocks, blkno) == jnl->njblocks) {
+            jnl->jblocks[jnl->njblocks ++] = blkno;
+        }
+    }
+    jnl->pos += nblocks + 2, jnl->seq ++;
+    if (frees) {
+        jnl->nrevoked = 0;
+    }
+    jnl->commits ++, jnl->blocks += nblocks;
+
+    if (jnl->pos + sfs_journal_maxtrans(&(sfs->super)) + 2 > sfs->super.journal_blocks) {
+        return sfs_journal_checkpoint_nolock(sfs);
+    }
+    return 0;
+
+failed:
+    // the superblock and freemap blocks are copied again by the next commit
+    for (i = 0; i < nfsinfo; i ++) {
+        if (desc->blknos[i] != SFS_BLKN_SUPER) {
+            sfs->freemap_dirty[desc->blknos[i] - SFS_BLKN_FREEMAP] = 1;
+        }
+        sfs->super_dirty = 1;
+    }
+    return ret;
+}
+
+/*
+ * sfs_journal_checkpoint_nolock - write all dirty blocks and the copy of superblock and freemap in
+ *                                 place, then empty the journal. no block is waiting for journal,
+ *                                 it's called right after a commit.
+ */
+int
+sfs_journal_checkpoint_nolock(struct sfs_fs *sfs) {
+    struct sfs_journal *jnl = &(sfs->journal);
+    int ret;
+    if (jnl->pos == 1) {
+        return 0;
+    }
+    if ((ret = sfs_bcache_flush_nolock(sfs)) != 0) {
+        return ret;
+    }
+    if ((ret = sfs_journal_rw_fsinfo(sfs, 1)) != 0) {
+        return ret;
+    }
+    if ((ret = sfs_journal_write_header(sfs, jnl->seq)) != 0) {
+        return ret;
+    }
+    jnl->pos = 1, jnl->njblocks = jnl->nrevoked = 0;
+    jnl->checkpoints ++;
+    return 0;
+}
+
+/*
+ * sfs_journal_sync - commit all metadata, for fsync. a caller which waits here while another one
+ *                    commits returns at once when a commit started after its changes succeeds
+ *                    (group commit).
+ */
+int
+sfs_journal_sync(struct sfs_fs *sfs) {
+    struct sfs_journal *jnl = &(sfs->journal);
+    uint32_t sync_seq = jnl->sync_seq;
+    int ret = 0;
+    lock_sfs_io(sfs);
+    {
+        if (jnl->synced_seq <= sync_seq) {
+            sync_seq = ++ jnl->sync_seq;
+            if ((ret = sfs_journal_commit_nolock(sfs)) == 0) {
+                jnl->synced_seq = sync_seq;
+            }
+        }
+    }
+    unlock_sfs_io(sfs);
+    return ret;
+}
@@ -13,6 +13,16 @@ lock_sfs_fs(struct sfs_fs *sfs) {
     down(&(sfs->fs_sem));
 }
 
+/*
+ * try_lock_sfs_fs - lock fs if nobody holds it, return true if locked
+ *
+ * called by: sfs_icache_shrinker
+ */
+bool
+try_lock_sfs_fs(struct sfs_fs *sfs) {
+    return try_down(&(sfs->fs_sem));
+}
+
 /*
  * lock_sfs_io - lock the process of SFS File Rd/Wr Disk Block
  *
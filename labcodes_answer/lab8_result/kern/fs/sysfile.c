@@ -10,6 +10,7 @@
 #include <stat.h>
 #include <dirent.h>
 #include <unistd.h>
+#include <uio.h>
 #include <error.h>
 #include <assert.h>
 
@@ -56,102 +57,204 @@ sysfile_close(int fd) {
     return file_close(fd);
 }
 
-/* sysfile_read - read file */
-int
-sysfile_read(int fd, void *base, size_t len) {
+/*
+ * sysfile_direct - true if file io may move data between the file and user segments (iov, iovcnt)
+ *                  directly: they're valid, and mm isn't shared, so nothing unmaps them while the
+ *                  io blocks. pages are faulted in (or copied on write) as they're touched.
+ */
+static bool
+sysfile_direct(struct iovec *iov, int iovcnt, bool write) {
     struct mm_struct *mm = current->mm;
-    if (len == 0) {
-        return 0;
+    bool ret;
+    int i;
+    lock_mm(mm);
+    {
+        ret = (mm == NULL || mm_count(mm) == 1);
+        for (i = 0; ret && i < iovcnt; i ++) {
+            ret = (iov[i].iov_len == 0
+                    || user_mem_check(mm, (uintptr_t)iov[i].iov_base, iov[i].iov_len, write));
+        }
     }
-    if (!file_testfd(fd, 1, 0)) {
+    unlock_mm(mm);
+    return ret;
+}
+
+/*
+ * sysfile_io - read/write file into/from user segments (iov, iovcnt), at pos or (if pos < 0)
+ *              at the file position. (!write) means read, which writes to user memory.
+ */
+static int
+sysfile_io(int fd, struct iovec *iov, int iovcnt, off_t pos, bool write) {
+    struct mm_struct *mm = current->mm;
+    if (!file_testfd(fd, !write, write)) {
         return -E_INVAL;
     }
+
+    int i, ret = 0;
+    size_t copied = 0, alen;
+    if (sysfile_direct(iov, iovcnt, !write)) {
+        struct iobuf __iob, *iob = iobuf_init_iov(&__iob, iov, iovcnt, 0);
+        ret = file_io(fd, iob, pos, write, &copied);
+        goto out_direct;
+    }
+
     void *buffer;
     if ((buffer = kmalloc(IOBUF_SIZE)) == NULL) {
         return -E_NO_MEM;
     }
 
-    int ret = 0;
-    size_t copied = 0, alen;
-    while (len != 0) {
-        if ((alen = IOBUF_SIZE) > len) {
-            alen = len;
-        }
-        ret = file_read(fd, buffer, alen, &alen);
-        if (alen != 0) {
-            lock_mm(mm);
-            {
-                if (copy_to_user(mm, base, buffer, alen)) {
-                    assert(len >= alen);
-                    base += alen, len -= alen, copied += alen;
+    for (i = 0; i < iovcnt; i ++) {
+        void *base = iov[i].iov_base;
+        size_t len = iov[i].iov_len;
+        while (len != 0) {
+            if ((alen = IOBUF_SIZE) > len) {
+                alen = len;
+            }
+            if (write) {
+                lock_mm(mm);
+                {
+                    if (!copy_from_user(mm, buffer, base, alen, 0)) {
+                        ret = -E_INVAL;
+                    }
                 }
-                else if (ret == 0) {
-                    ret = -E_INVAL;
+                unlock_mm(mm);
+                if (ret != 0) {
+                    goto out;
                 }
             }
-            unlock_mm(mm);
-        }
-        if (ret != 0 || alen == 0) {
-            goto out;
+            struct iobuf __iob, *iob = iobuf_init(&__iob, buffer, alen, 0);
+            ret = file_io(fd, iob, pos, write, &alen);
+            if (!write && alen != 0) {
+                lock_mm(mm);
+                {
+                    if (!copy_to_user(mm, base, buffer, alen)) {
+                        alen = 0;
+                        if (ret == 0) {
+                            ret = -E_INVAL;
+                        }
+                    }
+                }
+                unlock_mm(mm);
+            }
+            if (alen != 0) {
+                assert(len >= alen);
+                base += alen, len -= alen, copied += alen;
+                if (pos >= 0) {
+                    pos += alen;
+                }
+            }
+            if (ret != 0 || alen == 0) {
+                goto out;
+            }
         }
     }
 
 out:
     kfree(buffer);
+out_direct:
     if (copied != 0) {
         return copied;
     }
     return ret;
 }
 
-/* sysfile_write - write file */
-int
-sysfile_write(int fd, void *base, size_t len) {
+/*
+ * sysfile_iov - read/write file into/from the segments user passes in (__iov, iovcnt)
+ */
+static int
+sysfile_iov(int fd, struct iovec *__iov, int iovcnt, bool write) {
     struct mm_struct *mm = current->mm;
-    if (len == 0) {
-        return 0;
-    }
-    if (!file_testfd(fd, 0, 1)) {
-        return -E_INVAL;
+    if (iovcnt <= 0 || iovcnt > UIO_MAXIOV) {
+        return (iovcnt == 0) ? 0 : -E_INVAL;
     }
-    void *buffer;
-    if ((buffer = kmalloc(IOBUF_SIZE)) == NULL) {
+    struct iovec *iov;
+    if ((iov = kmalloc(sizeof(struct iovec) * iovcnt)) == NULL) {
         return -E_NO_MEM;
     }
 
-    int ret = 0;
-    size_t copied = 0, alen;
-    while (len != 0) {
-        if ((alen = IOBUF_SIZE) > len) {
-            alen = len;
-        }
-        lock_mm(mm);
-        {
-            if (!copy_from_user(mm, buffer, base, alen, 0)) {
-                ret = -E_INVAL;
-            }
-        }
-        unlock_mm(mm);
-        if (ret == 0) {
-            ret = file_write(fd, buffer, alen, &alen);
-            if (alen != 0) {
-                assert(len >= alen);
-                base += alen, len -= alen, copied += alen;
-            }
+    int i, ret = -E_INVAL;
+    lock_mm(mm);
+    {
+        if (!copy_from_user(mm, iov, __iov, sizeof(struct iovec) * iovcnt, 0)) {
+            unlock_mm(mm);
+            goto out;
         }
-        if (ret != 0 || alen == 0) {
+    }
+    unlock_mm(mm);
+
+    // the total length is returned as int
+    size_t len = 0;
+    for (i = 0; i < iovcnt; i ++) {
+        if (iov[i].iov_len > 0x7FFFFFFF - len) {
             goto out;
         }
+        len += iov[i].iov_len;
     }
+    ret = (len == 0) ? 0 : sysfile_io(fd, iov, iovcnt, -1, write);
 
 out:
-    kfree(buffer);
-    if (copied != 0) {
-        return copied;
-    }
+    kfree(iov);
     return ret;
 }
 
+/* sysfile_read - read file */
+int
+sysfile_read(int fd, void *base, size_t len) {
+    struct iovec iov = {base, len};
+    if (len == 0) {
+        return 0;
+    }
+    return sysfile_io(fd, &iov, 1, -1, 0);
+}
+
+/* sysfile_write - write file */
+int
+sysfile_write(int fd, void *base, size_t len) {
+    struct iovec iov = {base, len};
+    if (len == 0) {
+        return 0;
+    }
+    return sysfile_io(fd, &iov, 1, -1, 1);
+}
+
+/* sysfile_pread - read file at pos, the file position isn't changed */
+int
+sysfile_pread(int fd, void *base, size_t len, off_t pos) {
+    struct iovec iov = {base, len};
+    if (pos < 0) {
+        return -E_INVAL;
+    }
+    if (len == 0) {
+        return 0;
+    }
+    return sysfile_io(fd, &iov, 1, pos, 0);
+}
+
+/* sysfile_pwrite - write file at pos, the file position isn't changed */
+int
+sysfile_pwrite(int fd, void *base, size_t len, off_t pos) {
+    struct iovec iov = {base, len};
+    if (pos < 0) {
+        return -E_INVAL;
+    }
+    if (len == 0) {
+        return 0;
+    }
+    return sysfile_io(fd, &iov, 1, pos, 1);
+}
+
+/* sysfile_readv - read file into several buffers */
+int
+sysfile_readv(int fd, struct iovec *iov, int iovcnt) {
+    return sysfile_iov(fd, iov, iovcnt, 0);
+}
+
+/* sysfile_writev - write file from several buffers */
+int
+sysfile_writev(int fd, struct iovec *iov, int iovcnt) {
+    return sysfile_iov(fd, iov, iovcnt, 1);
+}
+
 /* sysfile_seek - seek file */
 int
 sysfile_seek(int fd, off_t pos, int whence) {
@@ -184,6 +287,12 @@ sysfile_fsync(int fd) {
     return file_fsync(fd);
 }
 
+/* sysfile_fallocate - allocate disk space for file */
+int
+sysfile_fallocate(int fd, off_t pos, off_t len) {
+    return file_fallocate(fd, pos, len);
+}
+
 /* sysfile_chdir - change dir */
 int
 sysfile_chdir(const char *__path) {
@@ -5,14 +5,20 @@
 
 struct stat;
 struct dirent;
+struct iovec;
 
 int sysfile_open(const char *path, uint32_t open_flags);        // Open or create a file. FLAGS/MODE per the syscall.
 int sysfile_close(int fd);                                      // Close a vnode opened  
 int sysfile_read(int fd, void *base, size_t len);               // Read file
 int sysfile_write(int fd, void *base, size_t len);              // Write file
+int sysfile_pread(int fd, void *base, size_t len, off_t pos);   // Read file at pos
+int sysfile_pwrite(int fd, void *base, size_t len, off_t pos);  // Write file at pos
+int sysfile_readv(int fd, struct iovec *iov, int iovcnt);       // Read file into several buffers
+int sysfile_writev(int fd, struct iovec *iov, int iovcnt);      // Write file from several buffers
 int sysfile_seek(int fd, off_t pos, int whence);                // Seek file  
 int sysfile_fstat(int fd, struct stat *stat);                   // Stat file 
 int sysfile_fsync(int fd);                                      // Sync file
+int sysfile_fallocate(int fd, off_t pos, off_t len);            // Allocate disk space for file
 int sysfile_chdir(const char *path);                            // change DIR  
 int sysfile_mkdir(const char *path);                            // create DIR
 int sysfile_link(const char *path1, const char *path2);         // set a path1's link as path2
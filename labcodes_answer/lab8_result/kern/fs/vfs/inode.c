@@ -8,13 +8,26 @@
 #include <assert.h>
 #include <kmalloc.h>
 
+static kmem_cache_t *inode_cachep;
+
+/* *
+ * inode_cache_init - create the object cache for inode structures
+ * invoked by vfs_init
+ * */
+void
+inode_cache_init(void) {
+    if ((inode_cachep = kmem_cache_create("inode", sizeof(struct inode), NULL)) == NULL) {
+        panic("cannot create inode cache.\n");
+    }
+}
+
 /* *
  * __alloc_inode - alloc a inode structure and initialize in_type
  * */
 struct inode *
 __alloc_inode(int type) {
     struct inode *node;
-    if ((node = kmalloc(sizeof(struct inode))) != NULL) {
+    if ((node = kmem_cache_alloc(inode_cachep)) != NULL) {
         node->in_type = type;
     }
     return node;
@@ -28,7 +41,7 @@ void
 inode_init(struct inode *node, const struct inode_ops *ops, struct fs *fs) {
     node->ref_count = 0;
     node->open_count = 0;
-    node->in_ops = ops, node->in_fs = fs;
+    node->in_ops = ops, node->in_fs = fs, node->in_ino = 0;
     vop_ref_inc(node);
 }
 
@@ -40,7 +53,7 @@ void
 inode_kill(struct inode *node) {
     assert(inode_ref_count(node) == 0);
     assert(inode_open_count(node) == 0);
-    kfree(node);
+    kmem_cache_free(inode_cachep, node);
 }
 
 /* *
@@ -20,7 +20,8 @@ struct iobuf;
 /*
  * Abstract low-level file.
  *
- * Note: in_info is Filesystem-specific data, in_type is the inode type
+ * Note: in_info is Filesystem-specific data, in_type is the inode type,
+ * in_ino is the inode number in in_fs (0 if in_fs doesn't number inodes)
  *
  * open_count is managed using VOP_INCOPEN and VOP_DECOPEN by
  * vfs_open() and vfs_close(). Code above the VFS layer should not
@@ -38,6 +39,7 @@ struct inode {
     int ref_count;
     int open_count;
     struct fs *in_fs;
+    uint32_t in_ino;
     const struct inode_ops *in_ops;
 };
 
@@ -57,6 +59,7 @@ struct inode {
 #define info2node(info, type)                                       \
     to_struct((info), struct inode, in_info.__##type##_info)
 
+void inode_cache_init(void);
 struct inode *__alloc_inode(int type);
 
 #define alloc_inode(type)                                           __alloc_inode(__in_type(type))
@@ -146,6 +149,10 @@ void inode_kill(struct inode *node);
  *    vop_truncate    - Forcibly set size of file to the length passed
  *                      in, discarding any excess blocks.
  *
+ *    vop_fallocate   - Allocate the blocks for the range of file from POS
+ *                      of LEN bytes ahead of writing it, extending the
+ *                      file if the range goes past its end.
+ *
  *    vop_namefile    - Compute pathname relative to filesystem root
  *                      of the file and copy to the specified io buffer. 
  *                      Need not work on objects that are not
@@ -180,6 +187,7 @@ struct inode_ops {
     int (*vop_gettype)(struct inode *node, uint32_t *type_store);
     int (*vop_tryseek)(struct inode *node, off_t pos);
     int (*vop_truncate)(struct inode *node, off_t len);
+    int (*vop_fallocate)(struct inode *node, off_t pos, off_t len);
     int (*vop_create)(struct inode *node, const char *name, bool excl, struct inode **node_store);
     int (*vop_lookup)(struct inode *node, char *path, struct inode **node_store);
     int (*vop_ioctl)(struct inode *node, int op, void *data);
@@ -211,6 +219,7 @@ void inode_check(struct inode *node, const char *opstr);
 #define vop_gettype(node, type_store)                               (__vop_op(node, gettype)(node, type_store))
 #define vop_tryseek(node, pos)                                      (__vop_op(node, tryseek)(node, pos))
 #define vop_truncate(node, len)                                     (__vop_op(node, truncate)(node, len))
+#define vop_fallocate(node, pos, len)                               (__vop_op(node, fallocate)(node, pos, len))
 #define vop_create(node, name, excl, node_store)                    (__vop_op(node, create)(node, name, excl, node_store))
 #define vop_lookup(node, path, node_store)                          (__vop_op(node, lookup)(node, path, node_store))
 
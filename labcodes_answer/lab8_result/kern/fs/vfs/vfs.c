@@ -18,6 +18,7 @@ __alloc_fs(int type) {
     struct fs *fs;
     if ((fs = kmalloc(sizeof(struct fs))) != NULL) {
         fs->fs_type = type;
+        fs->fs_get_inode = NULL;
     }
     return fs;
 }
@@ -26,6 +27,8 @@ __alloc_fs(int type) {
 void
 vfs_init(void) {
     sem_init(&bootfs_sem, 1);
+    inode_cache_init();
+    vfs_dcache_init();
     vfs_devlist_init();
 }
 
@@ -21,10 +21,13 @@ struct iobuf;   // kernel or userspace I/O buffer (iobuf.h)
  *      fs_get_root   - Return root inode of filesystem.
  *      fs_unmount    - Attempt unmount of filesystem.
  *      fs_cleanup    - Cleanup of filesystem.???
+ *      fs_get_inode  - Return the inode numbered ino (in_ino), NULL if the fs
+ *                      doesn't number its inodes.
  *      
  *
  * fs_get_root should increment the refcount of the inode returned.
- * It should not ever return NULL.
+ * It should not ever return NULL. So should fs_get_inode, which fails if
+ * ino isn't an inode in use.
  *
  * If fs_unmount returns an error, the filesystem stays mounted, and
  * consequently the struct fs instance should remain valid. On success,
@@ -43,6 +46,7 @@ struct fs {
     struct inode *(*fs_get_root)(struct fs *fs);   // Return root inode of filesystem.
     int (*fs_unmount)(struct fs *fs);              // Attempt unmount of filesystem.
     void (*fs_cleanup)(struct fs *fs);             // Cleanup of filesystem.???
+    int (*fs_get_inode)(struct fs *fs, uint32_t ino, struct inode **node_store);   // Return inode numbered ino.
 };
 
 #define __fs_type(type)                                             fs_type_##type##_info
@@ -69,6 +73,7 @@ struct fs *__alloc_fs(int type);
 #define fsop_get_root(fs)                   ((fs)->fs_get_root(fs))
 #define fsop_unmount(fs)                    ((fs)->fs_unmount(fs))
 #define fsop_cleanup(fs)                    ((fs)->fs_cleanup(fs))
+#define fsop_get_inode(fs, ino, node_store) ((fs)->fs_get_inode(fs, ino, node_store))
 
 /*
  * Virtual File System layer functions.
@@ -78,6 +83,7 @@ struct fs *__alloc_fs(int type);
  */
 void vfs_init(void);
 void vfs_cleanup(void);
+int vfs_sync(void);
 void vfs_devlist_init(void);
 
 /*
@@ -138,6 +144,27 @@ int vfs_getcwd(struct iobuf *iob);
 int vfs_lookup(char *path, struct inode **node_store);
 int vfs_lookup_parent(char *path, struct inode **node_store, char **endp);
 
+/*
+ * VFS name cache (vfsdcache.c), caches the results of vop_lookup, including
+ * names which don't exist. VFS_DCACHE_NENTRY can be set by DEFS.
+ *
+ *    vfs_dcache_lookup     - look up (dir, name), true if it is cached.
+ *    vfs_dcache_add        - cache (dir, name) -> node, node is NULL if name doesn't exist.
+ *    vfs_dcache_invalidate - forget (dir, name), must be called when a name is
+ *                            created or removed in dir.
+ *    vfs_dcache_purge      - drop the dentries of fs (all if fs is NULL).
+ */
+#ifndef VFS_DCACHE_NENTRY
+#define VFS_DCACHE_NENTRY           128
+#endif
+#define VFS_DCACHE_NAMELEN          31
+
+void vfs_dcache_init(void);
+bool vfs_dcache_lookup(struct inode *dir, const char *name, struct inode **node_store);
+void vfs_dcache_add(struct inode *dir, const char *name, struct inode *node);
+void vfs_dcache_invalidate(struct inode *dir, const char *name);
+void vfs_dcache_purge(struct fs *fs);
+
 /*
  * Misc
  *
@@ -0,0 +1,218 @@
+#include <defs.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <list.h>
+#include <sem.h>
+#include <vfs.h>
+#include <inode.h>
+#include <kmalloc.h>
+#include <assert.h>
+
+/*
+ * Name cache of vfs. A dentry maps (dir, name) to the inode number vop_lookup found,
+ * or to 0 if the name doesn't exist (negative entry), so a lookup of a hot path
+ * doesn't search the dir again. Dirs and inodes are named by (fs, in_ino), a dentry
+ * holds no reference, and the inode of a hit is got by fsop_get_inode, so unused
+ * inodes can still be reclaimed and freed by the fs. Only dirs of a fs which has
+ * fs_get_inode and numbers its inodes are cached. VFS_DCACHE_NENTRY dentries are
+ * allocated by vfs_init, and the least recently used one is reused when the cache
+ * is full. Only names of one path component, up to VFS_DCACHE_NAMELEN chars, are
+ * cached, so a name changed in a dir is never cached under another dir.
+ *
+ * Whoever changes the names in a dir must call vfs_dcache_invalidate, and all
+ * dentries of a fs are dropped by vfs_dcache_purge before it is unmounted.
+ */
+
+struct dentry {
+    struct fs *fs;                      // fs of dir, NULL if the dentry is unused
+    uint32_t dir_ino;                   // inode number of dir
+    uint32_t ino;                       // inode number of name in dir, 0 if name doesn't exist
+    char name[VFS_DCACHE_NAMELEN + 1];  // the name
+    list_entry_t hash_link;             // entry for hash linked-list
+    list_entry_t lru_link;              // entry for lru linked-list, most recently used first
+};
+
+#define le2dentry(le, member)                       \
+    to_struct((le), struct dentry, member)
+
+#define DCACHE_HSHIFT                   6
+#define DCACHE_HSIZE                    (1 << DCACHE_HSHIFT)
+
+static struct dentry *dentries;
+static list_entry_t *dcache_hash_list;
+static list_entry_t dcache_lru_list;
+static semaphore_t dcache_sem;
+static uint32_t dcache_hits, dcache_misses;
+
+static void
+lock_dcache(void) {
+    down(&dcache_sem);
+}
+
+static void
+unlock_dcache(void) {
+    up(&dcache_sem);
+}
+
+// dcache_hashfn - hash of (dir, name)
+static uint32_t
+dcache_hashfn(struct inode *dir, const char *name) {
+    uint32_t hash = (uint32_t)(dir->in_fs) + dir->in_ino;
+    while (*name != '\0') {
+        hash = hash * 31 + (uint8_t)(*name ++);
+    }
+    return hash32(hash, DCACHE_HSHIFT);
+}
+
+// dcache_cacheable - true if the names in dir can be cached
+static bool
+dcache_cacheable(struct inode *dir, const char *name) {
+    return dir->in_fs != NULL && dir->in_fs->fs_get_inode != NULL && dir->in_ino != 0
+        && strlen(name) <= VFS_DCACHE_NAMELEN && strchr(name, '/') == NULL;
+}
+
+/*
+ * vfs_dcache_init - alloc dentries and hash list, called by vfs_init.
+ */
+void
+vfs_dcache_init(void) {
+    if ((dentries = kmalloc(sizeof(struct dentry) * VFS_DCACHE_NENTRY)) == NULL) {
+        panic("cannot alloc dentries.\n");
+    }
+    if ((dcache_hash_list = kmalloc(sizeof(list_entry_t) * DCACHE_HSIZE)) == NULL) {
+        panic("cannot alloc dcache hash list.\n");
+    }
+    int i;
+    for (i = 0; i < DCACHE_HSIZE; i ++) {
+        list_init(dcache_hash_list + i);
+    }
+    list_init(&dcache_lru_list);
+    for (i = 0; i < VFS_DCACHE_NENTRY; i ++) {
+        struct dentry *dentry = dentries + i;
+        dentry->fs = NULL;
+        list_init(&(dentry->hash_link));
+        list_add_before(&dcache_lru_list, &(dentry->lru_link));
+    }
+    sem_init(&dcache_sem, 1);
+}
+
+// dcache_find_nolock - find the dentry of (dir, name), NULL if it isn't cached
+static struct dentry *
+dcache_find_nolock(struct inode *dir, const char *name) {
+    list_entry_t *list = dcache_hash_list + dcache_hashfn(dir, name), *le = list;
+    while ((le = list_next(le)) != list) {
+        struct dentry *dentry = le2dentry(le, hash_link);
+        if (dentry->fs == dir->in_fs && dentry->dir_ino == dir->in_ino && strcmp(dentry->name, name) == 0) {
+            return dentry;
+        }
+    }
+    return NULL;
+}
+
+// dcache_drop_nolock - make dentry unused and put it at the tail of lru list
+static void
+dcache_drop_nolock(struct dentry *dentry) {
+    dentry->fs = NULL;
+    list_del_init(&(dentry->hash_link));
+    list_del(&(dentry->lru_link));
+    list_add_before(&dcache_lru_list, &(dentry->lru_link));
+}
+
+/*
+ * vfs_dcache_lookup - look up (dir, name) in the dcache.
+ * return true if it's cached, then *node_store is the inode (with a reference) or NULL
+ * if name doesn't exist. a dentry whose inode can't be got is dropped, and it's a miss.
+ */
+bool
+vfs_dcache_lookup(struct inode *dir, const char *name, struct inode **node_store) {
+    if (!dcache_cacheable(dir, name)) {
+        return 0;
+    }
+    struct dentry *dentry;
+    uint32_t ino = 0;
+    lock_dcache();
+    if ((dentry = dcache_find_nolock(dir, name)) != NULL) {
+        ino = dentry->ino;
+        list_del(&(dentry->lru_link));
+        list_add(&dcache_lru_list, &(dentry->lru_link));
+    }
+    unlock_dcache();
+
+    *node_store = NULL;
+    if (dentry != NULL && ino != 0 && fsop_get_inode(dir->in_fs, ino, node_store) != 0) {
+        vfs_dcache_invalidate(dir, name);
+        dentry = NULL;
+    }
+    lock_dcache();
+    if (dentry != NULL) {
+        dcache_hits ++;
+    }
+    else {
+        dcache_misses ++;
+    }
+    unlock_dcache();
+    return dentry != NULL;
+}
+
+/*
+ * vfs_dcache_add - cache the result of looking up name in dir, node is NULL if name
+ *                  doesn't exist.
+ */
+void
+vfs_dcache_add(struct inode *dir, const char *name, struct inode *node) {
+    if (!dcache_cacheable(dir, name) || (node != NULL && (node->in_fs != dir->in_fs || node->in_ino == 0))) {
+        return;
+    }
+    struct dentry *dentry;
+    lock_dcache();
+    if ((dentry = dcache_find_nolock(dir, name)) == NULL) {
+        dentry = le2dentry(list_prev(&dcache_lru_list), lru_link);
+        if (dentry->fs != NULL) {
+            dcache_drop_nolock(dentry);
+        }
+        dentry->fs = dir->in_fs, dentry->dir_ino = dir->in_ino;
+        dentry->ino = (node != NULL) ? node->in_ino : 0;
+        strcpy(dentry->name, name);
+        list_add(dcache_hash_list + dcache_hashfn(dir, name), &(dentry->hash_link));
+        list_del(&(dentry->lru_link));
+        list_add(&dcache_lru_list, &(dentry->lru_link));
+    }
+    unlock_dcache();
+}
+
+/*
+ * vfs_dcache_invalidate - forget (dir, name), called when name is created or removed in dir.
+ */
+void
+vfs_dcache_invalidate(struct inode *dir, const char *name) {
+    if (!dcache_cacheable(dir, name)) {
+        return;
+    }
+    struct dentry *dentry;
+    lock_dcache();
+    if ((dentry = dcache_find_nolock(dir, name)) != NULL) {
+        dcache_drop_nolock(dentry);
+    }
+    unlock_dcache();
+}
+
+/*
+ * vfs_dcache_purge - drop all dentries of fs (all dentries if fs is NULL), called before
+ *                    fs is unmounted, so a new fs at the same address doesn't see them.
+ */
+void
+vfs_dcache_purge(struct fs *fs) {
+    int i;
+    lock_dcache();
+    for (i = 0; i < VFS_DCACHE_NENTRY; i ++) {
+        struct dentry *dentry = dentries + i;
+        if (dentry->fs != NULL && (fs == NULL || dentry->fs == fs)) {
+            dcache_drop_nolock(dentry);
+        }
+    }
+    unlock_dcache();
+    if (fs == NULL) {
+        cprintf("vfs: dcache: %u hits, %u misses\n", dcache_hits, dcache_misses);
+    }
+}
@@ -45,6 +45,7 @@ vfs_devlist_init(void) {
 // vfs_cleanup - finally clean (or sync) fs
 void
 vfs_cleanup(void) {
+    vfs_dcache_purge(NULL);
     if (!list_empty(&vdev_list)) {
         lock_vdev_list();
         {
@@ -60,6 +61,32 @@ vfs_cleanup(void) {
     }
 }
 
+/*
+ * vfs_sync - flush all dirty buffers of all mounted fs to disk.
+ */
+int
+vfs_sync(void) {
+    int ret = 0;
+    if (!list_empty(&vdev_list)) {
+        lock_vdev_list();
+        {
+            list_entry_t *list = &vdev_list, *le = list;
+            while ((le = list_next(le)) != list) {
+                vfs_dev_t *vdev = le2vdev(le, vdev_link);
+                if (vdev->fs != NULL) {
+                    int err;
+                    if ((err = fsop_sync(vdev->fs)) != 0) {
+                        cprintf("vfs: warning: sync failed for %s: %e.\n", vdev->devname, err);
+                        ret = err;
+                    }
+                }
+            }
+        }
+        unlock_vdev_list();
+    }
+    return ret;
+}
+
 /*
  * vfs_get_root - Given a device name (stdin, stdout, etc.), hand
  *                back an appropriate inode.
@@ -263,6 +290,7 @@ vfs_unmount(const char *devname) {
     }
     assert(vdev->devname != NULL && vdev->mountable);
 
+    vfs_dcache_purge(vdev->fs);
     if ((ret = fsop_sync(vdev->fs)) != 0) {
         goto out;
     }
@@ -289,6 +317,7 @@ vfs_unmount_all(void) {
                 vfs_dev_t *vdev = le2vdev(le, vdev_link);
                 if (vdev->mountable && vdev->fs != NULL) {
                     int ret;
+                    vfs_dcache_purge(vdev->fs);
                     if ((ret = fsop_sync(vdev->fs)) != 0) {
                         cprintf("vfs: warning: sync failed for %s: %e.\n", vdev->devname, ret);
                         continue ;
@@ -42,6 +42,7 @@ vfs_open(char *path, uint32_t open_flags, struct inode **node_store) {
                 return ret;
             }
             ret = vop_create(dir, name, excl, &node);
+            vfs_dcache_invalidate(dir, name);
         } else return ret;
     } else if (excl && create) {
         return -E_EXISTS;
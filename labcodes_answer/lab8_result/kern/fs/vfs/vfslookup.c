@@ -76,7 +76,15 @@ vfs_lookup(char *path, struct inode **node_store) {
         return ret;
     }
     if (*path != '\0') {
-        ret = vop_lookup(node, path, node_store);
+        if (vfs_dcache_lookup(node, path, node_store)) {
+            ret = (*node_store != NULL) ? 0 : -E_NOENT;
+        }
+        else if ((ret = vop_lookup(node, path, node_store)) == 0) {
+            vfs_dcache_add(node, path, *node_store);
+        }
+        else if (ret == -E_NOENT) {
+            vfs_dcache_add(node, path, NULL);
+        }
         vop_ref_dec(node);
         return ret;
     }
@@ -0,0 +1,283 @@
+#include <pmm.h>
+#include <list.h>
+#include <string.h>
+#include <buddy_pmm.h>
+
+/*  In the Buddy System, free memory is kept in blocks of 2^order pages, and
+ * there is one free list per order. A block of order k at index i (relative
+ * to the beginning of its zone) always has its "buddy" at index i ^ (1 << k).
+ * To allocate n pages, we take a block from the smallest non-empty list whose
+ * order is >= ceil(log2(n)), and split it in halves until it fits. When a
+ * block is freed, we merge it with its buddy as long as the buddy is also a
+ * free block of the same order. Both operations touch at most MAX_ORDER
+ * lists, so alloc/free are O(log n) instead of O(#free blocks) as in FFMA.
+ *  Please refer to related_info/lab2/buddy_system.md for the idea, the code
+ * there keeps a complete binary tree, but here we keep per-order free lists
+ * linked through `page_link`, so no extra memory is needed.
+ *
+ * Details of Buddy System
+ *  - `p->property` of the first page of a free block stores the order of the
+ * block, and the `PG_property` bit of that page is set.
+ *  - `p->zone_num` of every page stores the No. of the zone (a continuous
+ * range of pages given to `buddy_init_memmap`) the page belongs to. The buddy
+ * index is computed inside the zone, so zones need not be aligned.
+ *  - `buddy_alloc_pages(n)` and `buddy_free_pages(base, n)` work for any n,
+ * not only powers of 2: the unused tail of an allocated block is given back
+ * at once, and a freed range is cut into the largest aligned blocks.
+ */
+
+static free_area_t free_area[MAX_ORDER];
+static size_t nr_free;
+
+#define free_list(order) (free_area[(order)].free_list)
+#define nr_block(order) (free_area[(order)].nr_free)
+
+struct zone {
+    struct Page *mem_base;          // the first page of this zone
+    size_t n;                       // # of pages in this zone
+};
+
+static struct zone zones[MAX_ZONE_NUM];
+static int nr_zone;
+
+static void
+buddy_init(void) {
+    int i;
+    for (i = 0; i < MAX_ORDER; i ++) {
+        list_init(&free_list(i));
+        nr_block(i) = 0;
+    }
+    nr_free = 0;
+    nr_zone = 0;
+}
+
+//get_order - the smallest order which satisfies 2^order >= n
+static inline size_t
+get_order(size_t n) {
+    size_t order = 0;
+    while ((1 << order) < n) {
+        order ++;
+    }
+    return order;
+}
+
+//buddy_free_block - put the block of 2^order pages at index idx of zone z
+//                 - back to free lists, merge it with its buddies if we can
+static void
+buddy_free_block(struct zone *z, size_t idx, size_t order) {
+    while (order < MAX_ORDER - 1) {
+        size_t buddy_idx = idx ^ (1 << order);
+        if (buddy_idx + (1 << order) > z->n) {
+            break;
+        }
+        struct Page *buddy = z->mem_base + buddy_idx;
+        if (!PageProperty(buddy) || buddy->property != order) {
+            break;
+        }
+        list_del(&(buddy->page_link));
+        ClearPageProperty(buddy);
+        nr_block(order) --;
+        idx &= buddy_idx;
+        order ++;
+    }
+    struct Page *page = z->mem_base + idx;
+    page->property = order;
+    SetPageProperty(page);
+    list_add(&free_list(order), &(page->page_link));
+    nr_block(order) ++;
+}
+
+//buddy_free_range - cut [idx, idx + n) of zone z into the largest aligned blocks, and free them
+static void
+buddy_free_range(struct zone *z, size_t idx, size_t n) {
+    while (n > 0) {
+        size_t order = 0;
+        while (order < MAX_ORDER - 1 && (idx & (1 << order)) == 0 && (2 << order) <= n) {
+            order ++;
+        }
+        buddy_free_block(z, idx, order);
+        idx += (1 << order), n -= (1 << order);
+    }
+}
+
+static void
+buddy_init_memmap(struct Page *base, size_t n) {
+    assert(n > 0);
+    assert(nr_zone < MAX_ZONE_NUM);
+    struct zone *z = zones + nr_zone;
+    z->mem_base = base, z->n = n;
+    struct Page *p = base;
+    for (; p != base + n; p ++) {
+        assert(PageReserved(p));
+        p->flags = p->property = 0;
+        p->zone_num = nr_zone;
+        set_page_ref(p, 0);
+    }
+    nr_zone ++;
+    buddy_free_range(z, 0, n);
+    nr_free += n;
+}
+
+static struct Page *
+buddy_alloc_pages(size_t n) {
+    assert(n > 0);
+    if (n > nr_free) {
+        return NULL;
+    }
+    size_t order = get_order(n), k = order;
+    while (k < MAX_ORDER && list_empty(&free_list(k))) {
+        k ++;
+    }
+    if (k >= MAX_ORDER) {
+        return NULL;
+    }
+    struct Page *page = le2page(list_next(&free_list(k)), page_link);
+    list_del(&(page->page_link));
+    ClearPageProperty(page);
+    nr_block(k) --;
+
+    struct zone *z = zones + page->zone_num;
+    // split the block, the higher half goes back to the free list of lower order
+    while (k > order) {
+        k --;
+        struct Page *buddy = page + (1 << k);
+        buddy->property = k;
+        SetPageProperty(buddy);
+        list_add(&free_list(k), &(buddy->page_link));
+        nr_block(k) ++;
+    }
+    // give back the tail if n is not a power of 2
+    if (n < (1 << order)) {
+        buddy_free_range(z, page - z->mem_base + n, (1 << order) - n);
+    }
+    nr_free -= n;
+    return page;
+}
+
+static void
+buddy_free_pages(struct Page *base, size_t n) {
+    assert(n > 0);
+    struct Page *p = base;
+    for (; p != base + n; p ++) {
+        assert(!PageReserved(p) && !PageProperty(p));
+        p->flags = 0;
+        set_page_ref(p, 0);
+    }
+    struct zone *z = zones + base->zone_num;
+    assert(base >= z->mem_base && base + n <= z->mem_base + z->n);
+    buddy_free_range(z, base - z->mem_base, n);
+    nr_free += n;
+}
+
+static size_t
+buddy_nr_free_pages(void) {
+    return nr_free;
+}
+
+//buddy_count - count the free blocks and the free pages in all free lists
+static void
+buddy_count(int *count, int *total) {
+    int i;
+    *count = *total = 0;
+    for (i = 0; i < MAX_ORDER; i ++) {
+        int nr = 0;
+        list_entry_t *le = &free_list(i);
+        while ((le = list_next(le)) != &free_list(i)) {
+            struct Page *p = le2page(le, page_link);
+            assert(PageProperty(p) && p->property == i);
+            nr ++;
+        }
+        assert(nr == nr_block(i));
+        (*count) += nr, (*total) += (nr << i);
+    }
+}
+
+// below code is used to check the buddy system allocation algorithm.
+// NOTICE: all pages used here come from one order-4 block `p0`, so the buddies
+// touched while the free lists are emptied never belong to the stored lists.
+static void
+buddy_check(void) {
+    int count, total, count2, total2;
+    buddy_count(&count, &total);
+    assert(total == nr_free_pages());
+
+    struct Page *p0 = alloc_pages(16), *p1, *p2, *p3;
+    assert(p0 != NULL);
+    assert(!PageProperty(p0));
+    assert(((p0 - zones[p0->zone_num].mem_base) & 15) == 0);
+
+    free_area_t free_area_store[MAX_ORDER];
+    memcpy(free_area_store, free_area, sizeof(free_area));
+    int i;
+    for (i = 0; i < MAX_ORDER; i ++) {
+        list_init(&free_list(i));
+        nr_block(i) = 0;
+    }
+    assert(alloc_page() == NULL);
+
+    unsigned int nr_free_store = nr_free;
+    nr_free = 0;
+
+    // merge: the 8 pages become one order-3 block
+    free_pages(p0 + 4, 4);
+    free_pages(p0, 3);
+    free_page(p0 + 3);
+    assert(nr_free == 8 && nr_block(3) == 1);
+    assert(PageProperty(p0) && p0->property == 3);
+    assert(!PageProperty(p0 + 4));
+    assert(alloc_pages(9) == NULL);
+
+    // split: 8 -> 4 + 2 + 1 + 1
+    assert((p1 = alloc_page()) == p0);
+    assert(PageProperty(p0 + 1) && p0[1].property == 0);
+    assert(PageProperty(p0 + 2) && p0[2].property == 1);
+    assert(PageProperty(p0 + 4) && p0[4].property == 2);
+
+    // n is not a power of 2, the tail is given back
+    assert((p2 = alloc_pages(3)) == p0 + 4);
+    assert(PageProperty(p0 + 7) && p0[7].property == 0);
+    assert(nr_free == 4);
+
+    assert((p3 = alloc_pages(2)) == p0 + 2);
+    assert(alloc_pages(2) == NULL);
+
+    // p0 merges with p0 + 1, p0 + 2 is still in use
+    free_page(p1);
+    assert(PageProperty(p0) && p0->property == 1);
+    assert(!PageProperty(p0 + 1));
+
+    free_pages(p3, 2);
+    assert(PageProperty(p0) && p0->property == 2);
+    assert(!PageProperty(p0 + 2));
+
+    free_pages(p2, 3);
+    assert(PageProperty(p0) && p0->property == 3);
+    assert(nr_free == 8 && nr_block(3) == 1);
+    for (i = 0; i < 3; i ++) {
+        assert(nr_block(i) == 0);
+    }
+
+    assert((p1 = alloc_pages(8)) == p0);
+    assert(alloc_page() == NULL);
+
+    assert(nr_free == 0);
+    nr_free = nr_free_store;
+
+    memcpy(free_area, free_area_store, sizeof(free_area));
+    free_pages(p0, 16);
+
+    buddy_count(&count2, &total2);
+    assert(count2 == count);
+    assert(total2 == total);
+}
+
+const struct pmm_manager buddy_pmm_manager = {
+    .name = "buddy_pmm_manager",
+    .init = buddy_init,
+    .init_memmap = buddy_init_memmap,
+    .alloc_pages = buddy_alloc_pages,
+    .free_pages = buddy_free_pages,
+    .nr_free_pages = buddy_nr_free_pages,
+    .check = buddy_check,
+};
+
@@ -0,0 +1,12 @@
+#ifndef __KERN_MM_BUDDY_PMM_H__
+#define  __KERN_MM_BUDDY_PMM_H__
+
+#include <pmm.h>
+
+#define MAX_ORDER       11          // the largest block is 2^(MAX_ORDER-1) pages (4MB)
+#define MAX_ZONE_NUM    10          // max # of e820 regions handled by init_memmap
+
+extern const struct pmm_manager buddy_pmm_manager;
+
+#endif /* ! __KERN_MM_BUDDY_PMM_H__ */
+
@@ -186,13 +186,333 @@ static void slob_free(void *block, int size)
 
 
 
+/*
+ * SLAB object caches: kmem_cache_create/alloc/free
+ *
+ * kmalloc above keeps all small objects in one first-fit list, so the cost
+ * of allocating a hot, fixed-size structure (proc_struct, mm_struct, ...)
+ * depends on how fragmented the heap is. A kmem_cache keeps objects of one
+ * type in slabs instead:
+ *
+ *   - a slab is one page: [struct slab][bufctl[num]][obj 0]...[obj num-1].
+ *     bufctl[i] is the index of the next free object after object i, so the
+ *     free objects are chained without touching the objects themselves, and
+ *     the state set up by the constructor survives alloc/free cycles.
+ *   - a cache has three lists of slabs: full, partial and free. Allocation
+ *     takes the first object of the first partial (or free) slab, and free
+ *     finds the slab by rounding the object down to its page, so both are
+ *     O(1).
+ *   - the constructor is called once for each object when a new slab is
+ *     created, objects handed back to kmem_cache_free should be left in the
+ *     constructed state.
+ *   - at most one empty slab is kept per cache, others are given back to
+ *     the pmm at once.
+ *
+ * The kmem_cache_t descriptors are allocated from cache_cache, which is a
+ * kmem_cache itself.
+ */
+
+typedef int16_t kmem_bufctl_t;
+
+#define BUFCTL_END                  ((kmem_bufctl_t)-1)
+
+struct slab {
+    list_entry_t slab_link;         // link in slabs_full/partial/free of the cache
+    kmem_cache_t *cachep;           // the cache this slab belongs to
+    void *s_mem;                    // the first object in this slab
+    size_t inuse;                   // # of allocated objects in this slab
+    kmem_bufctl_t free;             // index of the first free object
+};
+
+struct kmem_cache_s {
+    list_entry_t slabs_full;        // slabs without free object
+    list_entry_t slabs_partial;     // slabs with both free and allocated objects
+    list_entry_t slabs_free;        // slabs without allocated object
+    size_t objsize;                 // size of an object, aligned
+    size_t num;                     // # of objects per slab
+    size_t offset;                  // offset of the first object in a slab
+    void (*ctor)(void *);           // constructor of objects, can be NULL
+    const char *name;               // name of the cache
+    list_entry_t cache_link;        // link in cache_chain
+};
+
+#define le2slab(le, member)                 \
+    to_struct((le), struct slab, member)
+
+#define slab_bufctl(slabp)                  \
+    ((kmem_bufctl_t *)((struct slab *)(slabp) + 1))
+
+static kmem_cache_t cache_cache;
+static list_entry_t cache_chain = {&cache_chain, &cache_chain};
+static size_t slab_pages;
+static list_entry_t shrinker_list = {&shrinker_list, &shrinker_list};
+
+//kmem_cache_estimate - compute # of objects per slab and the offset of the first one
+static void
+kmem_cache_estimate(kmem_cache_t *cachep) {
+    size_t num = (PGSIZE - sizeof(struct slab)) / (cachep->objsize + sizeof(kmem_bufctl_t)), offset;
+    while (1) {
+        offset = ROUNDUP(sizeof(struct slab) + num * sizeof(kmem_bufctl_t), sizeof(long));
+        if (offset + num * cachep->objsize <= PGSIZE) {
+            break;
+        }
+        num --;
+    }
+    assert(num > 0);
+    cachep->num = num, cachep->offset = offset;
+}
+
+static void
+kmem_cache_init(kmem_cache_t *cachep, const char *name, size_t size, void (*ctor)(void *)) {
+    list_init(&(cachep->slabs_full));
+    list_init(&(cachep->slabs_partial));
+    list_init(&(cachep->slabs_free));
+    cachep->objsize = ROUNDUP(size, sizeof(long));
+    cachep->ctor = ctor, cachep->name = name;
+    kmem_cache_estimate(cachep);
+    list_add(&cache_chain, &(cachep->cache_link));
+}
+
+//kmem_cache_grow - alloc a page for a new slab, build the free chain and construct all objects
+static struct slab *
+kmem_cache_grow(kmem_cache_t *cachep) {
+    struct Page *page;
+    if ((page = alloc_page()) == NULL) {
+        return NULL;
+    }
+    SetPageSlab(page);
+    struct slab *slabp = page2kva(page);
+    slabp->cachep = cachep;
+    slabp->s_mem = (void *)slabp + cachep->offset;
+    slabp->inuse = 0, slabp->free = 0;
+
+    kmem_bufctl_t *bufctl = slab_bufctl(slabp);
+    int i;
+    for (i = 0; i < cachep->num; i ++) {
+        if (cachep->ctor != NULL) {
+            cachep->ctor(slabp->s_mem + i * cachep->objsize);
+        }
+        bufctl[i] = i + 1;
+    }
+    bufctl[cachep->num - 1] = BUFCTL_END;
+    return slabp;
+}
+
+//kmem_slab_destroy - give the page of an empty slab back
+static void
+kmem_slab_destroy(struct slab *slabp) {
+    struct Page *page = kva2page(slabp);
+    assert(slabp->inuse == 0 && PageSlab(page));
+    ClearPageSlab(page);
+    free_page(page);
+}
+
+kmem_cache_t *
+kmem_cache_create(const char *name, size_t size, void (*ctor)(void *)) {
+    assert(size > 0 && size <= PGSIZE / 2);
+    kmem_cache_t *cachep;
+    if ((cachep = kmem_cache_alloc(&cache_cache)) != NULL) {
+        unsigned long flags;
+        spin_lock_irqsave(&slab_lock, flags);
+        kmem_cache_init(cachep, name, size, ctor);
+        spin_unlock_irqrestore(&slab_lock, flags);
+    }
+    return cachep;
+}
+
+//kmem_cache_destroy - all objects should have been freed before
+void
+kmem_cache_destroy(kmem_cache_t *cachep) {
+    assert(cachep != &cache_cache);
+    unsigned long flags;
+    spin_lock_irqsave(&slab_lock, flags);
+    assert(list_empty(&(cachep->slabs_full)) && list_empty(&(cachep->slabs_partial)));
+    list_entry_t *le;
+    while ((le = list_next(&(cachep->slabs_free))) != &(cachep->slabs_free)) {
+        list_del(le);
+        kmem_slab_destroy(le2slab(le, slab_link));
+        slab_pages --;
+    }
+    list_del(&(cachep->cache_link));
+    spin_unlock_irqrestore(&slab_lock, flags);
+    kmem_cache_free(&cache_cache, cachep);
+}
+
+void *
+kmem_cache_alloc(kmem_cache_t *cachep) {
+    struct slab *slabp;
+    unsigned long flags;
+
+    spin_lock_irqsave(&slab_lock, flags);
+    list_entry_t *le = list_next(&(cachep->slabs_partial));
+    if (le == &(cachep->slabs_partial)) {
+        if ((le = list_next(&(cachep->slabs_free))) == &(cachep->slabs_free)) {
+            spin_unlock_irqrestore(&slab_lock, flags);
+
+            if ((slabp = kmem_cache_grow(cachep)) == NULL) {
+                return NULL;
+            }
+
+            spin_lock_irqsave(&slab_lock, flags);
+            list_add(&(cachep->slabs_free), &(slabp->slab_link));
+            slab_pages ++;
+            le = &(slabp->slab_link);
+        }
+    }
+
+    slabp = le2slab(le, slab_link);
+    assert(slabp->free != BUFCTL_END);
+    void *objp = slabp->s_mem + slabp->free * cachep->objsize;
+    slabp->free = slab_bufctl(slabp)[slabp->free];
+    slabp->inuse ++;
+
+    list_del(le);
+    if (slabp->inuse == cachep->num) {
+        list_add(&(cachep->slabs_full), le);
+    }
+    else {
+        list_add(&(cachep->slabs_partial), le);
+    }
+    spin_unlock_irqrestore(&slab_lock, flags);
+    return objp;
+}
+
+void
+kmem_cache_free(kmem_cache_t *cachep, void *objp) {
+    struct slab *slabp = ROUNDDOWN(objp, PGSIZE), *destroy = NULL;
+    assert(slabp->cachep == cachep);
+    size_t off = objp - slabp->s_mem, idx = off / cachep->objsize;
+    assert(off % cachep->objsize == 0 && idx < cachep->num);
+
+    unsigned long flags;
+    spin_lock_irqsave(&slab_lock, flags);
+    slab_bufctl(slabp)[idx] = slabp->free;
+    slabp->free = idx;
+    slabp->inuse --;
+
+    list_entry_t *le = &(slabp->slab_link);
+    list_del(le);
+    if (slabp->inuse != 0) {
+        list_add(&(cachep->slabs_partial), le);
+    }
+    else if (list_empty(&(cachep->slabs_free))) {
+        list_add(&(cachep->slabs_free), le);
+    }
+    else {
+        destroy = slabp;
+        slab_pages --;
+    }
+    spin_unlock_irqrestore(&slab_lock, flags);
+
+    if (destroy != NULL) {
+        kmem_slab_destroy(destroy);
+    }
+}
+
+//kmem_cache_reap - give the empty slabs kept by all caches back to the pmm, return # of pages freed
+size_t
+kmem_cache_reap(void) {
+    unsigned long flags;
+    spin_lock_irqsave(&slab_lock, flags);
+    size_t nr_pages = slab_pages;
+    list_entry_t *le = &cache_chain;
+    while ((le = list_next(le)) != &cache_chain) {
+        kmem_cache_t *cachep = to_struct(le, kmem_cache_t, cache_link);
+        list_entry_t *sle;
+        while ((sle = list_next(&(cachep->slabs_free))) != &(cachep->slabs_free)) {
+            list_del(sle);
+            kmem_slab_destroy(le2slab(sle, slab_link));
+            slab_pages --;
+        }
+    }
+    nr_pages -= slab_pages;
+    spin_unlock_irqrestore(&slab_lock, flags);
+    return nr_pages;
+}
+
+void
+register_shrinker(struct shrinker *s) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    list_add(&shrinker_list, &(s->shrinker_link));
+    local_intr_restore(intr_flag);
+}
+
+void
+unregister_shrinker(struct shrinker *s) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    list_del(&(s->shrinker_link));
+    local_intr_restore(intr_flag);
+}
+
+//kmem_shrink - ask all shrinkers to free cached objects, then reap the empty slabs,
+//              return # of pages given back to the pmm. called by alloc_pages.
+size_t
+kmem_shrink(void) {
+    list_entry_t *le = &shrinker_list;
+    while ((le = list_next(le)) != &shrinker_list) {
+        struct shrinker *s = to_struct(le, struct shrinker, shrinker_link);
+        s->shrink(s);
+    }
+    return kmem_cache_reap();
+}
+
+#define CHECK_SLAB_MAGIC            0x5AB5AB00
+
+static void
+check_slab_ctor(void *objp) {
+    *(uint32_t *)objp = CHECK_SLAB_MAGIC;
+}
+
 void check_slab(void) {
-  cprintf("check_slab() success\n");
+    kmem_cache_t *cachep = kmem_cache_create("check_slab", 100, check_slab_ctor);
+    assert(cachep != NULL && cachep->objsize == 100);
+    assert(cachep->num > 1 && cachep->offset + cachep->num * cachep->objsize <= PGSIZE);
+
+    size_t nr_free_pages_store = nr_free_pages();
+    size_t slab_pages_store = slab_pages;
+
+    // fill two slabs and one more object
+    int i, n = cachep->num * 2 + 1;
+    uint32_t *objs[n];
+    for (i = 0; i < n; i ++) {
+        assert((objs[i] = kmem_cache_alloc(cachep)) != NULL);
+        assert(*objs[i] == CHECK_SLAB_MAGIC);
+        *objs[i] = i;
+    }
+    for (i = 1; i < n; i ++) {
+        assert(objs[i] != objs[i - 1]);
+    }
+    assert(list_next(&(cachep->slabs_full)) != &(cachep->slabs_full));
+    assert(list_empty(&(cachep->slabs_free)));
+    assert(le2slab(list_next(&(cachep->slabs_partial)), slab_link)->inuse == 1);
+
+    // the last freed object is the next allocated one
+    kmem_cache_free(cachep, objs[3]);
+    assert(kmem_cache_alloc(cachep) == objs[3]);
+    assert(*objs[3] == 3);
+
+    // one empty slab is kept, others are given back
+    for (i = 0; i < n; i ++) {
+        kmem_cache_free(cachep, objs[i]);
+    }
+    assert(list_empty(&(cachep->slabs_full)) && list_empty(&(cachep->slabs_partial)));
+    assert(slab_pages == slab_pages_store + 1);
+    assert(nr_free_pages_store == nr_free_pages() + 1);
+
+    kmem_cache_destroy(cachep);
+    assert(slab_pages == slab_pages_store);
+    assert(nr_free_pages_store == nr_free_pages());
+
+    cprintf("check_slab() success\n");
 }
 
 void
 slab_init(void) {
   cprintf("use SLOB allocator\n");
+  list_init(&cache_chain);
+  kmem_cache_init(&cache_cache, "kmem_cache", sizeof(kmem_cache_t), NULL);
   check_slab();
 }
 
@@ -204,7 +524,7 @@ kmalloc_init(void) {
 
 size_t
 slab_allocated(void) {
-  return 0;
+  return slab_pages * PGSIZE;
 }
 
 size_t
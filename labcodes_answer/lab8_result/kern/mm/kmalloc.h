@@ -2,6 +2,7 @@
 #define __KERN_MM_SLAB_H__
 
 #include <defs.h>
+#include <list.h>
 
 #define KMALLOC_MAX_ORDER       10
 
@@ -12,5 +13,27 @@ void kfree(void *objp);
 
 size_t kallocated(void);
 
+typedef struct kmem_cache_s kmem_cache_t;
+
+kmem_cache_t *kmem_cache_create(const char *name, size_t size, void (*ctor)(void *));
+void kmem_cache_destroy(kmem_cache_t *cachep);
+void *kmem_cache_alloc(kmem_cache_t *cachep);
+void kmem_cache_free(kmem_cache_t *cachep, void *objp);
+size_t kmem_cache_reap(void);
+
+/*
+ * A shrinker frees the objects a subsystem keeps cached but doesn't need, it's
+ * called by kmem_shrink when pages run out. shrink must not sleep (it may be
+ * called with locks held), and returns the # of objects freed.
+ */
+struct shrinker {
+    size_t (*shrink)(struct shrinker *s);
+    list_entry_t shrinker_link;
+};
+
+void register_shrinker(struct shrinker *s);
+void unregister_shrinker(struct shrinker *s);
+size_t kmem_shrink(void);
+
 #endif /* !__KERN_MM_SLAB_H__ */
 
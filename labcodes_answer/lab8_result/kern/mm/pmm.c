@@ -6,6 +6,7 @@
 #include <memlayout.h>
 #include <pmm.h>
 #include <default_pmm.h>
+#include <buddy_pmm.h>
 #include <sync.h>
 #include <error.h>
 #include <swap.h>
@@ -138,9 +139,14 @@ gdt_init(void) {
 }
 
 //init_pmm_manager - initialize a pmm_manager instance
+//                 - the buddy system is used, build with "DEFS+=-DUSE_DEFAULT_PMM" to select first fit
 static void
 init_pmm_manager(void) {
+#ifdef USE_DEFAULT_PMM
     pmm_manager = &default_pmm_manager;
+#else
+    pmm_manager = &buddy_pmm_manager;
+#endif
     cprintf("memory management: %s\n", pmm_manager->name);
     pmm_manager->init();
 }
@@ -165,7 +171,10 @@ alloc_pages(size_t n) {
          }
          local_intr_restore(intr_flag);
 
-         if (page != NULL || n > 1 || swap_init_ok == 0) break;
+         if (page != NULL) break;
+         // give the objects cached by kernel back before swapping
+         if (kmem_shrink() != 0) continue;
+         if (n > 1 || swap_init_ok == 0) break;
          
          extern struct mm_struct *check_mm_struct;
          //cprintf("page %x, call swap_out in alloc_pages %d\n",page, n);
@@ -478,7 +487,9 @@ exit_range(pde_t *pgdir, uintptr_t start, uintptr_t end) {
 /* copy_range - copy content of memory (start, end) of one process A to another process B
  * @to:    the addr of process B's Page Directory
  * @from:  the addr of process A's Page Directory
- * @share: flags to indicate to dup OR share. We just use dup method, so it didn't be used.
+ * @share: flags to indicate to dup OR share. If share, the pages are not copied but mapped
+ *         in B too, and writable pages become read-only in both A and B (copy on write, the
+ *         copy is delayed to do_pgfault when A or B writes to the page).
  *
  * CALL GRAPH: copy_mm-->dup_mmap-->copy_range
  */
@@ -502,11 +513,23 @@ copy_range(pde_t *to, pde_t *from, uintptr_t start, uintptr_t end, bool share) {
         uint32_t perm = (*ptep & PTE_USER);
         //get page from ptep
         struct Page *page = pte2page(*ptep);
+        assert(page!=NULL);
+        int ret=0;
+        if (share) {
+            // share the page with process B, and write-protect it in both A and B
+            if (perm & PTE_W) {
+                perm &= ~PTE_W;
+                *ptep &= ~PTE_W;
+                tlb_invalidate(from, start);
+            }
+            ret = page_insert(to, page, start, perm);
+            assert(ret == 0);
+            start += PGSIZE;
+            continue ;
+        }
         // alloc a page for process B
         struct Page *npage=alloc_page();
-        assert(page!=NULL);
         assert(npage!=NULL);
-        int ret=0;
         /* LAB5:EXERCISE2 YOUR CODE
          * replicate content of page to npage, build the map of phy addr of nage with the linear addr start
          *
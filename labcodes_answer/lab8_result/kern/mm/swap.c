@@ -6,7 +6,7 @@
 #include <memlayout.h>
 #include <pmm.h>
 #include <mmu.h>
-#include <default_pmm.h>
+#include <kmalloc.h>
 #include <kdebug.h>
 
 // the valid vaddr for check is between 0~CHECK_VALID_VADDR-1
@@ -171,24 +171,16 @@ struct Page * check_rp[CHECK_VALID_PHY_PAGE_NUM];
 pte_t * check_ptep[CHECK_VALID_PHY_PAGE_NUM];
 unsigned int check_swap_addr[CHECK_VALID_VIR_PAGE_NUM];
 
-extern free_area_t free_area;
-
-#define free_list (free_area.free_list)
-#define nr_free (free_area.nr_free)
-
 static void
 check_swap(void)
 {
     //backup mem env
-     int ret, count = 0, total = 0, i;
-     list_entry_t *le = &free_list;
-     while ((le = list_next(le)) != &free_list) {
-        struct Page *p = le2page(le, page_link);
-        assert(PageProperty(p));
-        count ++, total += p->property;
-     }
-     assert(total == nr_free_pages());
-     cprintf("BEGIN check_swap: count %d, total %d\n",count,total);
+     int ret, i;
+     // give back the empty slabs first, so the count below is what it is again
+     // once mm and vma are freed and their slabs are reaped at the end
+     kmem_shrink();
+     size_t nr_free_store = nr_free_pages();
+     cprintf("BEGIN check_swap: nr_free_pages %d\n", nr_free_store);
      
      //now we set the phy pages env     
      struct mm_struct *mm = mm_create();
@@ -219,18 +211,22 @@ check_swap(void)
           assert(check_rp[i] != NULL );
           assert(!PageProperty(check_rp[i]));
      }
-     list_entry_t free_list_store = free_list;
-     list_init(&free_list);
-     assert(list_empty(&free_list));
-     
-     //assert(alloc_page() == NULL);
+     // take all other free pages away, so only check_rp[] are left to the vaddrs being checked.
+     // this goes through pmm_manager, so it works whichever manager is used. give back the
+     // empty slabs first, or alloc_pages would free them when it runs out of pages below.
+     kmem_shrink();
+     list_entry_t taken_list;
+     list_init(&taken_list);
+     while (nr_free_pages() > 0) {
+          struct Page *p = alloc_page();
+          assert(p != NULL);
+          list_add(&taken_list, &(p->page_link));
+     }
      
-     unsigned int nr_free_store = nr_free;
-     nr_free = 0;
      for (i=0;i<CHECK_VALID_PHY_PAGE_NUM;i++) {
         free_pages(check_rp[i],1);
      }
-     assert(nr_free==CHECK_VALID_PHY_PAGE_NUM);
+     assert(nr_free_pages()==CHECK_VALID_PHY_PAGE_NUM);
      
      cprintf("set up init env for check_swap begin!\n");
      //setup initial vir_page<->phy_page environment for page relpacement algorithm 
@@ -239,7 +235,7 @@ check_swap(void)
      pgfault_num=0;
      
      check_content_set();
-     assert( nr_free == 0);         
+     assert( nr_free_pages() == 0);         
      for(i = 0; i<MAX_SEQ_NO ; i++) 
          swap_out_seq_no[i]=swap_in_seq_no[i]=-1;
      
@@ -248,8 +244,11 @@ check_swap(void)
          check_ptep[i] = get_pte(pgdir, (i+1)*0x1000, 0);
          //cprintf("i %d, check_ptep addr %x, value %x\n", i, check_ptep[i], *check_ptep[i]);
          assert(check_ptep[i] != NULL);
-         assert(pte2page(*check_ptep[i]) == check_rp[i]);
          assert((*check_ptep[i] & PTE_P));          
+         // pmm_manager may give check_rp[] back in any order
+         int j;
+         for (j = 0; j < CHECK_VALID_PHY_PAGE_NUM && pte2page(*check_ptep[i]) != check_rp[j]; j ++);
+         assert(j < CHECK_VALID_PHY_PAGE_NUM);
      }
      cprintf("set up init env for check_swap over!\n");
      // now access the virt pages to test  page relpacement algorithm 
@@ -268,17 +267,14 @@ check_swap(void)
      mm_destroy(mm);
      check_mm_struct = NULL;
      
-     nr_free = nr_free_store;
-     free_list = free_list_store;
-
-     
-     le = &free_list;
-     while ((le = list_next(le)) != &free_list) {
-         struct Page *p = le2page(le, page_link);
-         count --, total -= p->property;
+     list_entry_t *le;
+     while ((le = list_next(&taken_list)) != &taken_list) {
+          list_del(le);
+          free_page(le2page(le, page_link));
      }
-     cprintf("count is %d, total is %d\n",count,total);
-     //assert(count == 0);
+     kmem_cache_reap();
+     cprintf("nr_free_pages is %d, should be %d\n", nr_free_pages(), nr_free_store);
+     assert(nr_free_pages() == nr_free_store);
      
      cprintf("check_swap() succeeded!\n");
 }
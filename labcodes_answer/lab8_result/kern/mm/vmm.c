@@ -28,27 +28,38 @@
      struct vma_struct * find_vma(struct mm_struct *mm, uintptr_t addr)
    local functions
      inline void check_vma_overlap(struct vma_struct *prev, struct vma_struct *next)
+     inline struct vma_struct * find_vma_rb(rb_tree *tree, uintptr_t addr)
+     inline void insert_vma_rb(rb_tree *tree, struct vma_struct *vma, struct vma_struct **vma_prevp)
 ---------------
    check correctness functions
      void check_vmm(void);
      void check_vma_struct(void);
+     void check_vma_struct_rb(void);
      void check_pgfault(void);
+     void check_cow(void);
 */
 
 static void check_vmm(void);
 static void check_vma_struct(void);
+static void check_vma_struct_rb(void);
 static void check_pgfault(void);
+static void check_cow(void);
+static void check_mm_unmap(void);
+
+static kmem_cache_t *mm_cachep, *vma_cachep;
 
 // mm_create -  alloc a mm_struct & initialize it.
 struct mm_struct *
 mm_create(void) {
-    struct mm_struct *mm = kmalloc(sizeof(struct mm_struct));
+    struct mm_struct *mm = kmem_cache_alloc(mm_cachep);
 
     if (mm != NULL) {
         list_init(&(mm->mmap_list));
+        mm->mmap_tree = NULL;
         mm->mmap_cache = NULL;
         mm->pgdir = NULL;
         mm->map_count = 0;
+        mm->brk_start = mm->brk = 0;
 
         if (swap_init_ok) swap_init_mm(mm);
         else mm->sm_priv = NULL;
@@ -62,7 +73,7 @@ mm_create(void) {
 // vma_create - alloc a vma_struct & initialize it. (addr range: vm_start~vm_end)
 struct vma_struct *
 vma_create(uintptr_t vm_start, uintptr_t vm_end, uint32_t vm_flags) {
-    struct vma_struct *vma = kmalloc(sizeof(struct vma_struct));
+    struct vma_struct *vma = kmem_cache_alloc(vma_cachep);
 
     if (vma != NULL) {
         vma->vm_start = vm_start;
@@ -72,6 +83,30 @@ vma_create(uintptr_t vm_start, uintptr_t vm_end, uint32_t vm_flags) {
     return vma;
 }
 
+// vma_destroy - free a vma_struct which has been removed from mm
+static inline void
+vma_destroy(struct vma_struct *vma) {
+    kmem_cache_free(vma_cachep, vma);
+}
+
+
+// find_vma_rb - find the vma with the largest vm_start <= addr in the redblack tree
+static inline struct vma_struct *
+find_vma_rb(rb_tree *tree, uintptr_t addr) {
+    rb_node *node = rb_node_root(tree);
+    struct vma_struct *vma = NULL, *tmp;
+    while (node != NULL) {
+        tmp = rbn2vma(node, rb_link);
+        if (tmp->vm_start <= addr) {
+            vma = tmp;
+            node = rb_node_right(tree, node);
+        }
+        else {
+            node = rb_node_left(tree, node);
+        }
+    }
+    return vma;
+}
 
 // find_vma - find a vma  (vma->vm_start <= addr <= vma_vm_end)
 struct vma_struct *
@@ -80,6 +115,13 @@ find_vma(struct mm_struct *mm, uintptr_t addr) {
     if (mm != NULL) {
         vma = mm->mmap_cache;
         if (!(vma != NULL && vma->vm_start <= addr && vma->vm_end > addr)) {
+            if (mm->mmap_tree != NULL) {
+                vma = find_vma_rb(mm->mmap_tree, addr);
+                if (vma != NULL && vma->vm_end <= addr) {
+                    vma = NULL;
+                }
+            }
+            else {
                 bool found = 0;
                 list_entry_t *list = &(mm->mmap_list), *le = list;
                 while ((le = list_next(le)) != list) {
@@ -92,6 +134,7 @@ find_vma(struct mm_struct *mm, uintptr_t addr) {
                 if (!found) {
                     vma = NULL;
                 }
+            }
         }
         if (vma != NULL) {
             mm->mmap_cache = vma;
@@ -100,6 +143,28 @@ find_vma(struct mm_struct *mm, uintptr_t addr) {
     return vma;
 }
 
+// find_vma_intersection - find the first vma which overlaps [start, end)
+static struct vma_struct *
+find_vma_intersection(struct mm_struct *mm, uintptr_t start, uintptr_t end) {
+    list_entry_t *list = &(mm->mmap_list), *le = list;
+    if (mm->mmap_tree != NULL) {
+        // begin with the vma just below start, the ones before it can't overlap
+        struct vma_struct *vma = find_vma_rb(mm->mmap_tree, start);
+        if (vma != NULL) {
+            le = list_prev(&(vma->list_link));
+        }
+    }
+    while ((le = list_next(le)) != list) {
+        struct vma_struct *vma = le2vma(le, list_link);
+        if (vma->vm_start >= end) {
+            break;
+        }
+        if (vma->vm_end > start) {
+            return vma;
+        }
+    }
+    return NULL;
+}
 
 // check_vma_overlap - check if vma1 overlaps vma2 ?
 static inline void
@@ -109,14 +174,39 @@ check_vma_overlap(struct vma_struct *prev, struct vma_struct *next) {
     assert(next->vm_start < next->vm_end);
 }
 
+// vma_compare - compare the start addr of two vma in the redblack tree
+static inline int
+vma_compare(rb_node *node1, rb_node *node2) {
+    struct vma_struct *vma1 = rbn2vma(node1, rb_link);
+    struct vma_struct *vma2 = rbn2vma(node2, rb_link);
+    uintptr_t start1 = vma1->vm_start, start2 = vma2->vm_start;
+    return (start1 < start2) ? -1 : (start1 > start2) ? 1 : 0;
+}
 
-// insert_vma_struct -insert vma in mm's list link
+// insert_vma_rb - insert vma in the redblack tree, and return the vma before it in *vma_prevp
+static inline void
+insert_vma_rb(rb_tree *tree, struct vma_struct *vma, struct vma_struct **vma_prevp) {
+    if (vma_prevp != NULL) {
+        *vma_prevp = find_vma_rb(tree, vma->vm_start);
+    }
+    rb_insert(tree, &(vma->rb_link));
+}
+
+// insert_vma_struct -insert vma in mm's list link (and mm's redblack tree if there are many vma)
 void
 insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
     assert(vma->vm_start < vma->vm_end);
     list_entry_t *list = &(mm->mmap_list);
     list_entry_t *le_prev = list, *le_next;
 
+    if (mm->mmap_tree != NULL) {
+        struct vma_struct *mmap_prev;
+        insert_vma_rb(mm->mmap_tree, vma, &mmap_prev);
+        if (mmap_prev != NULL) {
+            le_prev = &(mmap_prev->list_link);
+        }
+    }
+    else {
         list_entry_t *le = list;
         while ((le = list_next(le)) != list) {
             struct vma_struct *mmap_prev = le2vma(le, list_link);
@@ -125,6 +215,7 @@ insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
             }
             le_prev = le;
         }
+    }
 
     le_next = list_next(le_prev);
 
@@ -140,6 +231,29 @@ insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
     list_add_after(le_prev, &(vma->list_link));
 
     mm->map_count ++;
+    if (mm->mmap_tree == NULL && mm->map_count >= RB_MIN_MAP_COUNT) {
+        // try to build the redblack tree, if failed, we just keep using the linear list
+        if ((mm->mmap_tree = rb_tree_create(vma_compare)) != NULL) {
+            list_entry_t *le = list;
+            while ((le = list_next(le)) != list) {
+                insert_vma_rb(mm->mmap_tree, le2vma(le, list_link), NULL);
+            }
+        }
+    }
+}
+
+// remove_vma_struct - remove vma from mm's list link (and mm's redblack tree)
+static void
+remove_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
+    assert(vma->vm_mm == mm);
+    list_del(&(vma->list_link));
+    if (mm->mmap_tree != NULL) {
+        rb_delete(mm->mmap_tree, &(vma->rb_link));
+    }
+    if (mm->mmap_cache == vma) {
+        mm->mmap_cache = NULL;
+    }
+    mm->map_count --;
 }
 
 // mm_destroy - free mm and mm internal fields
@@ -150,9 +264,12 @@ mm_destroy(struct mm_struct *mm) {
     list_entry_t *list = &(mm->mmap_list), *le;
     while ((le = list_next(list)) != list) {
         list_del(le);
-        kfree(le2vma(le, list_link));  //kfree vma        
+        vma_destroy(le2vma(le, list_link));  //free vma
     }
-    kfree(mm); //kfree mm
+    if (mm->mmap_tree != NULL) {
+        rb_tree_destroy(mm->mmap_tree);
+    }
+    kmem_cache_free(mm_cachep, mm); //free mm
     mm=NULL;
 }
 
@@ -169,7 +286,7 @@ mm_map(struct mm_struct *mm, uintptr_t addr, size_t len, uint32_t vm_flags,
     int ret = -E_INVAL;
 
     struct vma_struct *vma;
-    if ((vma = find_vma(mm, start)) != NULL && end > vma->vm_start) {
+    if (find_vma_intersection(mm, start, end) != NULL) {
         goto out;
     }
     ret = -E_NO_MEM;
@@ -187,9 +304,109 @@ out:
     return ret;
 }
 
+// mm_unmap - remove the mapping of [addr, addr + len), the vmas across the boundary are cut,
+//          - and a vma containing the whole range is split into two
+int
+mm_unmap(struct mm_struct *mm, uintptr_t addr, size_t len) {
+    uintptr_t start = ROUNDDOWN(addr, PGSIZE), end = ROUNDUP(addr + len, PGSIZE);
+    if (!USER_ACCESS(start, end)) {
+        return -E_INVAL;
+    }
+
+    assert(mm != NULL);
+
+    struct vma_struct *vma;
+    if ((vma = find_vma_intersection(mm, start, end)) == NULL) {
+        return 0;
+    }
+
+    if (vma->vm_start < start && end < vma->vm_end) {
+        struct vma_struct *nvma;
+        if ((nvma = vma_create(end, vma->vm_end, vma->vm_flags)) == NULL) {
+            return -E_NO_MEM;
+        }
+        vma->vm_end = start;
+        insert_vma_struct(mm, nvma);
+        unmap_range(mm->pgdir, start, end);
+        return 0;
+    }
+
+    list_entry_t *list = &(mm->mmap_list), *le;
+    while (vma != NULL && vma->vm_start < end) {
+        le = list_next(&(vma->list_link));
+        uintptr_t un_start = vma->vm_start, un_end = vma->vm_end;
+        if (un_start < start) {
+            // keep the lower part, the order of vmas doesn't change
+            vma->vm_end = un_start = start;
+        }
+        else if (end < un_end) {
+            // keep the upper part, the order of vmas doesn't change
+            vma->vm_start = un_end = end;
+        }
+        else {
+            remove_vma_struct(mm, vma);
+            vma_destroy(vma);
+        }
+        unmap_range(mm->pgdir, un_start, un_end);
+        vma = (le != list) ? le2vma(le, list_link) : NULL;
+    }
+    return 0;
+}
+
+// mm_brk - map [addr, addr + len) as anonymous memory for heap, the pages are
+//        - allocated (and filled with zero) by do_pgfault when they are accessed
+int
+mm_brk(struct mm_struct *mm, uintptr_t addr, size_t len) {
+    uintptr_t start = ROUNDDOWN(addr, PGSIZE), end = ROUNDUP(addr + len, PGSIZE);
+    if (!USER_ACCESS(start, end)) {
+        return -E_INVAL;
+    }
+
+    assert(mm != NULL);
+
+    if (find_vma_intersection(mm, start, end) != NULL) {
+        return -E_INVAL;
+    }
+
+    // grow the vma just below if it is also a heap-like one
+    uint32_t vm_flags = VM_READ | VM_WRITE;
+    struct vma_struct *vma = find_vma(mm, start - 1);
+    if (vma != NULL && vma->vm_end == start && vma->vm_flags == vm_flags) {
+        vma->vm_end = end;
+        return 0;
+    }
+    return mm_map(mm, start, end - start, vm_flags, NULL);
+}
+
+// get_unmapped_area - find a free range of len bytes for mmap, search from the top of
+//                   - user space down, return 0 if there isn't one
+uintptr_t
+get_unmapped_area(struct mm_struct *mm, size_t len) {
+    len = ROUNDUP(len, PGSIZE);
+    if (len == 0 || len > USERTOP - UTEXT) {
+        return 0;
+    }
+    uintptr_t start = USERTOP - len;
+    list_entry_t *list = &(mm->mmap_list), *le = list;
+    while ((le = list_prev(le)) != list) {
+        struct vma_struct *vma = le2vma(le, list_link);
+        if (start >= vma->vm_end) {
+            break;
+        }
+        if (start + len > vma->vm_start) {
+            if (len > vma->vm_start) {
+                return 0;
+            }
+            start = vma->vm_start - len;
+        }
+    }
+    return (start >= UTEXT && start >= mm->brk) ? start : 0;
+}
+
 int
 dup_mmap(struct mm_struct *to, struct mm_struct *from) {
     assert(to != NULL && from != NULL);
+    to->brk_start = from->brk_start, to->brk = from->brk;
     list_entry_t *list = &(from->mmap_list), *le = list;
     while ((le = list_prev(le)) != list) {
         struct vma_struct *vma, *nvma;
@@ -201,7 +418,7 @@ dup_mmap(struct mm_struct *to, struct mm_struct *from) {
 
         insert_vma_struct(to, nvma);
 
-        bool share = 0;
+        bool share = 1;
         if (copy_range(to->pgdir, from->pgdir, vma->vm_start, vma->vm_end, share) != 0) {
             return -E_NO_MEM;
         }
@@ -243,9 +460,14 @@ copy_to_user(struct mm_struct *mm, void *dst, const void *src, size_t len) {
 }
 
 // vmm_init - initialize virtual memory management
-//          - now just call check_vmm to check correctness of vmm
+//          - create the object caches for mm & vma, then call check_vmm to check correctness of vmm
 void
 vmm_init(void) {
+    mm_cachep = kmem_cache_create("mm_struct", sizeof(struct mm_struct), NULL);
+    vma_cachep = kmem_cache_create("vma_struct", sizeof(struct vma_struct), NULL);
+    if (mm_cachep == NULL || vma_cachep == NULL) {
+        panic("cannot create mm/vma cache.\n");
+    }
     check_vmm();
 }
 
@@ -255,7 +477,10 @@ check_vmm(void) {
     size_t nr_free_pages_store = nr_free_pages();
     
     check_vma_struct();
+    check_vma_struct_rb();
     check_pgfault();
+    check_cow();
+    check_mm_unmap();
 
     //assert(nr_free_pages_store == nr_free_pages());
 
@@ -324,6 +549,60 @@ check_vma_struct(void) {
     cprintf("check_vma_struct() succeeded!\n");
 }
 
+// check_vma_struct_rb - check the redblack tree of vma with thousands of vma inserted out of order
+static void
+check_vma_struct_rb(void) {
+    size_t nr_free_pages_store = nr_free_pages();
+
+    struct mm_struct *mm = mm_create();
+    assert(mm != NULL);
+
+    // 1009 is coprime to total, so j walks through [0, total) out of order
+    int total = 4000, i, j;
+    for (i = 0; i < total; i ++) {
+        j = (i * 1009) % total + 1;
+        struct vma_struct *vma = vma_create(j * 5, j * 5 + 2, 0);
+        assert(vma != NULL);
+        insert_vma_struct(mm, vma);
+        if (i + 1 < RB_MIN_MAP_COUNT) {
+            assert(mm->mmap_tree == NULL);
+        }
+    }
+    assert(mm->mmap_tree != NULL && mm->map_count == total);
+
+    list_entry_t *le = list_next(&(mm->mmap_list));
+    rb_node *node = rb_node_root(mm->mmap_tree);
+    while (rb_node_left(mm->mmap_tree, node) != NULL) {
+        node = rb_node_left(mm->mmap_tree, node);
+    }
+
+    for (i = 1; i <= total; i ++) {
+        assert(le != &(mm->mmap_list) && node != NULL);
+        struct vma_struct *mmap = le2vma(le, list_link);
+        assert(mmap->vm_start == i * 5 && mmap->vm_end == i * 5 + 2);
+        assert(rbn2vma(node, rb_link) == mmap);
+        le = list_next(le);
+        node = rb_node_next(mm->mmap_tree, node);
+    }
+    assert(le == &(mm->mmap_list) && node == NULL);
+
+    for (i = total * 5; i >= 0; i --) {
+        struct vma_struct *vma = find_vma(mm, i);
+        if (i >= 5 && i % 5 < 2) {
+            assert(vma != NULL && vma->vm_start == i - i % 5);
+        }
+        else {
+            assert(vma == NULL);
+        }
+    }
+
+    mm_destroy(mm);
+
+    assert(nr_free_pages_store == nr_free_pages());
+
+    cprintf("check_vma_struct_rb() succeeded!\n");
+}
+
 struct mm_struct *check_mm_struct;
 
 // check_pgfault - check correctness of pgfault handler
@@ -368,6 +647,127 @@ check_pgfault(void) {
 
     cprintf("check_pgfault() succeeded!\n");
 }
+
+// check_cow - check copy on write of the pages shared by copy_range
+static void
+check_cow(void) {
+    size_t nr_free_pages_store = nr_free_pages();
+
+    check_mm_struct = mm_create();
+    assert(check_mm_struct != NULL);
+
+    struct mm_struct *mm = check_mm_struct;
+    pde_t *pgdir = mm->pgdir = boot_pgdir;
+    assert(pgdir[0] == 0);
+
+    struct vma_struct *vma = vma_create(USERBASE, USERBASE + PGSIZE, VM_READ | VM_WRITE);
+    assert(vma != NULL);
+
+    insert_vma_struct(mm, vma);
+
+    uintptr_t addr = USERBASE + 0x100;
+    *(char *)addr = 'a';
+
+    struct Page *page, *p;
+    pte_t *ptep, *nptep;
+    assert((page = get_page(pgdir, USERBASE, &ptep)) != NULL && (*ptep & PTE_W));
+
+    // a fake page directory of the child
+    struct Page *pd = alloc_page();
+    assert(pd != NULL);
+    pde_t *npgdir = page2kva(pd);
+    memset(npgdir, 0, PGSIZE);
+
+    // the last user of a shared page gets it back without copy
+    assert(copy_range(npgdir, pgdir, USERBASE, USERBASE + PGSIZE, 1) == 0);
+    assert((nptep = get_pte(npgdir, USERBASE, 0)) != NULL && pte2page(*nptep) == page);
+    assert(page_ref(page) == 2 && !(*ptep & PTE_W) && !(*nptep & PTE_W));
+    page_remove(npgdir, USERBASE);
+    assert(page_ref(page) == 1);
+    *(char *)addr = 'b';
+    assert(get_page(pgdir, USERBASE, NULL) == page && (*ptep & PTE_W));
+
+    // write to a shared page copies it, read doesn't
+    assert(copy_range(npgdir, pgdir, USERBASE, USERBASE + PGSIZE, 1) == 0);
+    assert(page_ref(page) == 2 && !(*ptep & PTE_W));
+    assert(*(char *)addr == 'b');
+    assert(page_ref(page) == 2 && !(*ptep & PTE_W));
+    *(char *)addr = 'c';
+    assert((p = get_page(pgdir, USERBASE, NULL)) != page && (*ptep & PTE_W));
+    assert(page_ref(page) == 1 && page_ref(p) == 1);
+    assert(*(char *)(page2kva(page) + 0x100) == 'b');
+    assert(*(char *)(page2kva(p) + 0x100) == 'c');
+
+    page_remove(npgdir, USERBASE);
+    free_page(pde2page(npgdir[0]));
+    free_page(pd);
+
+    page_remove(pgdir, USERBASE);
+    free_page(pde2page(pgdir[0]));
+    pgdir[0] = 0;
+
+    mm->pgdir = NULL;
+    mm_destroy(mm);
+    check_mm_struct = NULL;
+
+    assert(nr_free_pages_store == nr_free_pages());
+
+    cprintf("check_cow() succeeded!\n");
+}
+// check_mm_unmap - check mm_unmap, mm_brk and get_unmapped_area
+static void
+check_mm_unmap(void) {
+    size_t nr_free_pages_store = nr_free_pages();
+
+    struct mm_struct *mm = mm_create();
+    assert(mm != NULL);
+
+    // no page is mapped here, unmap_range only walks the empty page directory
+    struct Page *pd = alloc_page();
+    assert(pd != NULL);
+    mm->pgdir = page2kva(pd);
+    memset(mm->pgdir, 0, PGSIZE);
+
+    uintptr_t base = USERBASE + PTSIZE;
+    struct vma_struct *vma, *vma2;
+    assert(mm_map(mm, base, 8 * PGSIZE, VM_READ, &vma) == 0);
+    assert(mm_map(mm, base + 7 * PGSIZE, 2 * PGSIZE, VM_READ, NULL) == -E_INVAL);
+    assert(mm_map(mm, base - PGSIZE, 2 * PGSIZE, VM_READ, NULL) == -E_INVAL);
+
+    // split [base, base + 8 pages) into [base, +2) and [+4, +8)
+    assert(mm_unmap(mm, base + 2 * PGSIZE, 2 * PGSIZE) == 0);
+    assert(mm->map_count == 2 && vma->vm_start == base && vma->vm_end == base + 2 * PGSIZE);
+    assert((vma2 = find_vma(mm, base + 4 * PGSIZE)) != NULL && vma2 != vma);
+    assert(vma2->vm_start == base + 4 * PGSIZE && vma2->vm_end == base + 8 * PGSIZE);
+    assert(find_vma(mm, base + 3 * PGSIZE) == NULL);
+
+    // cut both vmas at the boundary, then remove the rest
+    assert(mm_unmap(mm, base + PGSIZE, 4 * PGSIZE) == 0);
+    assert(vma->vm_end == base + PGSIZE && vma2->vm_start == base + 5 * PGSIZE);
+    assert(mm_unmap(mm, base - PGSIZE, 16 * PGSIZE) == 0);
+    assert(mm->map_count == 0 && list_empty(&(mm->mmap_list)));
+    assert(mm_unmap(mm, base, PGSIZE) == 0);
+
+    // the heap grows in the same vma
+    assert(mm_brk(mm, base, PGSIZE) == 0 && mm_brk(mm, base + PGSIZE, PGSIZE) == 0);
+    assert(mm->map_count == 1 && (vma = find_vma(mm, base)) != NULL);
+    assert(vma->vm_start == base && vma->vm_end == base + 2 * PGSIZE);
+    assert(mm_brk(mm, base + PGSIZE, PGSIZE) != 0);
+
+    uintptr_t addr = get_unmapped_area(mm, 3 * PGSIZE);
+    assert(addr == USERTOP - 3 * PGSIZE);
+    assert(mm_map(mm, addr, 3 * PGSIZE, VM_READ, NULL) == 0);
+    assert(get_unmapped_area(mm, PGSIZE) == addr - PGSIZE);
+
+    free_page(pd);
+    mm->pgdir = NULL;
+    mm_destroy(mm);
+
+    assert(nr_free_pages_store == nr_free_pages());
+
+    cprintf("check_mm_unmap() succeeded!\n");
+}
+
 //page fault number
 volatile unsigned int pgfault_num=0;
 
@@ -505,39 +905,55 @@ do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr) {
     }
     
     if (*ptep == 0) { // if the phy addr isn't exist, then alloc a page & map the phy addr with logical addr
-        if (pgdir_alloc_page(mm->pgdir, addr, perm) == NULL) {
+        struct Page *page;
+        if ((page = pgdir_alloc_page(mm->pgdir, addr, perm)) == NULL) {
             cprintf("pgdir_alloc_page in do_pgfault failed\n");
             goto failed;
         }
+        // anonymous memory (heap, mmap, stack) is always seen as zero at first
+        memset(page2kva(page), 0, PGSIZE);
+    }
+    else if (*ptep & PTE_P) {
+        //if process write to this existed readonly page (PTE_P means existed), then should be here now.
+        //the page is shared with other processes by copy_range since fork (AKA copy on write, COW).
+        struct Page *page = pte2page(*ptep);
+        if (page_ref(page) == 1) {
+            // no one else uses this page now, just make it writable again
+            *ptep |= PTE_W;
+            tlb_invalidate(mm->pgdir, addr);
+        }
+        else {
+            struct Page *npage;
+            if ((npage = alloc_page()) == NULL) {
+                cprintf("alloc_page in do_pgfault (COW) failed\n");
+                goto failed;
+            }
+            memcpy(page2kva(npage), page2kva(page), PGSIZE);
+            if (page_insert(mm->pgdir, npage, addr, perm) != 0) {
+                free_page(npage);
+                goto failed;
+            }
+        }
     }
     else {
+        // if this pte is a swap entry, then load data from disk to a page with phy addr
+        // and call page_insert to map the phy addr with logical addr
         struct Page *page=NULL;
         cprintf("do pgfault: ptep %x, pte %x\n",ptep, *ptep);
-        if (*ptep & PTE_P) {
-            //if process write to this existed readonly page (PTE_P means existed), then should be here now.
-            //we can implement the delayed memory space copy for fork child process (AKA copy on write, COW).
-            //we didn't implement now, we will do it in future.
-            panic("error write a non-writable pte");
-            //page = pte2page(*ptep);
-        } else{
-           // if this pte is a swap entry, then load data from disk to a page with phy addr
-           // and call page_insert to map the phy addr with logical addr
-           if(swap_init_ok) {               
-               if ((ret = swap_in(mm, addr, &page)) != 0) {
-                   cprintf("swap_in in do_pgfault failed\n");
-                   goto failed;
-               }    
-
-           }  
-           else {
+        if(swap_init_ok) {
+            if ((ret = swap_in(mm, addr, &page)) != 0) {
+                cprintf("swap_in in do_pgfault failed\n");
+                goto failed;
+            }
+        }
+        else {
             cprintf("no swap_init_ok but ptep is %x, failed\n",*ptep);
             goto failed;
-           }
-       } 
-       page_insert(mm->pgdir, page, addr, perm);
-       swap_map_swappable(mm, addr, page, 1);
-       page->pra_vaddr = addr;
-   }
+        }
+        page_insert(mm->pgdir, page, addr, perm);
+        swap_map_swappable(mm, addr, page, 1);
+        page->pra_vaddr = addr;
+    }
    ret = 0;
 failed:
     return ret;
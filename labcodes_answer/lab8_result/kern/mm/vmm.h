@@ -7,6 +7,7 @@
 #include <sync.h>
 #include <proc.h>
 #include <sem.h>
+#include <rb_tree.h>
 
 //pre define
 struct mm_struct;
@@ -18,19 +19,26 @@ struct vma_struct {
     uintptr_t vm_end;        // end addr of vma
     uint32_t vm_flags;       // flags of vma
     list_entry_t list_link;  // linear list link which sorted by start addr of vma
+    rb_node rb_link;         // redblack tree link which sorted by start addr of vma
 };
 
 #define le2vma(le, member)                  \
     to_struct((le), struct vma_struct, member)
 
+#define rbn2vma(node, member)               \
+    to_struct((node), struct vma_struct, member)
+
 #define VM_READ                 0x00000001
 #define VM_WRITE                0x00000002
 #define VM_EXEC                 0x00000004
 #define VM_STACK                0x00000008
 
+#define RB_MIN_MAP_COUNT        32 // If the count of vma >32 then redblack tree link is used
+
 // the control struct for a set of vma using the same PDT
 struct mm_struct {
     list_entry_t mmap_list;        // linear list link which sorted by start addr of vma
+    rb_tree *mmap_tree;            // redblack tree link which sorted by start addr of vma
     struct vma_struct *mmap_cache; // current accessed vma, used for speed purpose
     pde_t *pgdir;                  // the PDT of these vma
     int map_count;                 // the count of these vma
@@ -38,7 +46,8 @@ struct mm_struct {
     int mm_count;                  // the number ofprocess which shared the mm
     semaphore_t mm_sem;            // mutex for using dup_mmap fun to duplicat the mm 
     int locked_by;                 // the lock owner process's pid
-
+    uintptr_t brk_start;           // the start addr of heap, right after the highest ELF segment
+    uintptr_t brk;                 // the current end of heap (program break), page aligned
 };
 
 struct vma_struct *find_vma(struct mm_struct *mm, uintptr_t addr);
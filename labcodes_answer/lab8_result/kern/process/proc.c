@@ -81,6 +81,8 @@ struct proc_struct *current = NULL;
 
 static int nr_process = 0;
 
+static kmem_cache_t *proc_cachep;
+
 void kernel_thread_entry(void);
 void forkrets(struct trapframe *tf);
 void switch_to(struct context *from, struct context *to);
@@ -88,7 +90,7 @@ void switch_to(struct context *from, struct context *to);
 // alloc_proc - alloc a proc_struct and init all fields of proc_struct
 static struct proc_struct *
 alloc_proc(void) {
-    struct proc_struct *proc = kmalloc(sizeof(struct proc_struct));
+    struct proc_struct *proc = kmem_cache_alloc(proc_cachep);
     if (proc != NULL) {
     //LAB4:EXERCISE1 YOUR CODE
     /*
@@ -509,7 +511,7 @@ bad_fork_cleanup_fs:  //for LAB8
 bad_fork_cleanup_kstack:
     put_kstack(proc);
 bad_fork_cleanup_proc:
-    kfree(proc);
+    kmem_cache_free(proc_cachep, proc);
     goto fork_out;
 }
 
@@ -686,6 +688,9 @@ load_icode(int fd, int argc, char **kargv) {
             start += size, offset += size;
         }
         end = ph->p_va + ph->p_memsz;
+        if (mm->brk_start < end) {
+            mm->brk_start = end;
+        }
 
         if (start < la) {
             /* ph->p_memsz == ph->p_filesz */
@@ -715,6 +720,9 @@ load_icode(int fd, int argc, char **kargv) {
     }
     sysfile_close(fd);
 
+    // the heap is empty at first, it is grown by sys_brk right after the program
+    mm->brk_start = mm->brk = ROUNDUP(mm->brk_start, PGSIZE);
+
     vm_flags = VM_READ | VM_WRITE | VM_STACK;
     if ((ret = mm_map(mm, USTACKTOP - USTACKSIZE, USTACKSIZE, vm_flags, NULL)) != 0) {
         goto bad_cleanup_mmap;
@@ -931,7 +939,7 @@ found:
     }
     local_intr_restore(intr_flag);
     put_kstack(proc);
-    kfree(proc);
+    kmem_cache_free(proc_cachep, proc);
     return 0;
 }
 
@@ -952,6 +960,107 @@ do_kill(int pid) {
     return -E_INVAL;
 }
 
+// do_brk - set the program break of current process to *brk_store (rounded up to page),
+//        - and store the resulting break back in *brk_store. the heap never shrinks below
+//        - mm->brk_start, so brk(0) can be used to get the current break.
+int
+do_brk(uintptr_t *brk_store) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call sys_brk!!.\n");
+    }
+    if (brk_store == NULL) {
+        return -E_INVAL;
+    }
+
+    int ret = -E_INVAL;
+    uintptr_t brk;
+    lock_mm(mm);
+    if (!copy_from_user(mm, &brk, brk_store, sizeof(uintptr_t), 1)) {
+        goto out_unlock;
+    }
+    if (brk >= mm->brk_start) {
+        uintptr_t newbrk = ROUNDUP(brk, PGSIZE), oldbrk = mm->brk;
+        if (newbrk < oldbrk) {
+            if (mm_unmap(mm, newbrk, oldbrk - newbrk) == 0) {
+                mm->brk = newbrk;
+            }
+        }
+        else if (newbrk > oldbrk) {
+            if (mm_brk(mm, oldbrk, newbrk - oldbrk) == 0) {
+                mm->brk = newbrk;
+            }
+        }
+    }
+    ret = copy_to_user(mm, brk_store, &(mm->brk), sizeof(uintptr_t)) ? 0 : -E_INVAL;
+
+out_unlock:
+    unlock_mm(mm);
+    return ret;
+}
+
+// do_mmap - map len bytes of anonymous memory at *addr_store, if *addr_store is 0, find a free
+//         - range for it, and store the start addr of the mapping in *addr_store.
+//         - the pages are allocated by do_pgfault when they are accessed.
+int
+do_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call sys_mmap!!.\n");
+    }
+    if (addr_store == NULL || len == 0) {
+        return -E_INVAL;
+    }
+
+    int ret = -E_INVAL;
+    uintptr_t addr;
+    lock_mm(mm);
+    if (!copy_from_user(mm, &addr, addr_store, sizeof(uintptr_t), 1)) {
+        goto out_unlock;
+    }
+
+    uintptr_t start = ROUNDDOWN(addr, PGSIZE), end = ROUNDUP(addr + len, PGSIZE);
+    addr = start, len = end - start;
+
+    uint32_t vm_flags = VM_READ;
+    if (mmap_flags & MMAP_WRITE) vm_flags |= VM_WRITE;
+    if (mmap_flags & MMAP_STACK) vm_flags |= VM_STACK;
+
+    if (addr == 0) {
+        ret = -E_NO_MEM;
+        if ((addr = get_unmapped_area(mm, len)) == 0) {
+            goto out_unlock;
+        }
+    }
+    if ((ret = mm_map(mm, addr, len, vm_flags, NULL)) == 0) {
+        if (!copy_to_user(mm, addr_store, &addr, sizeof(uintptr_t))) {
+            mm_unmap(mm, addr, len);
+            ret = -E_INVAL;
+        }
+    }
+
+out_unlock:
+    unlock_mm(mm);
+    return ret;
+}
+
+// do_munmap - remove the mapping of [addr, addr + len) of current process
+int
+do_munmap(uintptr_t addr, size_t len) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call sys_munmap!!.\n");
+    }
+    if (len == 0) {
+        return -E_INVAL;
+    }
+    int ret;
+    lock_mm(mm);
+    ret = mm_unmap(mm, addr, len);
+    unlock_mm(mm);
+    return ret;
+}
+
 // kernel_execve - do SYS_exec syscall to exec a user program called by user_main kernel_thread
 static int
 kernel_execve(const char *name, const char **argv) {
@@ -1005,6 +1114,7 @@ init_main(void *arg) {
         panic("set boot fs failed: %e.\n", ret);
     }
     
+    kmem_cache_reap();
     size_t nr_free_pages_store = nr_free_pages();
     size_t kernel_allocated_store = kallocated();
 
@@ -1012,10 +1122,18 @@ init_main(void *arg) {
     if (pid <= 0) {
         panic("create user_main failed.\n");
     }
+    int wbpid = fs_writeback_start();
+    if (wbpid <= 0) {
+        panic("create writeback failed.\n");
+    }
  extern void check_sync(void);
     check_sync();                // check philosopher sync problem
 
     while (do_wait(0, NULL) == 0) {
+        // the writeback thread is the last child to quit
+        if (current->cptr != NULL && current->cptr->pid == wbpid && current->cptr->optr == NULL) {
+            fs_writeback_stop();
+        }
         schedule();
     }
 
@@ -1026,6 +1144,7 @@ init_main(void *arg) {
     assert(nr_process == 2);
     assert(list_next(&proc_list) == &(initproc->list_link));
     assert(list_prev(&proc_list) == &(initproc->list_link));
+    kmem_cache_reap();
     assert(nr_free_pages_store == nr_free_pages());
     assert(kernel_allocated_store == kallocated());
     cprintf("init check memory pass.\n");
@@ -1043,6 +1162,10 @@ proc_init(void) {
         list_init(hash_list + i);
     }
 
+    if ((proc_cachep = kmem_cache_create("proc_struct", sizeof(struct proc_struct), NULL)) == NULL) {
+        panic("cannot create proc cache.\n");
+    }
+
     if ((idleproc = alloc_proc()) == NULL) {
         panic("cannot alloc idleproc.\n");
     }
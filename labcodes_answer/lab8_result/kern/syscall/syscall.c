@@ -9,6 +9,7 @@
 #include <clock.h>
 #include <stat.h>
 #include <dirent.h>
+#include <uio.h>
 #include <sysfile.h>
 
 static int
@@ -55,6 +56,27 @@ sys_getpid(uint32_t arg[]) {
     return current->pid;
 }
 
+static int
+sys_brk(uint32_t arg[]) {
+    uintptr_t *brk_store = (uintptr_t *)arg[0];
+    return do_brk(brk_store);
+}
+
+static int
+sys_mmap(uint32_t arg[]) {
+    uintptr_t *addr_store = (uintptr_t *)arg[0];
+    size_t len = (size_t)arg[1];
+    uint32_t mmap_flags = (uint32_t)arg[2];
+    return do_mmap(addr_store, len, mmap_flags);
+}
+
+static int
+sys_munmap(uint32_t arg[]) {
+    uintptr_t addr = (uintptr_t)arg[0];
+    size_t len = (size_t)arg[1];
+    return do_munmap(addr, len);
+}
+
 static int
 sys_putc(uint32_t arg[]) {
     int c = (int)arg[0];
@@ -115,6 +137,40 @@ sys_write(uint32_t arg[]) {
     return sysfile_write(fd, base, len);
 }
 
+static int
+sys_pread(uint32_t arg[]) {
+    int fd = (int)arg[0];
+    void *base = (void *)arg[1];
+    size_t len = (size_t)arg[2];
+    off_t pos = (off_t)arg[3];
+    return sysfile_pread(fd, base, len, pos);
+}
+
+static int
+sys_pwrite(uint32_t arg[]) {
+    int fd = (int)arg[0];
+    void *base = (void *)arg[1];
+    size_t len = (size_t)arg[2];
+    off_t pos = (off_t)arg[3];
+    return sysfile_pwrite(fd, base, len, pos);
+}
+
+static int
+sys_readv(uint32_t arg[]) {
+    int fd = (int)arg[0];
+    struct iovec *iov = (struct iovec *)arg[1];
+    int iovcnt = (int)arg[2];
+    return sysfile_readv(fd, iov, iovcnt);
+}
+
+static int
+sys_writev(uint32_t arg[]) {
+    int fd = (int)arg[0];
+    struct iovec *iov = (struct iovec *)arg[1];
+    int iovcnt = (int)arg[2];
+    return sysfile_writev(fd, iov, iovcnt);
+}
+
 static int
 sys_seek(uint32_t arg[]) {
     int fd = (int)arg[0];
@@ -136,6 +192,14 @@ sys_fsync(uint32_t arg[]) {
     return sysfile_fsync(fd);
 }
 
+static int
+sys_fallocate(uint32_t arg[]) {
+    int fd = (int)arg[0];
+    off_t pos = (off_t)arg[1];
+    off_t len = (off_t)arg[2];
+    return sysfile_fallocate(fd, pos, len);
+}
+
 static int
 sys_getcwd(uint32_t arg[]) {
     char *buf = (char *)arg[0];
@@ -165,6 +229,9 @@ static int (*syscalls[])(uint32_t arg[]) = {
     [SYS_yield]             sys_yield,
     [SYS_kill]              sys_kill,
     [SYS_getpid]            sys_getpid,
+    [SYS_brk]               sys_brk,
+    [SYS_mmap]              sys_mmap,
+    [SYS_munmap]            sys_munmap,
     [SYS_putc]              sys_putc,
     [SYS_pgdir]             sys_pgdir,
     [SYS_gettime]           sys_gettime,
@@ -175,8 +242,13 @@ static int (*syscalls[])(uint32_t arg[]) = {
     [SYS_read]              sys_read,
     [SYS_write]             sys_write,
     [SYS_seek]              sys_seek,
+    [SYS_pread]             sys_pread,
+    [SYS_pwrite]            sys_pwrite,
+    [SYS_readv]             sys_readv,
+    [SYS_writev]            sys_writev,
     [SYS_fstat]             sys_fstat,
     [SYS_fsync]             sys_fsync,
+    [SYS_fallocate]         sys_fallocate,
     [SYS_getcwd]            sys_getcwd,
     [SYS_getdirentry]       sys_getdirentry,
     [SYS_dup]               sys_dup,
@@ -0,0 +1,15 @@
+#ifndef __LIBS_UIO_H__
+#define __LIBS_UIO_H__
+
+#include <defs.h>
+
+/* a segment of buffer for readv/writev */
+struct iovec {
+    void *iov_base;     // the base addr of segment
+    size_t iov_len;     // the length of segment
+};
+
+#define UIO_MAXIOV          64          // max # of segments in one readv/writev
+
+#endif /* !__LIBS_UIO_H__ */
+
@@ -14,6 +14,7 @@
 #define SYS_kill            12
 #define SYS_gettime         17
 #define SYS_getpid          18
+#define SYS_brk             19
 #define SYS_mmap            20
 #define SYS_munmap          21
 #define SYS_shmem           22
@@ -24,8 +25,13 @@
 #define SYS_read            102
 #define SYS_write           103
 #define SYS_seek            104
+#define SYS_pread           105
+#define SYS_pwrite          106
+#define SYS_readv           107
+#define SYS_writev          108
 #define SYS_fstat           110
 #define SYS_fsync           111
+#define SYS_fallocate       112
 #define SYS_getcwd          121
 #define SYS_getdirentry     128
 #define SYS_dup             130
@@ -37,6 +43,10 @@
 #define CLONE_THREAD        0x00000200  // thread group
 #define CLONE_FS            0x00000800  // set if shared between processes
 
+/* SYS_mmap flags */
+#define MMAP_WRITE          0x00000100  // the mapping is writable
+#define MMAP_STACK          0x00000200  // the mapping is used as a stack
+
 /* VFS flags */
 // flags for open: choose one of these
 #define O_RDONLY            0           // open for reading only
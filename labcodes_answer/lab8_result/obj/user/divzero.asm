@@ -0,0 +1,4898 @@
+
+obj/__user_divzero.out:     file format elf32-i386
+
+
+Disassembly of section .text:
+
+00800020 <opendir>:
+#include <error.h>
+#include <unistd.h>
+
+DIR dir, *dirp=&dir;
+DIR *
+opendir(const char *path) {
+  800020:	55                   	push   %ebp
+  800021:	89 e5                	mov    %esp,%ebp
+  800023:	53                   	push   %ebx
+  800024:	83 ec 24             	sub    $0x24,%esp
+
+    if ((dirp->fd = open(path, O_RDONLY)) < 0) {
+  800027:	8b 1d 00 30 80 00    	mov    0x803000,%ebx
+  80002d:	83 ec 08             	sub    $0x8,%esp
+  800030:	6a 00                	push   $0x0
+  800032:	ff 75 08             	push   0x8(%ebp)
+  800035:	e8 c1 00 00 00       	call   8000fb <open>
+  80003a:	83 c4 10             	add    $0x10,%esp
+  80003d:	89 03                	mov    %eax,(%ebx)
+  80003f:	8b 03                	mov    (%ebx),%eax
+  800041:	85 c0                	test   %eax,%eax
+  800043:	78 44                	js     800089 <opendir+0x69>
+        goto failed;
+    }
+    struct stat __stat, *stat = &__stat;
+  800045:	8d 45 e4             	lea    -0x1c(%ebp),%eax
+  800048:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (fstat(dirp->fd, stat) != 0 || !S_ISDIR(stat->st_mode)) {
+  80004b:	a1 00 30 80 00       	mov    0x803000,%eax
+  800050:	8b 00                	mov    (%eax),%eax
+  800052:	83 ec 08             	sub    $0x8,%esp
+  800055:	ff 75 f4             	push   -0xc(%ebp)
+  800058:	50                   	push   %eax
+  800059:	e8 90 01 00 00       	call   8001ee <fstat>
+  80005e:	83 c4 10             	add    $0x10,%esp
+  800061:	85 c0                	test   %eax,%eax
+  800063:	75 27                	jne    80008c <opendir+0x6c>
+  800065:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800068:	8b 00                	mov    (%eax),%eax
+  80006a:	25 00 70 00 00       	and    $0x7000,%eax
+  80006f:	3d 00 20 00 00       	cmp    $0x2000,%eax
+  800074:	75 16                	jne    80008c <opendir+0x6c>
+        goto failed;
+    }
+    dirp->dirent.offset = 0;
+  800076:	a1 00 30 80 00       	mov    0x803000,%eax
+  80007b:	c7 40 04 00 00 00 00 	movl   $0x0,0x4(%eax)
+    return dirp;
+  800082:	a1 00 30 80 00       	mov    0x803000,%eax
+  800087:	eb 09                	jmp    800092 <opendir+0x72>
+        goto failed;
+  800089:	90                   	nop
+  80008a:	eb 01                	jmp    80008d <opendir+0x6d>
+        goto failed;
+  80008c:	90                   	nop
+
+failed:
+    return NULL;
+  80008d:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  800092:	8b 5d fc             	mov    -0x4(%ebp),%ebx
+  800095:	c9                   	leave
+  800096:	c3                   	ret
+
+00800097 <readdir>:
+
+struct dirent *
+readdir(DIR *dirp) {
+  800097:	55                   	push   %ebp
+  800098:	89 e5                	mov    %esp,%ebp
+  80009a:	83 ec 08             	sub    $0x8,%esp
+    if (sys_getdirentry(dirp->fd, &(dirp->dirent)) == 0) {
+  80009d:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000a0:	8d 50 04             	lea    0x4(%eax),%edx
+  8000a3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000a6:	8b 00                	mov    (%eax),%eax
+  8000a8:	83 ec 08             	sub    $0x8,%esp
+  8000ab:	52                   	push   %edx
+  8000ac:	50                   	push   %eax
+  8000ad:	e8 e2 10 00 00       	call   801194 <sys_getdirentry>
+  8000b2:	83 c4 10             	add    $0x10,%esp
+  8000b5:	85 c0                	test   %eax,%eax
+  8000b7:	75 08                	jne    8000c1 <readdir+0x2a>
+        return &(dirp->dirent);
+  8000b9:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000bc:	83 c0 04             	add    $0x4,%eax
+  8000bf:	eb 05                	jmp    8000c6 <readdir+0x2f>
+    }
+    return NULL;
+  8000c1:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  8000c6:	c9                   	leave
+  8000c7:	c3                   	ret
+
+008000c8 <closedir>:
+
+void
+closedir(DIR *dirp) {
+  8000c8:	55                   	push   %ebp
+  8000c9:	89 e5                	mov    %esp,%ebp
+  8000cb:	83 ec 08             	sub    $0x8,%esp
+    close(dirp->fd);
+  8000ce:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000d1:	8b 00                	mov    (%eax),%eax
+  8000d3:	83 ec 0c             	sub    $0xc,%esp
+  8000d6:	50                   	push   %eax
+  8000d7:	e8 38 00 00 00       	call   800114 <close>
+  8000dc:	83 c4 10             	add    $0x10,%esp
+}
+  8000df:	90                   	nop
+  8000e0:	c9                   	leave
+  8000e1:	c3                   	ret
+
+008000e2 <getcwd>:
+
+int
+getcwd(char *buffer, size_t len) {
+  8000e2:	55                   	push   %ebp
+  8000e3:	89 e5                	mov    %esp,%ebp
+  8000e5:	83 ec 08             	sub    $0x8,%esp
+    return sys_getcwd(buffer, len);
+  8000e8:	83 ec 08             	sub    $0x8,%esp
+  8000eb:	ff 75 0c             	push   0xc(%ebp)
+  8000ee:	ff 75 08             	push   0x8(%ebp)
+  8000f1:	e8 89 10 00 00       	call   80117f <sys_getcwd>
+  8000f6:	83 c4 10             	add    $0x10,%esp
+}
+  8000f9:	c9                   	leave
+  8000fa:	c3                   	ret
+
+008000fb <open>:
+#include <stat.h>
+#include <error.h>
+#include <unistd.h>
+
+int
+open(const char *path, uint32_t open_flags) {
+  8000fb:	55                   	push   %ebp
+  8000fc:	89 e5                	mov    %esp,%ebp
+  8000fe:	83 ec 08             	sub    $0x8,%esp
+    return sys_open(path, open_flags);
+  800101:	83 ec 08             	sub    $0x8,%esp
+  800104:	ff 75 0c             	push   0xc(%ebp)
+  800107:	ff 75 08             	push   0x8(%ebp)
+  80010a:	e8 5c 0f 00 00       	call   80106b <sys_open>
+  80010f:	83 c4 10             	add    $0x10,%esp
+}
+  800112:	c9                   	leave
+  800113:	c3                   	ret
+
+00800114 <close>:
+
+int
+close(int fd) {
+  800114:	55                   	push   %ebp
+  800115:	89 e5                	mov    %esp,%ebp
+  800117:	83 ec 08             	sub    $0x8,%esp
+    return sys_close(fd);
+  80011a:	83 ec 0c             	sub    $0xc,%esp
+  80011d:	ff 75 08             	push   0x8(%ebp)
+  800120:	e8 5b 0f 00 00       	call   801080 <sys_close>
+  800125:	83 c4 10             	add    $0x10,%esp
+}
+  800128:	c9                   	leave
+  800129:	c3                   	ret
+
+0080012a <read>:
+
+int
+read(int fd, void *base, size_t len) {
+  80012a:	55                   	push   %ebp
+  80012b:	89 e5                	mov    %esp,%ebp
+  80012d:	83 ec 08             	sub    $0x8,%esp
+    return sys_read(fd, base, len);
+  800130:	83 ec 04             	sub    $0x4,%esp
+  800133:	ff 75 10             	push   0x10(%ebp)
+  800136:	ff 75 0c             	push   0xc(%ebp)
+  800139:	ff 75 08             	push   0x8(%ebp)
+  80013c:	e8 51 0f 00 00       	call   801092 <sys_read>
+  800141:	83 c4 10             	add    $0x10,%esp
+}
+  800144:	c9                   	leave
+  800145:	c3                   	ret
+
+00800146 <write>:
+
+int
+write(int fd, void *base, size_t len) {
+  800146:	55                   	push   %ebp
+  800147:	89 e5                	mov    %esp,%ebp
+  800149:	83 ec 08             	sub    $0x8,%esp
+    return sys_write(fd, base, len);
+  80014c:	83 ec 04             	sub    $0x4,%esp
+  80014f:	ff 75 10             	push   0x10(%ebp)
+  800152:	ff 75 0c             	push   0xc(%ebp)
+  800155:	ff 75 08             	push   0x8(%ebp)
+  800158:	e8 4d 0f 00 00       	call   8010aa <sys_write>
+  80015d:	83 c4 10             	add    $0x10,%esp
+}
+  800160:	c9                   	leave
+  800161:	c3                   	ret
+
+00800162 <pread>:
+
+int
+pread(int fd, void *base, size_t len, off_t pos) {
+  800162:	55                   	push   %ebp
+  800163:	89 e5                	mov    %esp,%ebp
+  800165:	83 ec 08             	sub    $0x8,%esp
+    return sys_pread(fd, base, len, pos);
+  800168:	ff 75 14             	push   0x14(%ebp)
+  80016b:	ff 75 10             	push   0x10(%ebp)
+  80016e:	ff 75 0c             	push   0xc(%ebp)
+  800171:	ff 75 08             	push   0x8(%ebp)
+  800174:	e8 49 0f 00 00       	call   8010c2 <sys_pread>
+  800179:	83 c4 10             	add    $0x10,%esp
+}
+  80017c:	c9                   	leave
+  80017d:	c3                   	ret
+
+0080017e <pwrite>:
+
+int
+pwrite(int fd, void *base, size_t len, off_t pos) {
+  80017e:	55                   	push   %ebp
+  80017f:	89 e5                	mov    %esp,%ebp
+  800181:	83 ec 08             	sub    $0x8,%esp
+    return sys_pwrite(fd, base, len, pos);
+  800184:	ff 75 14             	push   0x14(%ebp)
+  800187:	ff 75 10             	push   0x10(%ebp)
+  80018a:	ff 75 0c             	push   0xc(%ebp)
+  80018d:	ff 75 08             	push   0x8(%ebp)
+  800190:	e8 48 0f 00 00       	call   8010dd <sys_pwrite>
+  800195:	83 c4 10             	add    $0x10,%esp
+}
+  800198:	c9                   	leave
+  800199:	c3                   	ret
+
+0080019a <readv>:
+
+int
+readv(int fd, struct iovec *iov, int iovcnt) {
+  80019a:	55                   	push   %ebp
+  80019b:	89 e5                	mov    %esp,%ebp
+  80019d:	83 ec 08             	sub    $0x8,%esp
+    return sys_readv(fd, iov, iovcnt);
+  8001a0:	83 ec 04             	sub    $0x4,%esp
+  8001a3:	ff 75 10             	push   0x10(%ebp)
+  8001a6:	ff 75 0c             	push   0xc(%ebp)
+  8001a9:	ff 75 08             	push   0x8(%ebp)
+  8001ac:	e8 47 0f 00 00       	call   8010f8 <sys_readv>
+  8001b1:	83 c4 10             	add    $0x10,%esp
+}
+  8001b4:	c9                   	leave
+  8001b5:	c3                   	ret
+
+008001b6 <writev>:
+
+int
+writev(int fd, struct iovec *iov, int iovcnt) {
+  8001b6:	55                   	push   %ebp
+  8001b7:	89 e5                	mov    %esp,%ebp
+  8001b9:	83 ec 08             	sub    $0x8,%esp
+    return sys_writev(fd, iov, iovcnt);
+  8001bc:	83 ec 04             	sub    $0x4,%esp
+  8001bf:	ff 75 10             	push   0x10(%ebp)
+  8001c2:	ff 75 0c             	push   0xc(%ebp)
+  8001c5:	ff 75 08             	push   0x8(%ebp)
+  8001c8:	e8 43 0f 00 00       	call   801110 <sys_writev>
+  8001cd:	83 c4 10             	add    $0x10,%esp
+}
+  8001d0:	c9                   	leave
+  8001d1:	c3                   	ret
+
+008001d2 <seek>:
+
+int
+seek(int fd, off_t pos, int whence) {
+  8001d2:	55                   	push   %ebp
+  8001d3:	89 e5                	mov    %esp,%ebp
+  8001d5:	83 ec 08             	sub    $0x8,%esp
+    return sys_seek(fd, pos, whence);
+  8001d8:	83 ec 04             	sub    $0x4,%esp
+  8001db:	ff 75 10             	push   0x10(%ebp)
+  8001de:	ff 75 0c             	push   0xc(%ebp)
+  8001e1:	ff 75 08             	push   0x8(%ebp)
+  8001e4:	e8 3f 0f 00 00       	call   801128 <sys_seek>
+  8001e9:	83 c4 10             	add    $0x10,%esp
+}
+  8001ec:	c9                   	leave
+  8001ed:	c3                   	ret
+
+008001ee <fstat>:
+
+int
+fstat(int fd, struct stat *stat) {
+  8001ee:	55                   	push   %ebp
+  8001ef:	89 e5                	mov    %esp,%ebp
+  8001f1:	83 ec 08             	sub    $0x8,%esp
+    return sys_fstat(fd, stat);
+  8001f4:	83 ec 08             	sub    $0x8,%esp
+  8001f7:	ff 75 0c             	push   0xc(%ebp)
+  8001fa:	ff 75 08             	push   0x8(%ebp)
+  8001fd:	e8 3e 0f 00 00       	call   801140 <sys_fstat>
+  800202:	83 c4 10             	add    $0x10,%esp
+}
+  800205:	c9                   	leave
+  800206:	c3                   	ret
+
+00800207 <fsync>:
+
+int
+fsync(int fd) {
+  800207:	55                   	push   %ebp
+  800208:	89 e5                	mov    %esp,%ebp
+  80020a:	83 ec 08             	sub    $0x8,%esp
+    return sys_fsync(fd);
+  80020d:	83 ec 0c             	sub    $0xc,%esp
+  800210:	ff 75 08             	push   0x8(%ebp)
+  800213:	e8 3d 0f 00 00       	call   801155 <sys_fsync>
+  800218:	83 c4 10             	add    $0x10,%esp
+}
+  80021b:	c9                   	leave
+  80021c:	c3                   	ret
+
+0080021d <fallocate>:
+
+int
+fallocate(int fd, off_t pos, off_t len) {
+  80021d:	55                   	push   %ebp
+  80021e:	89 e5                	mov    %esp,%ebp
+  800220:	83 ec 08             	sub    $0x8,%esp
+    return sys_fallocate(fd, pos, len);
+  800223:	83 ec 04             	sub    $0x4,%esp
+  800226:	ff 75 10             	push   0x10(%ebp)
+  800229:	ff 75 0c             	push   0xc(%ebp)
+  80022c:	ff 75 08             	push   0x8(%ebp)
+  80022f:	e8 33 0f 00 00       	call   801167 <sys_fallocate>
+  800234:	83 c4 10             	add    $0x10,%esp
+}
+  800237:	c9                   	leave
+  800238:	c3                   	ret
+
+00800239 <dup2>:
+
+int
+dup2(int fd1, int fd2) {
+  800239:	55                   	push   %ebp
+  80023a:	89 e5                	mov    %esp,%ebp
+  80023c:	83 ec 08             	sub    $0x8,%esp
+    return sys_dup(fd1, fd2);
+  80023f:	83 ec 08             	sub    $0x8,%esp
+  800242:	ff 75 0c             	push   0xc(%ebp)
+  800245:	ff 75 08             	push   0x8(%ebp)
+  800248:	e8 5f 0f 00 00       	call   8011ac <sys_dup>
+  80024d:	83 c4 10             	add    $0x10,%esp
+}
+  800250:	c9                   	leave
+  800251:	c3                   	ret
+
+00800252 <transmode>:
+
+static char
+transmode(struct stat *stat) {
+  800252:	55                   	push   %ebp
+  800253:	89 e5                	mov    %esp,%ebp
+  800255:	83 ec 10             	sub    $0x10,%esp
+    uint32_t mode = stat->st_mode;
+  800258:	8b 45 08             	mov    0x8(%ebp),%eax
+  80025b:	8b 00                	mov    (%eax),%eax
+  80025d:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    if (S_ISREG(mode)) return 'r';
+  800260:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800263:	25 00 70 00 00       	and    $0x7000,%eax
+  800268:	3d 00 10 00 00       	cmp    $0x1000,%eax
+  80026d:	75 07                	jne    800276 <transmode+0x24>
+  80026f:	b8 72 00 00 00       	mov    $0x72,%eax
+  800274:	eb 5d                	jmp    8002d3 <transmode+0x81>
+    if (S_ISDIR(mode)) return 'd';
+  800276:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800279:	25 00 70 00 00       	and    $0x7000,%eax
+  80027e:	3d 00 20 00 00       	cmp    $0x2000,%eax
+  800283:	75 07                	jne    80028c <transmode+0x3a>
+  800285:	b8 64 00 00 00       	mov    $0x64,%eax
+  80028a:	eb 47                	jmp    8002d3 <transmode+0x81>
+    if (S_ISLNK(mode)) return 'l';
+  80028c:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80028f:	25 00 70 00 00       	and    $0x7000,%eax
+  800294:	3d 00 30 00 00       	cmp    $0x3000,%eax
+  800299:	75 07                	jne    8002a2 <transmode+0x50>
+  80029b:	b8 6c 00 00 00       	mov    $0x6c,%eax
+  8002a0:	eb 31                	jmp    8002d3 <transmode+0x81>
+    if (S_ISCHR(mode)) return 'c';
+  8002a2:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8002a5:	25 00 70 00 00       	and    $0x7000,%eax
+  8002aa:	3d 00 40 00 00       	cmp    $0x4000,%eax
+  8002af:	75 07                	jne    8002b8 <transmode+0x66>
+  8002b1:	b8 63 00 00 00       	mov    $0x63,%eax
+  8002b6:	eb 1b                	jmp    8002d3 <transmode+0x81>
+    if (S_ISBLK(mode)) return 'b';
+  8002b8:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8002bb:	25 00 70 00 00       	and    $0x7000,%eax
+  8002c0:	3d 00 50 00 00       	cmp    $0x5000,%eax
+  8002c5:	75 07                	jne    8002ce <transmode+0x7c>
+  8002c7:	b8 62 00 00 00       	mov    $0x62,%eax
+  8002cc:	eb 05                	jmp    8002d3 <transmode+0x81>
+    return '-';
+  8002ce:	b8 2d 00 00 00       	mov    $0x2d,%eax
+}
+  8002d3:	c9                   	leave
+  8002d4:	c3                   	ret
+
+008002d5 <print_stat>:
+
+void
+print_stat(const char *name, int fd, struct stat *stat) {
+  8002d5:	55                   	push   %ebp
+  8002d6:	89 e5                	mov    %esp,%ebp
+  8002d8:	83 ec 08             	sub    $0x8,%esp
+    cprintf("[%03d] %s\n", fd, name);
+  8002db:	83 ec 04             	sub    $0x4,%esp
+  8002de:	ff 75 08             	push   0x8(%ebp)
+  8002e1:	ff 75 0c             	push   0xc(%ebp)
+  8002e4:	68 e0 21 80 00       	push   $0x8021e0
+  8002e9:	e8 16 0b 00 00       	call   800e04 <cprintf>
+  8002ee:	83 c4 10             	add    $0x10,%esp
+    cprintf("    mode    : %c\n", transmode(stat));
+  8002f1:	83 ec 0c             	sub    $0xc,%esp
+  8002f4:	ff 75 10             	push   0x10(%ebp)
+  8002f7:	e8 56 ff ff ff       	call   800252 <transmode>
+  8002fc:	83 c4 10             	add    $0x10,%esp
+  8002ff:	0f be c0             	movsbl %al,%eax
+  800302:	83 ec 08             	sub    $0x8,%esp
+  800305:	50                   	push   %eax
+  800306:	68 eb 21 80 00       	push   $0x8021eb
+  80030b:	e8 f4 0a 00 00       	call   800e04 <cprintf>
+  800310:	83 c4 10             	add    $0x10,%esp
+    cprintf("    links   : %lu\n", stat->st_nlinks);
+  800313:	8b 45 10             	mov    0x10(%ebp),%eax
+  800316:	8b 40 04             	mov    0x4(%eax),%eax
+  800319:	83 ec 08             	sub    $0x8,%esp
+  80031c:	50                   	push   %eax
+  80031d:	68 fd 21 80 00       	push   $0x8021fd
+  800322:	e8 dd 0a 00 00       	call   800e04 <cprintf>
+  800327:	83 c4 10             	add    $0x10,%esp
+    cprintf("    blocks  : %lu\n", stat->st_blocks);
+  80032a:	8b 45 10             	mov    0x10(%ebp),%eax
+  80032d:	8b 40 08             	mov    0x8(%eax),%eax
+  800330:	83 ec 08             	sub    $0x8,%esp
+  800333:	50                   	push   %eax
+  800334:	68 10 22 80 00       	push   $0x802210
+  800339:	e8 c6 0a 00 00       	call   800e04 <cprintf>
+  80033e:	83 c4 10             	add    $0x10,%esp
+    cprintf("    size    : %lu\n", stat->st_size);
+  800341:	8b 45 10             	mov    0x10(%ebp),%eax
+  800344:	8b 40 0c             	mov    0xc(%eax),%eax
+  800347:	83 ec 08             	sub    $0x8,%esp
+  80034a:	50                   	push   %eax
+  80034b:	68 23 22 80 00       	push   $0x802223
+  800350:	e8 af 0a 00 00       	call   800e04 <cprintf>
+  800355:	83 c4 10             	add    $0x10,%esp
+}
+  800358:	90                   	nop
+  800359:	c9                   	leave
+  80035a:	c3                   	ret
+
+0080035b <_start>:
+.text
+.globl _start
+_start:
+    # set ebp for backtrace
+    movl $0x0, %ebp
+  80035b:	bd 00 00 00 00       	mov    $0x0,%ebp
+
+    # load argc and argv
+    movl (%esp), %ebx
+  800360:	8b 1c 24             	mov    (%esp),%ebx
+    lea 0x4(%esp), %ecx
+  800363:	8d 4c 24 04          	lea    0x4(%esp),%ecx
+
+
+    # move down the esp register
+    # since it may cause page fault in backtrace
+    subl $0x20, %esp
+  800367:	83 ec 20             	sub    $0x20,%esp
+
+    # save argc and argv on stack
+    pushl %ecx
+  80036a:	51                   	push   %ecx
+    pushl %ebx
+  80036b:	53                   	push   %ebx
+
+    # call user-program function
+    call umain
+  80036c:	e8 66 11 00 00       	call   8014d7 <umain>
+1:  jmp 1b
+  800371:	eb fe                	jmp    800371 <_start+0x16>
+
+00800373 <try_lock>:
+lock_init(lock_t *l) {
+    *l = 0;
+}
+
+static inline bool
+try_lock(lock_t *l) {
+  800373:	55                   	push   %ebp
+  800374:	89 e5                	mov    %esp,%ebp
+  800376:	83 ec 10             	sub    $0x10,%esp
+  800379:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+  800380:	8b 45 08             	mov    0x8(%ebp),%eax
+  800383:	89 45 f8             	mov    %eax,-0x8(%ebp)
+ * @addr:   the address to count from
+ * */
+static inline bool
+test_and_set_bit(int nr, volatile void *addr) {
+    int oldbit;
+    asm volatile ("btsl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  800386:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  800389:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80038c:	0f ab 02             	bts    %eax,(%edx)
+  80038f:	19 c0                	sbb    %eax,%eax
+  800391:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    return oldbit != 0;
+  800394:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  800398:	0f 95 c0             	setne  %al
+  80039b:	0f b6 c0             	movzbl %al,%eax
+    return test_and_set_bit(0, l);
+}
+  80039e:	c9                   	leave
+  80039f:	c3                   	ret
+
+008003a0 <lock>:
+
+static inline void
+lock(lock_t *l) {
+  8003a0:	55                   	push   %ebp
+  8003a1:	89 e5                	mov    %esp,%ebp
+  8003a3:	83 ec 18             	sub    $0x18,%esp
+    if (try_lock(l)) {
+  8003a6:	ff 75 08             	push   0x8(%ebp)
+  8003a9:	e8 c5 ff ff ff       	call   800373 <try_lock>
+  8003ae:	83 c4 04             	add    $0x4,%esp
+  8003b1:	85 c0                	test   %eax,%eax
+  8003b3:	74 3c                	je     8003f1 <lock+0x51>
+        int step = 0;
+  8003b5:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+        do {
+            yield();
+  8003bc:	e8 3c 0f 00 00       	call   8012fd <yield>
+            if (++ step == 100) {
+  8003c1:	83 45 f4 01          	addl   $0x1,-0xc(%ebp)
+  8003c5:	83 7d f4 64          	cmpl   $0x64,-0xc(%ebp)
+  8003c9:	75 14                	jne    8003df <lock+0x3f>
+                step = 0;
+  8003cb:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+                sleep(10);
+  8003d2:	83 ec 0c             	sub    $0xc,%esp
+  8003d5:	6a 0a                	push   $0xa
+  8003d7:	e8 38 10 00 00       	call   801414 <sleep>
+  8003dc:	83 c4 10             	add    $0x10,%esp
+            }
+        } while (try_lock(l));
+  8003df:	83 ec 0c             	sub    $0xc,%esp
+  8003e2:	ff 75 08             	push   0x8(%ebp)
+  8003e5:	e8 89 ff ff ff       	call   800373 <try_lock>
+  8003ea:	83 c4 10             	add    $0x10,%esp
+  8003ed:	85 c0                	test   %eax,%eax
+  8003ef:	75 cb                	jne    8003bc <lock+0x1c>
+    }
+}
+  8003f1:	90                   	nop
+  8003f2:	c9                   	leave
+  8003f3:	c3                   	ret
+
+008003f4 <unlock>:
+
+static inline void
+unlock(lock_t *l) {
+  8003f4:	55                   	push   %ebp
+  8003f5:	89 e5                	mov    %esp,%ebp
+  8003f7:	83 ec 10             	sub    $0x10,%esp
+  8003fa:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+  800401:	8b 45 08             	mov    0x8(%ebp),%eax
+  800404:	89 45 f8             	mov    %eax,-0x8(%ebp)
+ * @addr:   the address to count from
+ * */
+static inline bool
+test_and_clear_bit(int nr, volatile void *addr) {
+    int oldbit;
+    asm volatile ("btrl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  800407:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  80040a:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80040d:	0f b3 02             	btr    %eax,(%edx)
+  800410:	19 c0                	sbb    %eax,%eax
+  800412:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    return oldbit != 0;
+  800415:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+    test_and_clear_bit(0, l);
+}
+  800419:	90                   	nop
+  80041a:	c9                   	leave
+  80041b:	c3                   	ret
+
+0080041c <size2class>:
+static list_entry_t heap_free_list = {&heap_free_list, &heap_free_list};
+static char *heap_end;                  // end of the last heap region, right after its epilogue
+static lock_t malloc_lock = INIT_LOCK;
+
+static inline int
+size2class(size_t size) {
+  80041c:	55                   	push   %ebp
+  80041d:	89 e5                	mov    %esp,%ebp
+  80041f:	83 ec 10             	sub    $0x10,%esp
+    int cls = 0;
+  800422:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    while (class_size[cls] < size) {
+  800429:	eb 04                	jmp    80042f <size2class+0x13>
+        cls ++;
+  80042b:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+    while (class_size[cls] < size) {
+  80042f:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800432:	8b 04 85 40 22 80 00 	mov    0x802240(,%eax,4),%eax
+  800439:	3b 45 08             	cmp    0x8(%ebp),%eax
+  80043c:	72 ed                	jb     80042b <size2class+0xf>
+    }
+    return cls;
+  80043e:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  800441:	c9                   	leave
+  800442:	c3                   	ret
+
+00800443 <heap_coalesce>:
+/* *
+ * heap_coalesce - merge the free block bp with its free neighbours, and put
+ * the result in the free list
+ * */
+static void *
+heap_coalesce(void *bp) {
+  800443:	55                   	push   %ebp
+  800444:	89 e5                	mov    %esp,%ebp
+  800446:	83 ec 40             	sub    $0x40,%esp
+    size_t size = SIZE(HDR(bp));
+  800449:	8b 45 08             	mov    0x8(%ebp),%eax
+  80044c:	83 e8 04             	sub    $0x4,%eax
+  80044f:	8b 00                	mov    (%eax),%eax
+  800451:	83 e0 f8             	and    $0xfffffff8,%eax
+  800454:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    void *next = NEXT_BLK(bp);
+  800457:	8b 45 08             	mov    0x8(%ebp),%eax
+  80045a:	83 e8 04             	sub    $0x4,%eax
+  80045d:	8b 00                	mov    (%eax),%eax
+  80045f:	83 e0 f8             	and    $0xfffffff8,%eax
+  800462:	89 c2                	mov    %eax,%edx
+  800464:	8b 45 08             	mov    0x8(%ebp),%eax
+  800467:	01 d0                	add    %edx,%eax
+  800469:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    if (!(HDR(next) & HEAP_ALLOC)) {
+  80046c:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80046f:	83 e8 04             	sub    $0x4,%eax
+  800472:	8b 00                	mov    (%eax),%eax
+  800474:	83 e0 01             	and    $0x1,%eax
+  800477:	85 c0                	test   %eax,%eax
+  800479:	75 38                	jne    8004b3 <heap_coalesce+0x70>
+  80047b:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80047e:	89 45 f0             	mov    %eax,-0x10(%ebp)
+ * Note: list_empty() on @listelm does not return true after this, the entry is
+ * in an undefined state.
+ * */
+static inline void
+list_del(list_entry_t *listelm) {
+    __list_del(listelm->prev, listelm->next);
+  800481:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800484:	8b 40 04             	mov    0x4(%eax),%eax
+  800487:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  80048a:	8b 12                	mov    (%edx),%edx
+  80048c:	89 55 ec             	mov    %edx,-0x14(%ebp)
+  80048f:	89 45 e8             	mov    %eax,-0x18(%ebp)
+ * This is only for internal list manipulation where we know
+ * the prev/next entries already!
+ * */
+static inline void
+__list_del(list_entry_t *prev, list_entry_t *next) {
+    prev->next = next;
+  800492:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800495:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  800498:	89 50 04             	mov    %edx,0x4(%eax)
+    next->prev = prev;
+  80049b:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  80049e:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  8004a1:	89 10                	mov    %edx,(%eax)
+}
+  8004a3:	90                   	nop
+}
+  8004a4:	90                   	nop
+        list_del(blk2le(next));
+        size += SIZE(HDR(next));
+  8004a5:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8004a8:	83 e8 04             	sub    $0x4,%eax
+  8004ab:	8b 00                	mov    (%eax),%eax
+  8004ad:	83 e0 f8             	and    $0xfffffff8,%eax
+  8004b0:	01 45 fc             	add    %eax,-0x4(%ebp)
+    }
+    if (!(*((size_t *)bp - 2) & HEAP_ALLOC)) {
+  8004b3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8004b6:	83 e8 08             	sub    $0x8,%eax
+  8004b9:	8b 00                	mov    (%eax),%eax
+  8004bb:	83 e0 01             	and    $0x1,%eax
+  8004be:	85 c0                	test   %eax,%eax
+  8004c0:	75 55                	jne    800517 <heap_coalesce+0xd4>
+        void *prev = PREV_BLK(bp);
+  8004c2:	8b 45 08             	mov    0x8(%ebp),%eax
+  8004c5:	83 e8 08             	sub    $0x8,%eax
+  8004c8:	8b 00                	mov    (%eax),%eax
+  8004ca:	83 e0 f8             	and    $0xfffffff8,%eax
+  8004cd:	f7 d8                	neg    %eax
+  8004cf:	89 c2                	mov    %eax,%edx
+  8004d1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8004d4:	01 d0                	add    %edx,%eax
+  8004d6:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8004d9:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8004dc:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+    __list_del(listelm->prev, listelm->next);
+  8004df:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8004e2:	8b 40 04             	mov    0x4(%eax),%eax
+  8004e5:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  8004e8:	8b 12                	mov    (%edx),%edx
+  8004ea:	89 55 e0             	mov    %edx,-0x20(%ebp)
+  8004ed:	89 45 dc             	mov    %eax,-0x24(%ebp)
+    prev->next = next;
+  8004f0:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  8004f3:	8b 55 dc             	mov    -0x24(%ebp),%edx
+  8004f6:	89 50 04             	mov    %edx,0x4(%eax)
+    next->prev = prev;
+  8004f9:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  8004fc:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  8004ff:	89 10                	mov    %edx,(%eax)
+}
+  800501:	90                   	nop
+}
+  800502:	90                   	nop
+        list_del(blk2le(prev));
+        size += SIZE(HDR(prev));
+  800503:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800506:	83 e8 04             	sub    $0x4,%eax
+  800509:	8b 00                	mov    (%eax),%eax
+  80050b:	83 e0 f8             	and    $0xfffffff8,%eax
+  80050e:	01 45 fc             	add    %eax,-0x4(%ebp)
+        bp = prev;
+  800511:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800514:	89 45 08             	mov    %eax,0x8(%ebp)
+    }
+    HDR(bp) = size;
+  800517:	8b 45 08             	mov    0x8(%ebp),%eax
+  80051a:	8d 50 fc             	lea    -0x4(%eax),%edx
+  80051d:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800520:	89 02                	mov    %eax,(%edx)
+    FTR(bp) = size;
+  800522:	8b 45 08             	mov    0x8(%ebp),%eax
+  800525:	83 e8 04             	sub    $0x4,%eax
+  800528:	8b 00                	mov    (%eax),%eax
+  80052a:	83 e0 f8             	and    $0xfffffff8,%eax
+  80052d:	8d 50 f8             	lea    -0x8(%eax),%edx
+  800530:	8b 45 08             	mov    0x8(%ebp),%eax
+  800533:	01 c2                	add    %eax,%edx
+  800535:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800538:	89 02                	mov    %eax,(%edx)
+  80053a:	c7 45 d8 04 30 80 00 	movl   $0x803004,-0x28(%ebp)
+  800541:	8b 45 08             	mov    0x8(%ebp),%eax
+  800544:	89 45 d4             	mov    %eax,-0x2c(%ebp)
+  800547:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  80054a:	89 45 d0             	mov    %eax,-0x30(%ebp)
+  80054d:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+  800550:	89 45 cc             	mov    %eax,-0x34(%ebp)
+    __list_add(elm, listelm, listelm->next);
+  800553:	8b 45 d0             	mov    -0x30(%ebp),%eax
+  800556:	8b 40 04             	mov    0x4(%eax),%eax
+  800559:	8b 55 cc             	mov    -0x34(%ebp),%edx
+  80055c:	89 55 c8             	mov    %edx,-0x38(%ebp)
+  80055f:	8b 55 d0             	mov    -0x30(%ebp),%edx
+  800562:	89 55 c4             	mov    %edx,-0x3c(%ebp)
+  800565:	89 45 c0             	mov    %eax,-0x40(%ebp)
+    prev->next = next->prev = elm;
+  800568:	8b 45 c0             	mov    -0x40(%ebp),%eax
+  80056b:	8b 55 c8             	mov    -0x38(%ebp),%edx
+  80056e:	89 10                	mov    %edx,(%eax)
+  800570:	8b 45 c0             	mov    -0x40(%ebp),%eax
+  800573:	8b 10                	mov    (%eax),%edx
+  800575:	8b 45 c4             	mov    -0x3c(%ebp),%eax
+  800578:	89 50 04             	mov    %edx,0x4(%eax)
+    elm->next = next;
+  80057b:	8b 45 c8             	mov    -0x38(%ebp),%eax
+  80057e:	8b 55 c0             	mov    -0x40(%ebp),%edx
+  800581:	89 50 04             	mov    %edx,0x4(%eax)
+    elm->prev = prev;
+  800584:	8b 45 c8             	mov    -0x38(%ebp),%eax
+  800587:	8b 55 c4             	mov    -0x3c(%ebp),%edx
+  80058a:	89 10                	mov    %edx,(%eax)
+}
+  80058c:	90                   	nop
+}
+  80058d:	90                   	nop
+}
+  80058e:	90                   	nop
+    list_add(&heap_free_list, blk2le(bp));
+    return bp;
+  80058f:	8b 45 08             	mov    0x8(%ebp),%eax
+}
+  800592:	c9                   	leave
+  800593:	c3                   	ret
+
+00800594 <heap_extend>:
+ * heap_extend - get at least size bytes from the kernel by sbrk, if the new memory
+ * follows the last region, the old epilogue becomes the header of the new block.
+ * otherwise a new region is made as: [pad][prologue hdr|ftr][block ...][epilogue]
+ * */
+static void *
+heap_extend(size_t size) {
+  800594:	55                   	push   %ebp
+  800595:	89 e5                	mov    %esp,%ebp
+  800597:	83 ec 28             	sub    $0x28,%esp
+    size_t len = ROUNDUP(size + 4 * sizeof(size_t), HEAP_CHUNK);
+  80059a:	c7 45 f0 00 00 01 00 	movl   $0x10000,-0x10(%ebp)
+  8005a1:	8b 55 08             	mov    0x8(%ebp),%edx
+  8005a4:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8005a7:	01 d0                	add    %edx,%eax
+  8005a9:	83 c0 0f             	add    $0xf,%eax
+  8005ac:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  8005af:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8005b2:	ba 00 00 00 00       	mov    $0x0,%edx
+  8005b7:	f7 75 f0             	divl   -0x10(%ebp)
+  8005ba:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8005bd:	29 d0                	sub    %edx,%eax
+  8005bf:	89 45 e8             	mov    %eax,-0x18(%ebp)
+    char *p = sbrk(len), *bp;
+  8005c2:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8005c5:	83 ec 0c             	sub    $0xc,%esp
+  8005c8:	50                   	push   %eax
+  8005c9:	e8 60 0d 00 00       	call   80132e <sbrk>
+  8005ce:	83 c4 10             	add    $0x10,%esp
+  8005d1:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+    if (p == (void *)-1) {
+  8005d4:	83 7d e4 ff          	cmpl   $0xffffffff,-0x1c(%ebp)
+  8005d8:	75 0a                	jne    8005e4 <heap_extend+0x50>
+        return NULL;
+  8005da:	b8 00 00 00 00       	mov    $0x0,%eax
+  8005df:	e9 99 00 00 00       	jmp    80067d <heap_extend+0xe9>
+    }
+    if (p == heap_end) {
+  8005e4:	a1 b0 31 80 00       	mov    0x8031b0,%eax
+  8005e9:	39 45 e4             	cmp    %eax,-0x1c(%ebp)
+  8005ec:	75 0e                	jne    8005fc <heap_extend+0x68>
+        bp = p, size = len;
+  8005ee:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8005f1:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8005f4:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8005f7:	89 45 08             	mov    %eax,0x8(%ebp)
+  8005fa:	eb 2a                	jmp    800626 <heap_extend+0x92>
+    }
+    else {
+        *(size_t *)(p + sizeof(size_t)) = (2 * sizeof(size_t)) | HEAP_ALLOC;
+  8005fc:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8005ff:	83 c0 04             	add    $0x4,%eax
+  800602:	c7 00 09 00 00 00    	movl   $0x9,(%eax)
+        *(size_t *)(p + 2 * sizeof(size_t)) = (2 * sizeof(size_t)) | HEAP_ALLOC;
+  800608:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  80060b:	83 c0 08             	add    $0x8,%eax
+  80060e:	c7 00 09 00 00 00    	movl   $0x9,(%eax)
+        bp = p + 4 * sizeof(size_t), size = len - 4 * sizeof(size_t);
+  800614:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800617:	83 c0 10             	add    $0x10,%eax
+  80061a:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  80061d:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800620:	83 e8 10             	sub    $0x10,%eax
+  800623:	89 45 08             	mov    %eax,0x8(%ebp)
+    }
+    HDR(bp) = size;
+  800626:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800629:	8d 50 fc             	lea    -0x4(%eax),%edx
+  80062c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80062f:	89 02                	mov    %eax,(%edx)
+    FTR(bp) = size;
+  800631:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800634:	83 e8 04             	sub    $0x4,%eax
+  800637:	8b 00                	mov    (%eax),%eax
+  800639:	83 e0 f8             	and    $0xfffffff8,%eax
+  80063c:	8d 50 f8             	lea    -0x8(%eax),%edx
+  80063f:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800642:	01 c2                	add    %eax,%edx
+  800644:	8b 45 08             	mov    0x8(%ebp),%eax
+  800647:	89 02                	mov    %eax,(%edx)
+    HDR(NEXT_BLK(bp)) = 0 | HEAP_ALLOC;
+  800649:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80064c:	83 e8 04             	sub    $0x4,%eax
+  80064f:	8b 00                	mov    (%eax),%eax
+  800651:	83 e0 f8             	and    $0xfffffff8,%eax
+  800654:	8d 50 fc             	lea    -0x4(%eax),%edx
+  800657:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80065a:	01 d0                	add    %edx,%eax
+  80065c:	c7 00 01 00 00 00    	movl   $0x1,(%eax)
+    heap_end = p + len;
+  800662:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  800665:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800668:	01 d0                	add    %edx,%eax
+  80066a:	a3 b0 31 80 00       	mov    %eax,0x8031b0
+    return heap_coalesce(bp);
+  80066f:	83 ec 0c             	sub    $0xc,%esp
+  800672:	ff 75 f4             	push   -0xc(%ebp)
+  800675:	e8 c9 fd ff ff       	call   800443 <heap_coalesce>
+  80067a:	83 c4 10             	add    $0x10,%esp
+}
+  80067d:	c9                   	leave
+  80067e:	c3                   	ret
+
+0080067f <heap_alloc>:
+/* *
+ * heap_alloc - alloc a block with at least size bytes payload from the free list
+ * (first fit), split the block if the rest is large enough to be a block.
+ * */
+static void *
+heap_alloc(size_t size) {
+  80067f:	55                   	push   %ebp
+  800680:	89 e5                	mov    %esp,%ebp
+  800682:	83 ec 58             	sub    $0x58,%esp
+    size_t asize = ROUNDUP(size + 2 * sizeof(size_t), ALIGN);
+  800685:	c7 45 e8 08 00 00 00 	movl   $0x8,-0x18(%ebp)
+  80068c:	8b 55 08             	mov    0x8(%ebp),%edx
+  80068f:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800692:	01 d0                	add    %edx,%eax
+  800694:	83 c0 07             	add    $0x7,%eax
+  800697:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  80069a:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  80069d:	ba 00 00 00 00       	mov    $0x0,%edx
+  8006a2:	f7 75 e8             	divl   -0x18(%ebp)
+  8006a5:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8006a8:	29 d0                	sub    %edx,%eax
+  8006aa:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (asize < HEAP_MIN_BLOCK) {
+  8006ad:	83 7d f4 0f          	cmpl   $0xf,-0xc(%ebp)
+  8006b1:	77 07                	ja     8006ba <heap_alloc+0x3b>
+        asize = HEAP_MIN_BLOCK;
+  8006b3:	c7 45 f4 10 00 00 00 	movl   $0x10,-0xc(%ebp)
+    }
+
+    void *bp = NULL;
+  8006ba:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+    list_entry_t *le = &heap_free_list;
+  8006c1:	c7 45 ec 04 30 80 00 	movl   $0x803004,-0x14(%ebp)
+    while ((le = list_next(le)) != &heap_free_list) {
+  8006c8:	eb 18                	jmp    8006e2 <heap_alloc+0x63>
+        if (SIZE(HDR(le2blk(le))) >= asize) {
+  8006ca:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8006cd:	83 e8 04             	sub    $0x4,%eax
+  8006d0:	8b 00                	mov    (%eax),%eax
+  8006d2:	83 e0 f8             	and    $0xfffffff8,%eax
+  8006d5:	3b 45 f4             	cmp    -0xc(%ebp),%eax
+  8006d8:	72 08                	jb     8006e2 <heap_alloc+0x63>
+            bp = le2blk(le);
+  8006da:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8006dd:	89 45 f0             	mov    %eax,-0x10(%ebp)
+            break;
+  8006e0:	eb 18                	jmp    8006fa <heap_alloc+0x7b>
+  8006e2:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8006e5:	89 45 d8             	mov    %eax,-0x28(%ebp)
+    return listelm->next;
+  8006e8:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  8006eb:	8b 40 04             	mov    0x4(%eax),%eax
+    while ((le = list_next(le)) != &heap_free_list) {
+  8006ee:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  8006f1:	81 7d ec 04 30 80 00 	cmpl   $0x803004,-0x14(%ebp)
+  8006f8:	75 d0                	jne    8006ca <heap_alloc+0x4b>
+        }
+    }
+    if (bp == NULL && (bp = heap_extend(asize)) == NULL) {
+  8006fa:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  8006fe:	75 21                	jne    800721 <heap_alloc+0xa2>
+  800700:	83 ec 0c             	sub    $0xc,%esp
+  800703:	ff 75 f4             	push   -0xc(%ebp)
+  800706:	e8 89 fe ff ff       	call   800594 <heap_extend>
+  80070b:	83 c4 10             	add    $0x10,%esp
+  80070e:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  800711:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  800715:	75 0a                	jne    800721 <heap_alloc+0xa2>
+        return NULL;
+  800717:	b8 00 00 00 00       	mov    $0x0,%eax
+  80071c:	e9 30 01 00 00       	jmp    800851 <heap_alloc+0x1d2>
+  800721:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800724:	89 45 d4             	mov    %eax,-0x2c(%ebp)
+    __list_del(listelm->prev, listelm->next);
+  800727:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+  80072a:	8b 40 04             	mov    0x4(%eax),%eax
+  80072d:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+  800730:	8b 12                	mov    (%edx),%edx
+  800732:	89 55 d0             	mov    %edx,-0x30(%ebp)
+  800735:	89 45 cc             	mov    %eax,-0x34(%ebp)
+    prev->next = next;
+  800738:	8b 45 d0             	mov    -0x30(%ebp),%eax
+  80073b:	8b 55 cc             	mov    -0x34(%ebp),%edx
+  80073e:	89 50 04             	mov    %edx,0x4(%eax)
+    next->prev = prev;
+  800741:	8b 45 cc             	mov    -0x34(%ebp),%eax
+  800744:	8b 55 d0             	mov    -0x30(%ebp),%edx
+  800747:	89 10                	mov    %edx,(%eax)
+}
+  800749:	90                   	nop
+}
+  80074a:	90                   	nop
+    }
+
+    list_del(blk2le(bp));
+    size_t bsize = SIZE(HDR(bp));
+  80074b:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80074e:	83 e8 04             	sub    $0x4,%eax
+  800751:	8b 00                	mov    (%eax),%eax
+  800753:	83 e0 f8             	and    $0xfffffff8,%eax
+  800756:	89 45 e0             	mov    %eax,-0x20(%ebp)
+    if (bsize - asize >= HEAP_MIN_BLOCK) {
+  800759:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  80075c:	2b 45 f4             	sub    -0xc(%ebp),%eax
+  80075f:	83 f8 0f             	cmp    $0xf,%eax
+  800762:	0f 86 bd 00 00 00    	jbe    800825 <heap_alloc+0x1a6>
+        HDR(bp) = asize | HEAP_ALLOC;
+  800768:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80076b:	83 e8 04             	sub    $0x4,%eax
+  80076e:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  800771:	83 ca 01             	or     $0x1,%edx
+  800774:	89 10                	mov    %edx,(%eax)
+        FTR(bp) = asize | HEAP_ALLOC;
+  800776:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800779:	83 e8 04             	sub    $0x4,%eax
+  80077c:	8b 00                	mov    (%eax),%eax
+  80077e:	83 e0 f8             	and    $0xfffffff8,%eax
+  800781:	8d 50 f8             	lea    -0x8(%eax),%edx
+  800784:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800787:	01 d0                	add    %edx,%eax
+  800789:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  80078c:	83 ca 01             	or     $0x1,%edx
+  80078f:	89 10                	mov    %edx,(%eax)
+        void *rest = NEXT_BLK(bp);
+  800791:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800794:	83 e8 04             	sub    $0x4,%eax
+  800797:	8b 00                	mov    (%eax),%eax
+  800799:	83 e0 f8             	and    $0xfffffff8,%eax
+  80079c:	89 c2                	mov    %eax,%edx
+  80079e:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8007a1:	01 d0                	add    %edx,%eax
+  8007a3:	89 45 dc             	mov    %eax,-0x24(%ebp)
+        HDR(rest) = bsize - asize;
+  8007a6:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  8007a9:	8d 50 fc             	lea    -0x4(%eax),%edx
+  8007ac:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  8007af:	2b 45 f4             	sub    -0xc(%ebp),%eax
+  8007b2:	89 02                	mov    %eax,(%edx)
+        FTR(rest) = bsize - asize;
+  8007b4:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  8007b7:	83 e8 04             	sub    $0x4,%eax
+  8007ba:	8b 00                	mov    (%eax),%eax
+  8007bc:	83 e0 f8             	and    $0xfffffff8,%eax
+  8007bf:	8d 50 f8             	lea    -0x8(%eax),%edx
+  8007c2:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  8007c5:	01 c2                	add    %eax,%edx
+  8007c7:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  8007ca:	2b 45 f4             	sub    -0xc(%ebp),%eax
+  8007cd:	89 02                	mov    %eax,(%edx)
+  8007cf:	c7 45 c8 04 30 80 00 	movl   $0x803004,-0x38(%ebp)
+  8007d6:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  8007d9:	89 45 c4             	mov    %eax,-0x3c(%ebp)
+  8007dc:	8b 45 c8             	mov    -0x38(%ebp),%eax
+  8007df:	89 45 c0             	mov    %eax,-0x40(%ebp)
+  8007e2:	8b 45 c4             	mov    -0x3c(%ebp),%eax
+  8007e5:	89 45 bc             	mov    %eax,-0x44(%ebp)
+    __list_add(elm, listelm, listelm->next);
+  8007e8:	8b 45 c0             	mov    -0x40(%ebp),%eax
+  8007eb:	8b 40 04             	mov    0x4(%eax),%eax
+  8007ee:	8b 55 bc             	mov    -0x44(%ebp),%edx
+  8007f1:	89 55 b8             	mov    %edx,-0x48(%ebp)
+  8007f4:	8b 55 c0             	mov    -0x40(%ebp),%edx
+  8007f7:	89 55 b4             	mov    %edx,-0x4c(%ebp)
+  8007fa:	89 45 b0             	mov    %eax,-0x50(%ebp)
+    prev->next = next->prev = elm;
+  8007fd:	8b 45 b0             	mov    -0x50(%ebp),%eax
+  800800:	8b 55 b8             	mov    -0x48(%ebp),%edx
+  800803:	89 10                	mov    %edx,(%eax)
+  800805:	8b 45 b0             	mov    -0x50(%ebp),%eax
+  800808:	8b 10                	mov    (%eax),%edx
+  80080a:	8b 45 b4             	mov    -0x4c(%ebp),%eax
+  80080d:	89 50 04             	mov    %edx,0x4(%eax)
+    elm->next = next;
+  800810:	8b 45 b8             	mov    -0x48(%ebp),%eax
+  800813:	8b 55 b0             	mov    -0x50(%ebp),%edx
+  800816:	89 50 04             	mov    %edx,0x4(%eax)
+    elm->prev = prev;
+  800819:	8b 45 b8             	mov    -0x48(%ebp),%eax
+  80081c:	8b 55 b4             	mov    -0x4c(%ebp),%edx
+  80081f:	89 10                	mov    %edx,(%eax)
+}
+  800821:	90                   	nop
+}
+  800822:	90                   	nop
+}
+  800823:	eb 29                	jmp    80084e <heap_alloc+0x1cf>
+        list_add(&heap_free_list, blk2le(rest));
+    }
+    else {
+        HDR(bp) = bsize | HEAP_ALLOC;
+  800825:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800828:	83 e8 04             	sub    $0x4,%eax
+  80082b:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  80082e:	83 ca 01             	or     $0x1,%edx
+  800831:	89 10                	mov    %edx,(%eax)
+        FTR(bp) = bsize | HEAP_ALLOC;
+  800833:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800836:	83 e8 04             	sub    $0x4,%eax
+  800839:	8b 00                	mov    (%eax),%eax
+  80083b:	83 e0 f8             	and    $0xfffffff8,%eax
+  80083e:	8d 50 f8             	lea    -0x8(%eax),%edx
+  800841:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800844:	01 d0                	add    %edx,%eax
+  800846:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  800849:	83 ca 01             	or     $0x1,%edx
+  80084c:	89 10                	mov    %edx,(%eax)
+    }
+    return bp;
+  80084e:	8b 45 f0             	mov    -0x10(%ebp),%eax
+}
+  800851:	c9                   	leave
+  800852:	c3                   	ret
+
+00800853 <heap_free>:
+
+static void
+heap_free(void *bp) {
+  800853:	55                   	push   %ebp
+  800854:	89 e5                	mov    %esp,%ebp
+  800856:	83 ec 10             	sub    $0x10,%esp
+    size_t size = SIZE(HDR(bp));
+  800859:	8b 45 08             	mov    0x8(%ebp),%eax
+  80085c:	83 e8 04             	sub    $0x4,%eax
+  80085f:	8b 00                	mov    (%eax),%eax
+  800861:	83 e0 f8             	and    $0xfffffff8,%eax
+  800864:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    HDR(bp) = size;
+  800867:	8b 45 08             	mov    0x8(%ebp),%eax
+  80086a:	8d 50 fc             	lea    -0x4(%eax),%edx
+  80086d:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800870:	89 02                	mov    %eax,(%edx)
+    FTR(bp) = size;
+  800872:	8b 45 08             	mov    0x8(%ebp),%eax
+  800875:	83 e8 04             	sub    $0x4,%eax
+  800878:	8b 00                	mov    (%eax),%eax
+  80087a:	83 e0 f8             	and    $0xfffffff8,%eax
+  80087d:	8d 50 f8             	lea    -0x8(%eax),%edx
+  800880:	8b 45 08             	mov    0x8(%ebp),%eax
+  800883:	01 c2                	add    %eax,%edx
+  800885:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800888:	89 02                	mov    %eax,(%edx)
+    heap_coalesce(bp);
+  80088a:	ff 75 08             	push   0x8(%ebp)
+  80088d:	e8 b1 fb ff ff       	call   800443 <heap_coalesce>
+  800892:	83 c4 04             	add    $0x4,%esp
+}
+  800895:	90                   	nop
+  800896:	c9                   	leave
+  800897:	c3                   	ret
+
+00800898 <bin_refill>:
+/* *
+ * bin_refill - carve a run from the heap into objects of class cls. every object
+ * has its own tag word, so objects are laid out with a stride of size + ALIGN.
+ * */
+static bool
+bin_refill(int cls) {
+  800898:	55                   	push   %ebp
+  800899:	89 e5                	mov    %esp,%ebp
+  80089b:	83 ec 28             	sub    $0x28,%esp
+    size_t stride = class_size[cls] + ALIGN;
+  80089e:	8b 45 08             	mov    0x8(%ebp),%eax
+  8008a1:	8b 04 85 40 22 80 00 	mov    0x802240(,%eax,4),%eax
+  8008a8:	83 c0 08             	add    $0x8,%eax
+  8008ab:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    char *run;
+    if ((run = heap_alloc(SMALL_RUN)) == NULL) {
+  8008ae:	83 ec 0c             	sub    $0xc,%esp
+  8008b1:	68 00 40 00 00       	push   $0x4000
+  8008b6:	e8 c4 fd ff ff       	call   80067f <heap_alloc>
+  8008bb:	83 c4 10             	add    $0x10,%esp
+  8008be:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  8008c1:	83 7d ec 00          	cmpl   $0x0,-0x14(%ebp)
+  8008c5:	75 0a                	jne    8008d1 <bin_refill+0x39>
+        return 0;
+  8008c7:	b8 00 00 00 00       	mov    $0x0,%eax
+  8008cc:	e9 80 00 00 00       	jmp    800951 <bin_refill+0xb9>
+    }
+    struct bin *bin = bins + cls;
+  8008d1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8008d4:	c1 e0 03             	shl    $0x3,%eax
+  8008d7:	05 40 31 80 00       	add    $0x803140,%eax
+  8008dc:	89 45 e8             	mov    %eax,-0x18(%ebp)
+    size_t i, n = SMALL_RUN / stride;
+  8008df:	b8 00 40 00 00       	mov    $0x4000,%eax
+  8008e4:	ba 00 00 00 00       	mov    $0x0,%edx
+  8008e9:	f7 75 f0             	divl   -0x10(%ebp)
+  8008ec:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+    for (i = 0; i < n; i ++) {
+  8008ef:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+  8008f6:	eb 3b                	jmp    800933 <bin_refill+0x9b>
+        void *obj = run + i * stride + ALIGN;
+  8008f8:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8008fb:	0f af 45 f0          	imul   -0x10(%ebp),%eax
+  8008ff:	8d 50 08             	lea    0x8(%eax),%edx
+  800902:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800905:	01 d0                	add    %edx,%eax
+  800907:	89 45 e0             	mov    %eax,-0x20(%ebp)
+        TAG(obj) = (cls << 3) | SMALL_OBJ;
+  80090a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80090d:	c1 e0 03             	shl    $0x3,%eax
+  800910:	83 c8 02             	or     $0x2,%eax
+  800913:	89 c2                	mov    %eax,%edx
+  800915:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  800918:	83 e8 04             	sub    $0x4,%eax
+  80091b:	89 10                	mov    %edx,(%eax)
+        *(void **)obj = bin->free_list;
+  80091d:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800920:	8b 10                	mov    (%eax),%edx
+  800922:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  800925:	89 10                	mov    %edx,(%eax)
+        bin->free_list = obj;
+  800927:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  80092a:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  80092d:	89 10                	mov    %edx,(%eax)
+    for (i = 0; i < n; i ++) {
+  80092f:	83 45 f4 01          	addl   $0x1,-0xc(%ebp)
+  800933:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800936:	3b 45 e4             	cmp    -0x1c(%ebp),%eax
+  800939:	72 bd                	jb     8008f8 <bin_refill+0x60>
+    }
+    bin->nr_free += n;
+  80093b:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  80093e:	8b 50 04             	mov    0x4(%eax),%edx
+  800941:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800944:	01 c2                	add    %eax,%edx
+  800946:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800949:	89 50 04             	mov    %edx,0x4(%eax)
+    return 1;
+  80094c:	b8 01 00 00 00       	mov    $0x1,%eax
+}
+  800951:	c9                   	leave
+  800952:	c3                   	ret
+
+00800953 <small_alloc>:
+
+static void *
+small_alloc(size_t size) {
+  800953:	55                   	push   %ebp
+  800954:	89 e5                	mov    %esp,%ebp
+  800956:	83 ec 18             	sub    $0x18,%esp
+    int cls = size2class(size);
+  800959:	ff 75 08             	push   0x8(%ebp)
+  80095c:	e8 bb fa ff ff       	call   80041c <size2class>
+  800961:	83 c4 04             	add    $0x4,%esp
+  800964:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    struct bin *bin = bins + cls;
+  800967:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80096a:	c1 e0 03             	shl    $0x3,%eax
+  80096d:	05 40 31 80 00       	add    $0x803140,%eax
+  800972:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    if (bin->free_list == NULL && !bin_refill(cls)) {
+  800975:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800978:	8b 00                	mov    (%eax),%eax
+  80097a:	85 c0                	test   %eax,%eax
+  80097c:	75 19                	jne    800997 <small_alloc+0x44>
+  80097e:	83 ec 0c             	sub    $0xc,%esp
+  800981:	ff 75 f4             	push   -0xc(%ebp)
+  800984:	e8 0f ff ff ff       	call   800898 <bin_refill>
+  800989:	83 c4 10             	add    $0x10,%esp
+  80098c:	85 c0                	test   %eax,%eax
+  80098e:	75 07                	jne    800997 <small_alloc+0x44>
+        return NULL;
+  800990:	b8 00 00 00 00       	mov    $0x0,%eax
+  800995:	eb 24                	jmp    8009bb <small_alloc+0x68>
+    }
+    void *obj = bin->free_list;
+  800997:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80099a:	8b 00                	mov    (%eax),%eax
+  80099c:	89 45 ec             	mov    %eax,-0x14(%ebp)
+    bin->free_list = *(void **)obj;
+  80099f:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8009a2:	8b 10                	mov    (%eax),%edx
+  8009a4:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8009a7:	89 10                	mov    %edx,(%eax)
+    bin->nr_free --;
+  8009a9:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8009ac:	8b 40 04             	mov    0x4(%eax),%eax
+  8009af:	8d 50 ff             	lea    -0x1(%eax),%edx
+  8009b2:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8009b5:	89 50 04             	mov    %edx,0x4(%eax)
+    return obj;
+  8009b8:	8b 45 ec             	mov    -0x14(%ebp),%eax
+}
+  8009bb:	c9                   	leave
+  8009bc:	c3                   	ret
+
+008009bd <small_free>:
+
+static void
+small_free(void *obj) {
+  8009bd:	55                   	push   %ebp
+  8009be:	89 e5                	mov    %esp,%ebp
+  8009c0:	83 ec 10             	sub    $0x10,%esp
+    struct bin *bin = bins + (TAG(obj) >> 3);
+  8009c3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8009c6:	83 e8 04             	sub    $0x4,%eax
+  8009c9:	8b 00                	mov    (%eax),%eax
+  8009cb:	c1 e8 03             	shr    $0x3,%eax
+  8009ce:	c1 e0 03             	shl    $0x3,%eax
+  8009d1:	05 40 31 80 00       	add    $0x803140,%eax
+  8009d6:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    *(void **)obj = bin->free_list;
+  8009d9:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8009dc:	8b 10                	mov    (%eax),%edx
+  8009de:	8b 45 08             	mov    0x8(%ebp),%eax
+  8009e1:	89 10                	mov    %edx,(%eax)
+    bin->free_list = obj;
+  8009e3:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8009e6:	8b 55 08             	mov    0x8(%ebp),%edx
+  8009e9:	89 10                	mov    %edx,(%eax)
+    bin->nr_free ++;
+  8009eb:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8009ee:	8b 40 04             	mov    0x4(%eax),%eax
+  8009f1:	8d 50 01             	lea    0x1(%eax),%edx
+  8009f4:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8009f7:	89 50 04             	mov    %edx,0x4(%eax)
+}
+  8009fa:	90                   	nop
+  8009fb:	c9                   	leave
+  8009fc:	c3                   	ret
+
+008009fd <large_alloc>:
+
+static void *
+large_alloc(size_t size) {
+  8009fd:	55                   	push   %ebp
+  8009fe:	89 e5                	mov    %esp,%ebp
+  800a00:	83 ec 18             	sub    $0x18,%esp
+    size_t len = ROUNDUP(size + ALIGN, PGSIZE);
+  800a03:	c7 45 f4 00 10 00 00 	movl   $0x1000,-0xc(%ebp)
+  800a0a:	8b 55 08             	mov    0x8(%ebp),%edx
+  800a0d:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800a10:	01 d0                	add    %edx,%eax
+  800a12:	83 c0 07             	add    $0x7,%eax
+  800a15:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  800a18:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800a1b:	ba 00 00 00 00       	mov    $0x0,%edx
+  800a20:	f7 75 f4             	divl   -0xc(%ebp)
+  800a23:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800a26:	29 d0                	sub    %edx,%eax
+  800a28:	89 45 ec             	mov    %eax,-0x14(%ebp)
+    char *p;
+    if ((p = mmap(NULL, len, MMAP_WRITE)) == NULL) {
+  800a2b:	83 ec 04             	sub    $0x4,%esp
+  800a2e:	68 00 01 00 00       	push   $0x100
+  800a33:	ff 75 ec             	push   -0x14(%ebp)
+  800a36:	6a 00                	push   $0x0
+  800a38:	e8 67 09 00 00       	call   8013a4 <mmap>
+  800a3d:	83 c4 10             	add    $0x10,%esp
+  800a40:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  800a43:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  800a47:	75 07                	jne    800a50 <large_alloc+0x53>
+        return NULL;
+  800a49:	b8 00 00 00 00       	mov    $0x0,%eax
+  800a4e:	eb 14                	jmp    800a64 <large_alloc+0x67>
+    }
+    TAG(p + ALIGN) = len | LARGE_OBJ;
+  800a50:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800a53:	83 c0 04             	add    $0x4,%eax
+  800a56:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  800a59:	83 ca 04             	or     $0x4,%edx
+  800a5c:	89 10                	mov    %edx,(%eax)
+    return p + ALIGN;
+  800a5e:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800a61:	83 c0 08             	add    $0x8,%eax
+}
+  800a64:	c9                   	leave
+  800a65:	c3                   	ret
+
+00800a66 <large_free>:
+
+static void
+large_free(void *obj) {
+  800a66:	55                   	push   %ebp
+  800a67:	89 e5                	mov    %esp,%ebp
+  800a69:	83 ec 08             	sub    $0x8,%esp
+    munmap((char *)obj - ALIGN, SIZE(TAG(obj)));
+  800a6c:	8b 45 08             	mov    0x8(%ebp),%eax
+  800a6f:	83 e8 04             	sub    $0x4,%eax
+  800a72:	8b 00                	mov    (%eax),%eax
+  800a74:	83 e0 f8             	and    $0xfffffff8,%eax
+  800a77:	89 c2                	mov    %eax,%edx
+  800a79:	8b 45 08             	mov    0x8(%ebp),%eax
+  800a7c:	83 e8 08             	sub    $0x8,%eax
+  800a7f:	83 ec 08             	sub    $0x8,%esp
+  800a82:	52                   	push   %edx
+  800a83:	50                   	push   %eax
+  800a84:	e8 4c 09 00 00       	call   8013d5 <munmap>
+  800a89:	83 c4 10             	add    $0x10,%esp
+}
+  800a8c:	90                   	nop
+  800a8d:	c9                   	leave
+  800a8e:	c3                   	ret
+
+00800a8f <usable_size>:
+
+// usable_size - # of bytes can be used in the object ptr
+static size_t
+usable_size(void *ptr) {
+  800a8f:	55                   	push   %ebp
+  800a90:	89 e5                	mov    %esp,%ebp
+  800a92:	83 ec 10             	sub    $0x10,%esp
+    size_t tag = TAG(ptr);
+  800a95:	8b 45 08             	mov    0x8(%ebp),%eax
+  800a98:	8b 40 fc             	mov    -0x4(%eax),%eax
+  800a9b:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    if (tag & SMALL_OBJ) {
+  800a9e:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800aa1:	83 e0 02             	and    $0x2,%eax
+  800aa4:	85 c0                	test   %eax,%eax
+  800aa6:	74 0f                	je     800ab7 <usable_size+0x28>
+        return class_size[tag >> 3];
+  800aa8:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800aab:	c1 e8 03             	shr    $0x3,%eax
+  800aae:	8b 04 85 40 22 80 00 	mov    0x802240(,%eax,4),%eax
+  800ab5:	eb 1e                	jmp    800ad5 <usable_size+0x46>
+    }
+    if (tag & LARGE_OBJ) {
+  800ab7:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800aba:	83 e0 04             	and    $0x4,%eax
+  800abd:	85 c0                	test   %eax,%eax
+  800abf:	74 0b                	je     800acc <usable_size+0x3d>
+        return SIZE(tag) - ALIGN;
+  800ac1:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800ac4:	83 e0 f8             	and    $0xfffffff8,%eax
+  800ac7:	83 e8 08             	sub    $0x8,%eax
+  800aca:	eb 09                	jmp    800ad5 <usable_size+0x46>
+    }
+    return SIZE(tag) - 2 * sizeof(size_t);
+  800acc:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800acf:	83 e0 f8             	and    $0xfffffff8,%eax
+  800ad2:	83 e8 08             	sub    $0x8,%eax
+}
+  800ad5:	c9                   	leave
+  800ad6:	c3                   	ret
+
+00800ad7 <malloc>:
+
+void *
+malloc(size_t size) {
+  800ad7:	55                   	push   %ebp
+  800ad8:	89 e5                	mov    %esp,%ebp
+  800ada:	83 ec 18             	sub    $0x18,%esp
+    // no user space is that large, and the sizes below can't overflow
+    if (size == 0 || size > ((size_t)-1 >> 1)) {
+  800add:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  800ae1:	74 07                	je     800aea <malloc+0x13>
+  800ae3:	8b 45 08             	mov    0x8(%ebp),%eax
+  800ae6:	85 c0                	test   %eax,%eax
+  800ae8:	79 07                	jns    800af1 <malloc+0x1a>
+        return NULL;
+  800aea:	b8 00 00 00 00       	mov    $0x0,%eax
+  800aef:	eb 75                	jmp    800b66 <malloc+0x8f>
+    }
+    void *ptr;
+    if (size >= LARGE_MIN) {
+  800af1:	81 7d 08 ff ff 00 00 	cmpl   $0xffff,0x8(%ebp)
+  800af8:	76 1c                	jbe    800b16 <malloc+0x3f>
+        // mmap doesn't touch the heap, no lock needed
+        if ((ptr = large_alloc(size)) != NULL) {
+  800afa:	83 ec 0c             	sub    $0xc,%esp
+  800afd:	ff 75 08             	push   0x8(%ebp)
+  800b00:	e8 f8 fe ff ff       	call   8009fd <large_alloc>
+  800b05:	83 c4 10             	add    $0x10,%esp
+  800b08:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800b0b:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  800b0f:	74 05                	je     800b16 <malloc+0x3f>
+            return ptr;
+  800b11:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800b14:	eb 50                	jmp    800b66 <malloc+0x8f>
+        }
+    }
+    lock(&malloc_lock);
+  800b16:	83 ec 0c             	sub    $0xc,%esp
+  800b19:	68 b4 31 80 00       	push   $0x8031b4
+  800b1e:	e8 7d f8 ff ff       	call   8003a0 <lock>
+  800b23:	83 c4 10             	add    $0x10,%esp
+    if (size <= SMALL_MAX) {
+  800b26:	81 7d 08 00 08 00 00 	cmpl   $0x800,0x8(%ebp)
+  800b2d:	77 13                	ja     800b42 <malloc+0x6b>
+        ptr = small_alloc(size);
+  800b2f:	83 ec 0c             	sub    $0xc,%esp
+  800b32:	ff 75 08             	push   0x8(%ebp)
+  800b35:	e8 19 fe ff ff       	call   800953 <small_alloc>
+  800b3a:	83 c4 10             	add    $0x10,%esp
+  800b3d:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800b40:	eb 11                	jmp    800b53 <malloc+0x7c>
+    }
+    else {
+        // also the fallback of large objects when there is no room for mmap
+        ptr = heap_alloc(size);
+  800b42:	83 ec 0c             	sub    $0xc,%esp
+  800b45:	ff 75 08             	push   0x8(%ebp)
+  800b48:	e8 32 fb ff ff       	call   80067f <heap_alloc>
+  800b4d:	83 c4 10             	add    $0x10,%esp
+  800b50:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    }
+    unlock(&malloc_lock);
+  800b53:	83 ec 0c             	sub    $0xc,%esp
+  800b56:	68 b4 31 80 00       	push   $0x8031b4
+  800b5b:	e8 94 f8 ff ff       	call   8003f4 <unlock>
+  800b60:	83 c4 10             	add    $0x10,%esp
+    return ptr;
+  800b63:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800b66:	c9                   	leave
+  800b67:	c3                   	ret
+
+00800b68 <free>:
+
+void
+free(void *ptr) {
+  800b68:	55                   	push   %ebp
+  800b69:	89 e5                	mov    %esp,%ebp
+  800b6b:	83 ec 18             	sub    $0x18,%esp
+    if (ptr == NULL) {
+  800b6e:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  800b72:	0f 84 90 00 00 00    	je     800c08 <free+0xa0>
+        return;
+    }
+    size_t tag = TAG(ptr);
+  800b78:	8b 45 08             	mov    0x8(%ebp),%eax
+  800b7b:	8b 40 fc             	mov    -0x4(%eax),%eax
+  800b7e:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (tag & LARGE_OBJ) {
+  800b81:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800b84:	83 e0 04             	and    $0x4,%eax
+  800b87:	85 c0                	test   %eax,%eax
+  800b89:	74 10                	je     800b9b <free+0x33>
+        large_free(ptr);
+  800b8b:	83 ec 0c             	sub    $0xc,%esp
+  800b8e:	ff 75 08             	push   0x8(%ebp)
+  800b91:	e8 d0 fe ff ff       	call   800a66 <large_free>
+  800b96:	83 c4 10             	add    $0x10,%esp
+        return;
+  800b99:	eb 6e                	jmp    800c09 <free+0xa1>
+    }
+    lock(&malloc_lock);
+  800b9b:	83 ec 0c             	sub    $0xc,%esp
+  800b9e:	68 b4 31 80 00       	push   $0x8031b4
+  800ba3:	e8 f8 f7 ff ff       	call   8003a0 <lock>
+  800ba8:	83 c4 10             	add    $0x10,%esp
+    if (tag & SMALL_OBJ) {
+  800bab:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800bae:	83 e0 02             	and    $0x2,%eax
+  800bb1:	85 c0                	test   %eax,%eax
+  800bb3:	74 10                	je     800bc5 <free+0x5d>
+        small_free(ptr);
+  800bb5:	83 ec 0c             	sub    $0xc,%esp
+  800bb8:	ff 75 08             	push   0x8(%ebp)
+  800bbb:	e8 fd fd ff ff       	call   8009bd <small_free>
+  800bc0:	83 c4 10             	add    $0x10,%esp
+  800bc3:	eb 31                	jmp    800bf6 <free+0x8e>
+    }
+    else {
+        assert(tag & HEAP_ALLOC);
+  800bc5:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800bc8:	83 e0 01             	and    $0x1,%eax
+  800bcb:	85 c0                	test   %eax,%eax
+  800bcd:	75 19                	jne    800be8 <free+0x80>
+  800bcf:	68 78 22 80 00       	push   $0x802278
+  800bd4:	68 89 22 80 00       	push   $0x802289
+  800bd9:	68 22 01 00 00       	push   $0x122
+  800bde:	68 9e 22 80 00       	push   $0x80229e
+  800be3:	e8 32 01 00 00       	call   800d1a <__panic>
+        heap_free(ptr);
+  800be8:	83 ec 0c             	sub    $0xc,%esp
+  800beb:	ff 75 08             	push   0x8(%ebp)
+  800bee:	e8 60 fc ff ff       	call   800853 <heap_free>
+  800bf3:	83 c4 10             	add    $0x10,%esp
+    }
+    unlock(&malloc_lock);
+  800bf6:	83 ec 0c             	sub    $0xc,%esp
+  800bf9:	68 b4 31 80 00       	push   $0x8031b4
+  800bfe:	e8 f1 f7 ff ff       	call   8003f4 <unlock>
+  800c03:	83 c4 10             	add    $0x10,%esp
+  800c06:	eb 01                	jmp    800c09 <free+0xa1>
+        return;
+  800c08:	90                   	nop
+}
+  800c09:	c9                   	leave
+  800c0a:	c3                   	ret
+
+00800c0b <calloc>:
+
+void *
+calloc(size_t nmemb, size_t size) {
+  800c0b:	55                   	push   %ebp
+  800c0c:	89 e5                	mov    %esp,%ebp
+  800c0e:	83 ec 18             	sub    $0x18,%esp
+    if (nmemb != 0 && size > (size_t)-1 / nmemb) {
+  800c11:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  800c15:	74 19                	je     800c30 <calloc+0x25>
+  800c17:	b8 ff ff ff ff       	mov    $0xffffffff,%eax
+  800c1c:	ba 00 00 00 00       	mov    $0x0,%edx
+  800c21:	f7 75 08             	divl   0x8(%ebp)
+  800c24:	3b 45 0c             	cmp    0xc(%ebp),%eax
+  800c27:	73 07                	jae    800c30 <calloc+0x25>
+        return NULL;
+  800c29:	b8 00 00 00 00       	mov    $0x0,%eax
+  800c2e:	eb 37                	jmp    800c67 <calloc+0x5c>
+    }
+    void *ptr;
+    if ((ptr = malloc(nmemb * size)) != NULL) {
+  800c30:	8b 45 08             	mov    0x8(%ebp),%eax
+  800c33:	0f af 45 0c          	imul   0xc(%ebp),%eax
+  800c37:	83 ec 0c             	sub    $0xc,%esp
+  800c3a:	50                   	push   %eax
+  800c3b:	e8 97 fe ff ff       	call   800ad7 <malloc>
+  800c40:	83 c4 10             	add    $0x10,%esp
+  800c43:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800c46:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  800c4a:	74 18                	je     800c64 <calloc+0x59>
+        memset(ptr, 0, nmemb * size);
+  800c4c:	8b 45 08             	mov    0x8(%ebp),%eax
+  800c4f:	0f af 45 0c          	imul   0xc(%ebp),%eax
+  800c53:	83 ec 04             	sub    $0x4,%esp
+  800c56:	50                   	push   %eax
+  800c57:	6a 00                	push   $0x0
+  800c59:	ff 75 f4             	push   -0xc(%ebp)
+  800c5c:	e8 a0 13 00 00       	call   802001 <memset>
+  800c61:	83 c4 10             	add    $0x10,%esp
+    }
+    return ptr;
+  800c64:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800c67:	c9                   	leave
+  800c68:	c3                   	ret
+
+00800c69 <realloc>:
+
+void *
+realloc(void *ptr, size_t size) {
+  800c69:	55                   	push   %ebp
+  800c6a:	89 e5                	mov    %esp,%ebp
+  800c6c:	83 ec 18             	sub    $0x18,%esp
+    if (ptr == NULL) {
+  800c6f:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  800c73:	75 13                	jne    800c88 <realloc+0x1f>
+        return malloc(size);
+  800c75:	83 ec 0c             	sub    $0xc,%esp
+  800c78:	ff 75 0c             	push   0xc(%ebp)
+  800c7b:	e8 57 fe ff ff       	call   800ad7 <malloc>
+  800c80:	83 c4 10             	add    $0x10,%esp
+  800c83:	e9 90 00 00 00       	jmp    800d18 <realloc+0xaf>
+    }
+    if (size == 0) {
+  800c88:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  800c8c:	75 15                	jne    800ca3 <realloc+0x3a>
+        free(ptr);
+  800c8e:	83 ec 0c             	sub    $0xc,%esp
+  800c91:	ff 75 08             	push   0x8(%ebp)
+  800c94:	e8 cf fe ff ff       	call   800b68 <free>
+  800c99:	83 c4 10             	add    $0x10,%esp
+        return NULL;
+  800c9c:	b8 00 00 00 00       	mov    $0x0,%eax
+  800ca1:	eb 75                	jmp    800d18 <realloc+0xaf>
+    }
+    size_t old_size = usable_size(ptr);
+  800ca3:	83 ec 0c             	sub    $0xc,%esp
+  800ca6:	ff 75 08             	push   0x8(%ebp)
+  800ca9:	e8 e1 fd ff ff       	call   800a8f <usable_size>
+  800cae:	83 c4 10             	add    $0x10,%esp
+  800cb1:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (size <= old_size && (size > SMALL_MAX || old_size <= SMALL_MAX)) {
+  800cb4:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800cb7:	39 45 f4             	cmp    %eax,-0xc(%ebp)
+  800cba:	72 17                	jb     800cd3 <realloc+0x6a>
+  800cbc:	81 7d 0c 00 08 00 00 	cmpl   $0x800,0xc(%ebp)
+  800cc3:	77 09                	ja     800cce <realloc+0x65>
+  800cc5:	81 7d f4 00 08 00 00 	cmpl   $0x800,-0xc(%ebp)
+  800ccc:	77 05                	ja     800cd3 <realloc+0x6a>
+        return ptr;
+  800cce:	8b 45 08             	mov    0x8(%ebp),%eax
+  800cd1:	eb 45                	jmp    800d18 <realloc+0xaf>
+    }
+    void *nptr;
+    if ((nptr = malloc(size)) != NULL) {
+  800cd3:	83 ec 0c             	sub    $0xc,%esp
+  800cd6:	ff 75 0c             	push   0xc(%ebp)
+  800cd9:	e8 f9 fd ff ff       	call   800ad7 <malloc>
+  800cde:	83 c4 10             	add    $0x10,%esp
+  800ce1:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  800ce4:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  800ce8:	74 2b                	je     800d15 <realloc+0xac>
+        memcpy(nptr, ptr, (size < old_size) ? size : old_size);
+  800cea:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  800ced:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800cf0:	39 c2                	cmp    %eax,%edx
+  800cf2:	0f 46 c2             	cmovbe %edx,%eax
+  800cf5:	83 ec 04             	sub    $0x4,%esp
+  800cf8:	50                   	push   %eax
+  800cf9:	ff 75 08             	push   0x8(%ebp)
+  800cfc:	ff 75 f0             	push   -0x10(%ebp)
+  800cff:	e8 de 13 00 00       	call   8020e2 <memcpy>
+  800d04:	83 c4 10             	add    $0x10,%esp
+        free(ptr);
+  800d07:	83 ec 0c             	sub    $0xc,%esp
+  800d0a:	ff 75 08             	push   0x8(%ebp)
+  800d0d:	e8 56 fe ff ff       	call   800b68 <free>
+  800d12:	83 c4 10             	add    $0x10,%esp
+    }
+    return nptr;
+  800d15:	8b 45 f0             	mov    -0x10(%ebp),%eax
+}
+  800d18:	c9                   	leave
+  800d19:	c3                   	ret
+
+00800d1a <__panic>:
+#include <stdio.h>
+#include <ulib.h>
+#include <error.h>
+
+void
+__panic(const char *file, int line, const char *fmt, ...) {
+  800d1a:	55                   	push   %ebp
+  800d1b:	89 e5                	mov    %esp,%ebp
+  800d1d:	83 ec 18             	sub    $0x18,%esp
+    // print the 'message'
+    va_list ap;
+    va_start(ap, fmt);
+  800d20:	8d 45 14             	lea    0x14(%ebp),%eax
+  800d23:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    cprintf("user panic at %s:%d:\n    ", file, line);
+  800d26:	83 ec 04             	sub    $0x4,%esp
+  800d29:	ff 75 0c             	push   0xc(%ebp)
+  800d2c:	ff 75 08             	push   0x8(%ebp)
+  800d2f:	68 b1 22 80 00       	push   $0x8022b1
+  800d34:	e8 cb 00 00 00       	call   800e04 <cprintf>
+  800d39:	83 c4 10             	add    $0x10,%esp
+    vcprintf(fmt, ap);
+  800d3c:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800d3f:	83 ec 08             	sub    $0x8,%esp
+  800d42:	50                   	push   %eax
+  800d43:	ff 75 10             	push   0x10(%ebp)
+  800d46:	e8 88 00 00 00       	call   800dd3 <vcprintf>
+  800d4b:	83 c4 10             	add    $0x10,%esp
+    cprintf("\n");
+  800d4e:	83 ec 0c             	sub    $0xc,%esp
+  800d51:	68 cb 22 80 00       	push   $0x8022cb
+  800d56:	e8 a9 00 00 00       	call   800e04 <cprintf>
+  800d5b:	83 c4 10             	add    $0x10,%esp
+    va_end(ap);
+    exit(-E_PANIC);
+  800d5e:	83 ec 0c             	sub    $0xc,%esp
+  800d61:	6a f6                	push   $0xfffffff6
+  800d63:	e8 31 05 00 00       	call   801299 <exit>
+
+00800d68 <__warn>:
+}
+
+void
+__warn(const char *file, int line, const char *fmt, ...) {
+  800d68:	55                   	push   %ebp
+  800d69:	89 e5                	mov    %esp,%ebp
+  800d6b:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+    va_start(ap, fmt);
+  800d6e:	8d 45 14             	lea    0x14(%ebp),%eax
+  800d71:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    cprintf("user warning at %s:%d:\n    ", file, line);
+  800d74:	83 ec 04             	sub    $0x4,%esp
+  800d77:	ff 75 0c             	push   0xc(%ebp)
+  800d7a:	ff 75 08             	push   0x8(%ebp)
+  800d7d:	68 cd 22 80 00       	push   $0x8022cd
+  800d82:	e8 7d 00 00 00       	call   800e04 <cprintf>
+  800d87:	83 c4 10             	add    $0x10,%esp
+    vcprintf(fmt, ap);
+  800d8a:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800d8d:	83 ec 08             	sub    $0x8,%esp
+  800d90:	50                   	push   %eax
+  800d91:	ff 75 10             	push   0x10(%ebp)
+  800d94:	e8 3a 00 00 00       	call   800dd3 <vcprintf>
+  800d99:	83 c4 10             	add    $0x10,%esp
+    cprintf("\n");
+  800d9c:	83 ec 0c             	sub    $0xc,%esp
+  800d9f:	68 cb 22 80 00       	push   $0x8022cb
+  800da4:	e8 5b 00 00 00       	call   800e04 <cprintf>
+  800da9:	83 c4 10             	add    $0x10,%esp
+    va_end(ap);
+}
+  800dac:	90                   	nop
+  800dad:	c9                   	leave
+  800dae:	c3                   	ret
+
+00800daf <cputch>:
+/* *
+ * cputch - writes a single character @c to stdout, and it will
+ * increace the value of counter pointed by @cnt.
+ * */
+static void
+cputch(int c, int *cnt) {
+  800daf:	55                   	push   %ebp
+  800db0:	89 e5                	mov    %esp,%ebp
+  800db2:	83 ec 08             	sub    $0x8,%esp
+    sys_putc(c);
+  800db5:	83 ec 0c             	sub    $0xc,%esp
+  800db8:	ff 75 08             	push   0x8(%ebp)
+  800dbb:	e8 3b 02 00 00       	call   800ffb <sys_putc>
+  800dc0:	83 c4 10             	add    $0x10,%esp
+    (*cnt) ++;
+  800dc3:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800dc6:	8b 00                	mov    (%eax),%eax
+  800dc8:	8d 50 01             	lea    0x1(%eax),%edx
+  800dcb:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800dce:	89 10                	mov    %edx,(%eax)
+}
+  800dd0:	90                   	nop
+  800dd1:	c9                   	leave
+  800dd2:	c3                   	ret
+
+00800dd3 <vcprintf>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want cprintf() instead.
+ * */
+int
+vcprintf(const char *fmt, va_list ap) {
+  800dd3:	55                   	push   %ebp
+  800dd4:	89 e5                	mov    %esp,%ebp
+  800dd6:	83 ec 18             	sub    $0x18,%esp
+    int cnt = 0;
+  800dd9:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    vprintfmt((void*)cputch, NO_FD, &cnt, fmt, ap);
+  800de0:	83 ec 0c             	sub    $0xc,%esp
+  800de3:	ff 75 0c             	push   0xc(%ebp)
+  800de6:	ff 75 08             	push   0x8(%ebp)
+  800de9:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800dec:	50                   	push   %eax
+  800ded:	68 d9 6a ff ff       	push   $0xffff6ad9
+  800df2:	68 af 0d 80 00       	push   $0x800daf
+  800df7:	e8 3f 09 00 00       	call   80173b <vprintfmt>
+  800dfc:	83 c4 20             	add    $0x20,%esp
+    return cnt;
+  800dff:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800e02:	c9                   	leave
+  800e03:	c3                   	ret
+
+00800e04 <cprintf>:
+ *
+ * The return value is the number of characters which would be
+ * written to stdout.
+ * */
+int
+cprintf(const char *fmt, ...) {
+  800e04:	55                   	push   %ebp
+  800e05:	89 e5                	mov    %esp,%ebp
+  800e07:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  800e0a:	8d 45 0c             	lea    0xc(%ebp),%eax
+  800e0d:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    int cnt = vcprintf(fmt, ap);
+  800e10:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800e13:	83 ec 08             	sub    $0x8,%esp
+  800e16:	50                   	push   %eax
+  800e17:	ff 75 08             	push   0x8(%ebp)
+  800e1a:	e8 b4 ff ff ff       	call   800dd3 <vcprintf>
+  800e1f:	83 c4 10             	add    $0x10,%esp
+  800e22:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+
+    return cnt;
+  800e25:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800e28:	c9                   	leave
+  800e29:	c3                   	ret
+
+00800e2a <cputs>:
+/* *
+ * cputs- writes the string pointed by @str to stdout and
+ * appends a newline character.
+ * */
+int
+cputs(const char *str) {
+  800e2a:	55                   	push   %ebp
+  800e2b:	89 e5                	mov    %esp,%ebp
+  800e2d:	83 ec 18             	sub    $0x18,%esp
+    int cnt = 0;
+  800e30:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+    char c;
+    while ((c = *str ++) != '\0') {
+  800e37:	eb 14                	jmp    800e4d <cputs+0x23>
+        cputch(c, &cnt);
+  800e39:	0f be 45 f7          	movsbl -0x9(%ebp),%eax
+  800e3d:	83 ec 08             	sub    $0x8,%esp
+  800e40:	8d 55 f0             	lea    -0x10(%ebp),%edx
+  800e43:	52                   	push   %edx
+  800e44:	50                   	push   %eax
+  800e45:	e8 65 ff ff ff       	call   800daf <cputch>
+  800e4a:	83 c4 10             	add    $0x10,%esp
+    while ((c = *str ++) != '\0') {
+  800e4d:	8b 45 08             	mov    0x8(%ebp),%eax
+  800e50:	8d 50 01             	lea    0x1(%eax),%edx
+  800e53:	89 55 08             	mov    %edx,0x8(%ebp)
+  800e56:	0f b6 00             	movzbl (%eax),%eax
+  800e59:	88 45 f7             	mov    %al,-0x9(%ebp)
+  800e5c:	80 7d f7 00          	cmpb   $0x0,-0x9(%ebp)
+  800e60:	75 d7                	jne    800e39 <cputs+0xf>
+    }
+    cputch('\n', &cnt);
+  800e62:	83 ec 08             	sub    $0x8,%esp
+  800e65:	8d 45 f0             	lea    -0x10(%ebp),%eax
+  800e68:	50                   	push   %eax
+  800e69:	6a 0a                	push   $0xa
+  800e6b:	e8 3f ff ff ff       	call   800daf <cputch>
+  800e70:	83 c4 10             	add    $0x10,%esp
+    return cnt;
+  800e73:	8b 45 f0             	mov    -0x10(%ebp),%eax
+}
+  800e76:	c9                   	leave
+  800e77:	c3                   	ret
+
+00800e78 <fputch>:
+
+
+static void
+fputch(char c, int *cnt, int fd) {
+  800e78:	55                   	push   %ebp
+  800e79:	89 e5                	mov    %esp,%ebp
+  800e7b:	83 ec 18             	sub    $0x18,%esp
+  800e7e:	8b 45 08             	mov    0x8(%ebp),%eax
+  800e81:	88 45 f4             	mov    %al,-0xc(%ebp)
+    write(fd, &c, sizeof(char));
+  800e84:	83 ec 04             	sub    $0x4,%esp
+  800e87:	6a 01                	push   $0x1
+  800e89:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800e8c:	50                   	push   %eax
+  800e8d:	ff 75 10             	push   0x10(%ebp)
+  800e90:	e8 b1 f2 ff ff       	call   800146 <write>
+  800e95:	83 c4 10             	add    $0x10,%esp
+    (*cnt) ++;
+  800e98:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800e9b:	8b 00                	mov    (%eax),%eax
+  800e9d:	8d 50 01             	lea    0x1(%eax),%edx
+  800ea0:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800ea3:	89 10                	mov    %edx,(%eax)
+}
+  800ea5:	90                   	nop
+  800ea6:	c9                   	leave
+  800ea7:	c3                   	ret
+
+00800ea8 <vfprintf>:
+
+int
+vfprintf(int fd, const char *fmt, va_list ap) {
+  800ea8:	55                   	push   %ebp
+  800ea9:	89 e5                	mov    %esp,%ebp
+  800eab:	83 ec 18             	sub    $0x18,%esp
+    int cnt = 0;
+  800eae:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    vprintfmt((void*)fputch, fd, &cnt, fmt, ap);
+  800eb5:	83 ec 0c             	sub    $0xc,%esp
+  800eb8:	ff 75 10             	push   0x10(%ebp)
+  800ebb:	ff 75 0c             	push   0xc(%ebp)
+  800ebe:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800ec1:	50                   	push   %eax
+  800ec2:	ff 75 08             	push   0x8(%ebp)
+  800ec5:	68 78 0e 80 00       	push   $0x800e78
+  800eca:	e8 6c 08 00 00       	call   80173b <vprintfmt>
+  800ecf:	83 c4 20             	add    $0x20,%esp
+    return cnt;
+  800ed2:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800ed5:	c9                   	leave
+  800ed6:	c3                   	ret
+
+00800ed7 <fprintf>:
+
+int
+fprintf(int fd, const char *fmt, ...) {
+  800ed7:	55                   	push   %ebp
+  800ed8:	89 e5                	mov    %esp,%ebp
+  800eda:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  800edd:	8d 45 10             	lea    0x10(%ebp),%eax
+  800ee0:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    int cnt = vfprintf(fd, fmt, ap);
+  800ee3:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800ee6:	83 ec 04             	sub    $0x4,%esp
+  800ee9:	50                   	push   %eax
+  800eea:	ff 75 0c             	push   0xc(%ebp)
+  800eed:	ff 75 08             	push   0x8(%ebp)
+  800ef0:	e8 b3 ff ff ff       	call   800ea8 <vfprintf>
+  800ef5:	83 c4 10             	add    $0x10,%esp
+  800ef8:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+
+    return cnt;
+  800efb:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800efe:	c9                   	leave
+  800eff:	c3                   	ret
+
+00800f00 <syscall>:
+
+
+#define MAX_ARGS            5
+
+static inline int
+syscall(int num, ...) {
+  800f00:	55                   	push   %ebp
+  800f01:	89 e5                	mov    %esp,%ebp
+  800f03:	57                   	push   %edi
+  800f04:	56                   	push   %esi
+  800f05:	53                   	push   %ebx
+  800f06:	83 ec 20             	sub    $0x20,%esp
+    va_list ap;
+    va_start(ap, num);
+  800f09:	8d 45 0c             	lea    0xc(%ebp),%eax
+  800f0c:	89 45 e8             	mov    %eax,-0x18(%ebp)
+    uint32_t a[MAX_ARGS];
+    int i, ret;
+    for (i = 0; i < MAX_ARGS; i ++) {
+  800f0f:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+  800f16:	eb 16                	jmp    800f2e <syscall+0x2e>
+        a[i] = va_arg(ap, uint32_t);
+  800f18:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800f1b:	8d 50 04             	lea    0x4(%eax),%edx
+  800f1e:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  800f21:	8b 10                	mov    (%eax),%edx
+  800f23:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800f26:	89 54 85 d4          	mov    %edx,-0x2c(%ebp,%eax,4)
+    for (i = 0; i < MAX_ARGS; i ++) {
+  800f2a:	83 45 f0 01          	addl   $0x1,-0x10(%ebp)
+  800f2e:	83 7d f0 04          	cmpl   $0x4,-0x10(%ebp)
+  800f32:	7e e4                	jle    800f18 <syscall+0x18>
+    asm volatile (
+        "int %1;"
+        : "=a" (ret)
+        : "i" (T_SYSCALL),
+          "a" (num),
+          "d" (a[0]),
+  800f34:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+          "c" (a[1]),
+  800f37:	8b 4d d8             	mov    -0x28(%ebp),%ecx
+          "b" (a[2]),
+  800f3a:	8b 5d dc             	mov    -0x24(%ebp),%ebx
+          "D" (a[3]),
+  800f3d:	8b 7d e0             	mov    -0x20(%ebp),%edi
+          "S" (a[4])
+  800f40:	8b 75 e4             	mov    -0x1c(%ebp),%esi
+    asm volatile (
+  800f43:	8b 45 08             	mov    0x8(%ebp),%eax
+  800f46:	cd 80                	int    $0x80
+  800f48:	89 45 ec             	mov    %eax,-0x14(%ebp)
+        : "cc", "memory");
+    return ret;
+  800f4b:	8b 45 ec             	mov    -0x14(%ebp),%eax
+}
+  800f4e:	83 c4 20             	add    $0x20,%esp
+  800f51:	5b                   	pop    %ebx
+  800f52:	5e                   	pop    %esi
+  800f53:	5f                   	pop    %edi
+  800f54:	5d                   	pop    %ebp
+  800f55:	c3                   	ret
+
+00800f56 <sys_exit>:
+
+int
+sys_exit(int error_code) {
+  800f56:	55                   	push   %ebp
+  800f57:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_exit, error_code);
+  800f59:	ff 75 08             	push   0x8(%ebp)
+  800f5c:	6a 01                	push   $0x1
+  800f5e:	e8 9d ff ff ff       	call   800f00 <syscall>
+  800f63:	83 c4 08             	add    $0x8,%esp
+}
+  800f66:	c9                   	leave
+  800f67:	c3                   	ret
+
+00800f68 <sys_fork>:
+
+int
+sys_fork(void) {
+  800f68:	55                   	push   %ebp
+  800f69:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_fork);
+  800f6b:	6a 02                	push   $0x2
+  800f6d:	e8 8e ff ff ff       	call   800f00 <syscall>
+  800f72:	83 c4 04             	add    $0x4,%esp
+}
+  800f75:	c9                   	leave
+  800f76:	c3                   	ret
+
+00800f77 <sys_wait>:
+
+int
+sys_wait(int pid, int *store) {
+  800f77:	55                   	push   %ebp
+  800f78:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_wait, pid, store);
+  800f7a:	ff 75 0c             	push   0xc(%ebp)
+  800f7d:	ff 75 08             	push   0x8(%ebp)
+  800f80:	6a 03                	push   $0x3
+  800f82:	e8 79 ff ff ff       	call   800f00 <syscall>
+  800f87:	83 c4 0c             	add    $0xc,%esp
+}
+  800f8a:	c9                   	leave
+  800f8b:	c3                   	ret
+
+00800f8c <sys_yield>:
+
+int
+sys_yield(void) {
+  800f8c:	55                   	push   %ebp
+  800f8d:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_yield);
+  800f8f:	6a 0a                	push   $0xa
+  800f91:	e8 6a ff ff ff       	call   800f00 <syscall>
+  800f96:	83 c4 04             	add    $0x4,%esp
+}
+  800f99:	c9                   	leave
+  800f9a:	c3                   	ret
+
+00800f9b <sys_kill>:
+
+int
+sys_kill(int pid) {
+  800f9b:	55                   	push   %ebp
+  800f9c:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_kill, pid);
+  800f9e:	ff 75 08             	push   0x8(%ebp)
+  800fa1:	6a 0c                	push   $0xc
+  800fa3:	e8 58 ff ff ff       	call   800f00 <syscall>
+  800fa8:	83 c4 08             	add    $0x8,%esp
+}
+  800fab:	c9                   	leave
+  800fac:	c3                   	ret
+
+00800fad <sys_getpid>:
+
+int
+sys_getpid(void) {
+  800fad:	55                   	push   %ebp
+  800fae:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_getpid);
+  800fb0:	6a 12                	push   $0x12
+  800fb2:	e8 49 ff ff ff       	call   800f00 <syscall>
+  800fb7:	83 c4 04             	add    $0x4,%esp
+}
+  800fba:	c9                   	leave
+  800fbb:	c3                   	ret
+
+00800fbc <sys_brk>:
+
+int
+sys_brk(uintptr_t *brk_store) {
+  800fbc:	55                   	push   %ebp
+  800fbd:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_brk, brk_store);
+  800fbf:	ff 75 08             	push   0x8(%ebp)
+  800fc2:	6a 13                	push   $0x13
+  800fc4:	e8 37 ff ff ff       	call   800f00 <syscall>
+  800fc9:	83 c4 08             	add    $0x8,%esp
+}
+  800fcc:	c9                   	leave
+  800fcd:	c3                   	ret
+
+00800fce <sys_mmap>:
+
+int
+sys_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags) {
+  800fce:	55                   	push   %ebp
+  800fcf:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_mmap, addr_store, len, mmap_flags);
+  800fd1:	ff 75 10             	push   0x10(%ebp)
+  800fd4:	ff 75 0c             	push   0xc(%ebp)
+  800fd7:	ff 75 08             	push   0x8(%ebp)
+  800fda:	6a 14                	push   $0x14
+  800fdc:	e8 1f ff ff ff       	call   800f00 <syscall>
+  800fe1:	83 c4 10             	add    $0x10,%esp
+}
+  800fe4:	c9                   	leave
+  800fe5:	c3                   	ret
+
+00800fe6 <sys_munmap>:
+
+int
+sys_munmap(uintptr_t addr, size_t len) {
+  800fe6:	55                   	push   %ebp
+  800fe7:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_munmap, addr, len);
+  800fe9:	ff 75 0c             	push   0xc(%ebp)
+  800fec:	ff 75 08             	push   0x8(%ebp)
+  800fef:	6a 15                	push   $0x15
+  800ff1:	e8 0a ff ff ff       	call   800f00 <syscall>
+  800ff6:	83 c4 0c             	add    $0xc,%esp
+}
+  800ff9:	c9                   	leave
+  800ffa:	c3                   	ret
+
+00800ffb <sys_putc>:
+
+int
+sys_putc(int c) {
+  800ffb:	55                   	push   %ebp
+  800ffc:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_putc, c);
+  800ffe:	ff 75 08             	push   0x8(%ebp)
+  801001:	6a 1e                	push   $0x1e
+  801003:	e8 f8 fe ff ff       	call   800f00 <syscall>
+  801008:	83 c4 08             	add    $0x8,%esp
+}
+  80100b:	c9                   	leave
+  80100c:	c3                   	ret
+
+0080100d <sys_pgdir>:
+
+int
+sys_pgdir(void) {
+  80100d:	55                   	push   %ebp
+  80100e:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_pgdir);
+  801010:	6a 1f                	push   $0x1f
+  801012:	e8 e9 fe ff ff       	call   800f00 <syscall>
+  801017:	83 c4 04             	add    $0x4,%esp
+}
+  80101a:	c9                   	leave
+  80101b:	c3                   	ret
+
+0080101c <sys_lab6_set_priority>:
+
+void
+sys_lab6_set_priority(uint32_t priority)
+{
+  80101c:	55                   	push   %ebp
+  80101d:	89 e5                	mov    %esp,%ebp
+    syscall(SYS_lab6_set_priority, priority);
+  80101f:	ff 75 08             	push   0x8(%ebp)
+  801022:	68 ff 00 00 00       	push   $0xff
+  801027:	e8 d4 fe ff ff       	call   800f00 <syscall>
+  80102c:	83 c4 08             	add    $0x8,%esp
+}
+  80102f:	90                   	nop
+  801030:	c9                   	leave
+  801031:	c3                   	ret
+
+00801032 <sys_sleep>:
+
+int
+sys_sleep(unsigned int time) {
+  801032:	55                   	push   %ebp
+  801033:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_sleep, time);
+  801035:	ff 75 08             	push   0x8(%ebp)
+  801038:	6a 0b                	push   $0xb
+  80103a:	e8 c1 fe ff ff       	call   800f00 <syscall>
+  80103f:	83 c4 08             	add    $0x8,%esp
+}
+  801042:	c9                   	leave
+  801043:	c3                   	ret
+
+00801044 <sys_gettime>:
+
+size_t
+sys_gettime(void) {
+  801044:	55                   	push   %ebp
+  801045:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_gettime);
+  801047:	6a 11                	push   $0x11
+  801049:	e8 b2 fe ff ff       	call   800f00 <syscall>
+  80104e:	83 c4 04             	add    $0x4,%esp
+}
+  801051:	c9                   	leave
+  801052:	c3                   	ret
+
+00801053 <sys_exec>:
+
+int
+sys_exec(const char *name, int argc, const char **argv) {
+  801053:	55                   	push   %ebp
+  801054:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_exec, name, argc, argv);
+  801056:	ff 75 10             	push   0x10(%ebp)
+  801059:	ff 75 0c             	push   0xc(%ebp)
+  80105c:	ff 75 08             	push   0x8(%ebp)
+  80105f:	6a 04                	push   $0x4
+  801061:	e8 9a fe ff ff       	call   800f00 <syscall>
+  801066:	83 c4 10             	add    $0x10,%esp
+}
+  801069:	c9                   	leave
+  80106a:	c3                   	ret
+
+0080106b <sys_open>:
+
+int
+sys_open(const char *path, uint32_t open_flags) {
+  80106b:	55                   	push   %ebp
+  80106c:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_open, path, open_flags);
+  80106e:	ff 75 0c             	push   0xc(%ebp)
+  801071:	ff 75 08             	push   0x8(%ebp)
+  801074:	6a 64                	push   $0x64
+  801076:	e8 85 fe ff ff       	call   800f00 <syscall>
+  80107b:	83 c4 0c             	add    $0xc,%esp
+}
+  80107e:	c9                   	leave
+  80107f:	c3                   	ret
+
+00801080 <sys_close>:
+
+int
+sys_close(int fd) {
+  801080:	55                   	push   %ebp
+  801081:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_close, fd);
+  801083:	ff 75 08             	push   0x8(%ebp)
+  801086:	6a 65                	push   $0x65
+  801088:	e8 73 fe ff ff       	call   800f00 <syscall>
+  80108d:	83 c4 08             	add    $0x8,%esp
+}
+  801090:	c9                   	leave
+  801091:	c3                   	ret
+
+00801092 <sys_read>:
+
+int
+sys_read(int fd, void *base, size_t len) {
+  801092:	55                   	push   %ebp
+  801093:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_read, fd, base, len);
+  801095:	ff 75 10             	push   0x10(%ebp)
+  801098:	ff 75 0c             	push   0xc(%ebp)
+  80109b:	ff 75 08             	push   0x8(%ebp)
+  80109e:	6a 66                	push   $0x66
+  8010a0:	e8 5b fe ff ff       	call   800f00 <syscall>
+  8010a5:	83 c4 10             	add    $0x10,%esp
+}
+  8010a8:	c9                   	leave
+  8010a9:	c3                   	ret
+
+008010aa <sys_write>:
+
+int
+sys_write(int fd, void *base, size_t len) {
+  8010aa:	55                   	push   %ebp
+  8010ab:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_write, fd, base, len);
+  8010ad:	ff 75 10             	push   0x10(%ebp)
+  8010b0:	ff 75 0c             	push   0xc(%ebp)
+  8010b3:	ff 75 08             	push   0x8(%ebp)
+  8010b6:	6a 67                	push   $0x67
+  8010b8:	e8 43 fe ff ff       	call   800f00 <syscall>
+  8010bd:	83 c4 10             	add    $0x10,%esp
+}
+  8010c0:	c9                   	leave
+  8010c1:	c3                   	ret
+
+008010c2 <sys_pread>:
+
+int
+sys_pread(int fd, void *base, size_t len, off_t pos) {
+  8010c2:	55                   	push   %ebp
+  8010c3:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_pread, fd, base, len, pos);
+  8010c5:	ff 75 14             	push   0x14(%ebp)
+  8010c8:	ff 75 10             	push   0x10(%ebp)
+  8010cb:	ff 75 0c             	push   0xc(%ebp)
+  8010ce:	ff 75 08             	push   0x8(%ebp)
+  8010d1:	6a 69                	push   $0x69
+  8010d3:	e8 28 fe ff ff       	call   800f00 <syscall>
+  8010d8:	83 c4 14             	add    $0x14,%esp
+}
+  8010db:	c9                   	leave
+  8010dc:	c3                   	ret
+
+008010dd <sys_pwrite>:
+
+int
+sys_pwrite(int fd, void *base, size_t len, off_t pos) {
+  8010dd:	55                   	push   %ebp
+  8010de:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_pwrite, fd, base, len, pos);
+  8010e0:	ff 75 14             	push   0x14(%ebp)
+  8010e3:	ff 75 10             	push   0x10(%ebp)
+  8010e6:	ff 75 0c             	push   0xc(%ebp)
+  8010e9:	ff 75 08             	push   0x8(%ebp)
+  8010ec:	6a 6a                	push   $0x6a
+  8010ee:	e8 0d fe ff ff       	call   800f00 <syscall>
+  8010f3:	83 c4 14             	add    $0x14,%esp
+}
+  8010f6:	c9                   	leave
+  8010f7:	c3                   	ret
+
+008010f8 <sys_readv>:
+
+int
+sys_readv(int fd, struct iovec *iov, int iovcnt) {
+  8010f8:	55                   	push   %ebp
+  8010f9:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_readv, fd, iov, iovcnt);
+  8010fb:	ff 75 10             	push   0x10(%ebp)
+  8010fe:	ff 75 0c             	push   0xc(%ebp)
+  801101:	ff 75 08             	push   0x8(%ebp)
+  801104:	6a 6b                	push   $0x6b
+  801106:	e8 f5 fd ff ff       	call   800f00 <syscall>
+  80110b:	83 c4 10             	add    $0x10,%esp
+}
+  80110e:	c9                   	leave
+  80110f:	c3                   	ret
+
+00801110 <sys_writev>:
+
+int
+sys_writev(int fd, struct iovec *iov, int iovcnt) {
+  801110:	55                   	push   %ebp
+  801111:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_writev, fd, iov, iovcnt);
+  801113:	ff 75 10             	push   0x10(%ebp)
+  801116:	ff 75 0c             	push   0xc(%ebp)
+  801119:	ff 75 08             	push   0x8(%ebp)
+  80111c:	6a 6c                	push   $0x6c
+  80111e:	e8 dd fd ff ff       	call   800f00 <syscall>
+  801123:	83 c4 10             	add    $0x10,%esp
+}
+  801126:	c9                   	leave
+  801127:	c3                   	ret
+
+00801128 <sys_seek>:
+
+int
+sys_seek(int fd, off_t pos, int whence) {
+  801128:	55                   	push   %ebp
+  801129:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_seek, fd, pos, whence);
+  80112b:	ff 75 10             	push   0x10(%ebp)
+  80112e:	ff 75 0c             	push   0xc(%ebp)
+  801131:	ff 75 08             	push   0x8(%ebp)
+  801134:	6a 68                	push   $0x68
+  801136:	e8 c5 fd ff ff       	call   800f00 <syscall>
+  80113b:	83 c4 10             	add    $0x10,%esp
+}
+  80113e:	c9                   	leave
+  80113f:	c3                   	ret
+
+00801140 <sys_fstat>:
+
+int
+sys_fstat(int fd, struct stat *stat) {
+  801140:	55                   	push   %ebp
+  801141:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_fstat, fd, stat);
+  801143:	ff 75 0c             	push   0xc(%ebp)
+  801146:	ff 75 08             	push   0x8(%ebp)
+  801149:	6a 6e                	push   $0x6e
+  80114b:	e8 b0 fd ff ff       	call   800f00 <syscall>
+  801150:	83 c4 0c             	add    $0xc,%esp
+}
+  801153:	c9                   	leave
+  801154:	c3                   	ret
+
+00801155 <sys_fsync>:
+
+int
+sys_fsync(int fd) {
+  801155:	55                   	push   %ebp
+  801156:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_fsync, fd);
+  801158:	ff 75 08             	push   0x8(%ebp)
+  80115b:	6a 6f                	push   $0x6f
+  80115d:	e8 9e fd ff ff       	call   800f00 <syscall>
+  801162:	83 c4 08             	add    $0x8,%esp
+}
+  801165:	c9                   	leave
+  801166:	c3                   	ret
+
+00801167 <sys_fallocate>:
+
+int
+sys_fallocate(int fd, off_t pos, off_t len) {
+  801167:	55                   	push   %ebp
+  801168:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_fallocate, fd, pos, len);
+  80116a:	ff 75 10             	push   0x10(%ebp)
+  80116d:	ff 75 0c             	push   0xc(%ebp)
+  801170:	ff 75 08             	push   0x8(%ebp)
+  801173:	6a 70                	push   $0x70
+  801175:	e8 86 fd ff ff       	call   800f00 <syscall>
+  80117a:	83 c4 10             	add    $0x10,%esp
+}
+  80117d:	c9                   	leave
+  80117e:	c3                   	ret
+
+0080117f <sys_getcwd>:
+
+int
+sys_getcwd(char *buffer, size_t len) {
+  80117f:	55                   	push   %ebp
+  801180:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_getcwd, buffer, len);
+  801182:	ff 75 0c             	push   0xc(%ebp)
+  801185:	ff 75 08             	push   0x8(%ebp)
+  801188:	6a 79                	push   $0x79
+  80118a:	e8 71 fd ff ff       	call   800f00 <syscall>
+  80118f:	83 c4 0c             	add    $0xc,%esp
+}
+  801192:	c9                   	leave
+  801193:	c3                   	ret
+
+00801194 <sys_getdirentry>:
+
+int
+sys_getdirentry(int fd, struct dirent *dirent) {
+  801194:	55                   	push   %ebp
+  801195:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_getdirentry, fd, dirent);
+  801197:	ff 75 0c             	push   0xc(%ebp)
+  80119a:	ff 75 08             	push   0x8(%ebp)
+  80119d:	68 80 00 00 00       	push   $0x80
+  8011a2:	e8 59 fd ff ff       	call   800f00 <syscall>
+  8011a7:	83 c4 0c             	add    $0xc,%esp
+}
+  8011aa:	c9                   	leave
+  8011ab:	c3                   	ret
+
+008011ac <sys_dup>:
+
+int
+sys_dup(int fd1, int fd2) {
+  8011ac:	55                   	push   %ebp
+  8011ad:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_dup, fd1, fd2);
+  8011af:	ff 75 0c             	push   0xc(%ebp)
+  8011b2:	ff 75 08             	push   0x8(%ebp)
+  8011b5:	68 82 00 00 00       	push   $0x82
+  8011ba:	e8 41 fd ff ff       	call   800f00 <syscall>
+  8011bf:	83 c4 0c             	add    $0xc,%esp
+}
+  8011c2:	c9                   	leave
+  8011c3:	c3                   	ret
+
+008011c4 <try_lock>:
+try_lock(lock_t *l) {
+  8011c4:	55                   	push   %ebp
+  8011c5:	89 e5                	mov    %esp,%ebp
+  8011c7:	83 ec 10             	sub    $0x10,%esp
+  8011ca:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+  8011d1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8011d4:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    asm volatile ("btsl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  8011d7:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  8011da:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8011dd:	0f ab 02             	bts    %eax,(%edx)
+  8011e0:	19 c0                	sbb    %eax,%eax
+  8011e2:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    return oldbit != 0;
+  8011e5:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  8011e9:	0f 95 c0             	setne  %al
+  8011ec:	0f b6 c0             	movzbl %al,%eax
+}
+  8011ef:	c9                   	leave
+  8011f0:	c3                   	ret
+
+008011f1 <lock>:
+lock(lock_t *l) {
+  8011f1:	55                   	push   %ebp
+  8011f2:	89 e5                	mov    %esp,%ebp
+  8011f4:	83 ec 18             	sub    $0x18,%esp
+    if (try_lock(l)) {
+  8011f7:	ff 75 08             	push   0x8(%ebp)
+  8011fa:	e8 c5 ff ff ff       	call   8011c4 <try_lock>
+  8011ff:	83 c4 04             	add    $0x4,%esp
+  801202:	85 c0                	test   %eax,%eax
+  801204:	74 3c                	je     801242 <lock+0x51>
+        int step = 0;
+  801206:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+            yield();
+  80120d:	e8 eb 00 00 00       	call   8012fd <yield>
+            if (++ step == 100) {
+  801212:	83 45 f4 01          	addl   $0x1,-0xc(%ebp)
+  801216:	83 7d f4 64          	cmpl   $0x64,-0xc(%ebp)
+  80121a:	75 14                	jne    801230 <lock+0x3f>
+                step = 0;
+  80121c:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+                sleep(10);
+  801223:	83 ec 0c             	sub    $0xc,%esp
+  801226:	6a 0a                	push   $0xa
+  801228:	e8 e7 01 00 00       	call   801414 <sleep>
+  80122d:	83 c4 10             	add    $0x10,%esp
+        } while (try_lock(l));
+  801230:	83 ec 0c             	sub    $0xc,%esp
+  801233:	ff 75 08             	push   0x8(%ebp)
+  801236:	e8 89 ff ff ff       	call   8011c4 <try_lock>
+  80123b:	83 c4 10             	add    $0x10,%esp
+  80123e:	85 c0                	test   %eax,%eax
+  801240:	75 cb                	jne    80120d <lock+0x1c>
+}
+  801242:	90                   	nop
+  801243:	c9                   	leave
+  801244:	c3                   	ret
+
+00801245 <unlock>:
+unlock(lock_t *l) {
+  801245:	55                   	push   %ebp
+  801246:	89 e5                	mov    %esp,%ebp
+  801248:	83 ec 10             	sub    $0x10,%esp
+  80124b:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+  801252:	8b 45 08             	mov    0x8(%ebp),%eax
+  801255:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    asm volatile ("btrl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  801258:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  80125b:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80125e:	0f b3 02             	btr    %eax,(%edx)
+  801261:	19 c0                	sbb    %eax,%eax
+  801263:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    return oldbit != 0;
+  801266:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+}
+  80126a:	90                   	nop
+  80126b:	c9                   	leave
+  80126c:	c3                   	ret
+
+0080126d <lock_fork>:
+#include <lock.h>
+
+static lock_t fork_lock = INIT_LOCK;
+
+void
+lock_fork(void) {
+  80126d:	55                   	push   %ebp
+  80126e:	89 e5                	mov    %esp,%ebp
+  801270:	83 ec 08             	sub    $0x8,%esp
+    lock(&fork_lock);
+  801273:	83 ec 0c             	sub    $0xc,%esp
+  801276:	68 b8 31 80 00       	push   $0x8031b8
+  80127b:	e8 71 ff ff ff       	call   8011f1 <lock>
+  801280:	83 c4 10             	add    $0x10,%esp
+}
+  801283:	90                   	nop
+  801284:	c9                   	leave
+  801285:	c3                   	ret
+
+00801286 <unlock_fork>:
+
+void
+unlock_fork(void) {
+  801286:	55                   	push   %ebp
+  801287:	89 e5                	mov    %esp,%ebp
+    unlock(&fork_lock);
+  801289:	68 b8 31 80 00       	push   $0x8031b8
+  80128e:	e8 b2 ff ff ff       	call   801245 <unlock>
+  801293:	83 c4 04             	add    $0x4,%esp
+}
+  801296:	90                   	nop
+  801297:	c9                   	leave
+  801298:	c3                   	ret
+
+00801299 <exit>:
+
+void
+exit(int error_code) {
+  801299:	55                   	push   %ebp
+  80129a:	89 e5                	mov    %esp,%ebp
+  80129c:	83 ec 08             	sub    $0x8,%esp
+    sys_exit(error_code);
+  80129f:	83 ec 0c             	sub    $0xc,%esp
+  8012a2:	ff 75 08             	push   0x8(%ebp)
+  8012a5:	e8 ac fc ff ff       	call   800f56 <sys_exit>
+  8012aa:	83 c4 10             	add    $0x10,%esp
+    cprintf("BUG: exit failed.\n");
+  8012ad:	83 ec 0c             	sub    $0xc,%esp
+  8012b0:	68 e9 22 80 00       	push   $0x8022e9
+  8012b5:	e8 4a fb ff ff       	call   800e04 <cprintf>
+  8012ba:	83 c4 10             	add    $0x10,%esp
+    while (1);
+  8012bd:	90                   	nop
+  8012be:	eb fd                	jmp    8012bd <exit+0x24>
+
+008012c0 <fork>:
+}
+
+int
+fork(void) {
+  8012c0:	55                   	push   %ebp
+  8012c1:	89 e5                	mov    %esp,%ebp
+  8012c3:	83 ec 08             	sub    $0x8,%esp
+    return sys_fork();
+  8012c6:	e8 9d fc ff ff       	call   800f68 <sys_fork>
+}
+  8012cb:	c9                   	leave
+  8012cc:	c3                   	ret
+
+008012cd <wait>:
+
+int
+wait(void) {
+  8012cd:	55                   	push   %ebp
+  8012ce:	89 e5                	mov    %esp,%ebp
+  8012d0:	83 ec 08             	sub    $0x8,%esp
+    return sys_wait(0, NULL);
+  8012d3:	83 ec 08             	sub    $0x8,%esp
+  8012d6:	6a 00                	push   $0x0
+  8012d8:	6a 00                	push   $0x0
+  8012da:	e8 98 fc ff ff       	call   800f77 <sys_wait>
+  8012df:	83 c4 10             	add    $0x10,%esp
+}
+  8012e2:	c9                   	leave
+  8012e3:	c3                   	ret
+
+008012e4 <waitpid>:
+
+int
+waitpid(int pid, int *store) {
+  8012e4:	55                   	push   %ebp
+  8012e5:	89 e5                	mov    %esp,%ebp
+  8012e7:	83 ec 08             	sub    $0x8,%esp
+    return sys_wait(pid, store);
+  8012ea:	83 ec 08             	sub    $0x8,%esp
+  8012ed:	ff 75 0c             	push   0xc(%ebp)
+  8012f0:	ff 75 08             	push   0x8(%ebp)
+  8012f3:	e8 7f fc ff ff       	call   800f77 <sys_wait>
+  8012f8:	83 c4 10             	add    $0x10,%esp
+}
+  8012fb:	c9                   	leave
+  8012fc:	c3                   	ret
+
+008012fd <yield>:
+
+void
+yield(void) {
+  8012fd:	55                   	push   %ebp
+  8012fe:	89 e5                	mov    %esp,%ebp
+  801300:	83 ec 08             	sub    $0x8,%esp
+    sys_yield();
+  801303:	e8 84 fc ff ff       	call   800f8c <sys_yield>
+}
+  801308:	90                   	nop
+  801309:	c9                   	leave
+  80130a:	c3                   	ret
+
+0080130b <kill>:
+
+int
+kill(int pid) {
+  80130b:	55                   	push   %ebp
+  80130c:	89 e5                	mov    %esp,%ebp
+  80130e:	83 ec 08             	sub    $0x8,%esp
+    return sys_kill(pid);
+  801311:	83 ec 0c             	sub    $0xc,%esp
+  801314:	ff 75 08             	push   0x8(%ebp)
+  801317:	e8 7f fc ff ff       	call   800f9b <sys_kill>
+  80131c:	83 c4 10             	add    $0x10,%esp
+}
+  80131f:	c9                   	leave
+  801320:	c3                   	ret
+
+00801321 <getpid>:
+
+int
+getpid(void) {
+  801321:	55                   	push   %ebp
+  801322:	89 e5                	mov    %esp,%ebp
+  801324:	83 ec 08             	sub    $0x8,%esp
+    return sys_getpid();
+  801327:	e8 81 fc ff ff       	call   800fad <sys_getpid>
+}
+  80132c:	c9                   	leave
+  80132d:	c3                   	ret
+
+0080132e <sbrk>:
+
+//sbrk - move the program break by increment bytes, the kernel keeps the break page aligned,
+//     - so the heap may shrink less than asked. return the old break, or (void *)-1 if failed
+void *
+sbrk(intptr_t increment) {
+  80132e:	55                   	push   %ebp
+  80132f:	89 e5                	mov    %esp,%ebp
+  801331:	83 ec 18             	sub    $0x18,%esp
+    uintptr_t brk = 0;
+  801334:	c7 45 ec 00 00 00 00 	movl   $0x0,-0x14(%ebp)
+    if (sys_brk(&brk) != 0) {
+  80133b:	83 ec 0c             	sub    $0xc,%esp
+  80133e:	8d 45 ec             	lea    -0x14(%ebp),%eax
+  801341:	50                   	push   %eax
+  801342:	e8 75 fc ff ff       	call   800fbc <sys_brk>
+  801347:	83 c4 10             	add    $0x10,%esp
+  80134a:	85 c0                	test   %eax,%eax
+  80134c:	74 07                	je     801355 <sbrk+0x27>
+        return (void *)-1;
+  80134e:	b8 ff ff ff ff       	mov    $0xffffffff,%eax
+  801353:	eb 4d                	jmp    8013a2 <sbrk+0x74>
+    }
+    if (increment != 0) {
+  801355:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  801359:	74 44                	je     80139f <sbrk+0x71>
+        uintptr_t oldbrk = brk, newbrk = brk + increment;
+  80135b:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  80135e:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801361:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  801364:	8b 45 08             	mov    0x8(%ebp),%eax
+  801367:	01 d0                	add    %edx,%eax
+  801369:	89 45 f0             	mov    %eax,-0x10(%ebp)
+        brk = newbrk;
+  80136c:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80136f:	89 45 ec             	mov    %eax,-0x14(%ebp)
+        if (sys_brk(&brk) != 0 || (increment > 0 && brk < newbrk)) {
+  801372:	83 ec 0c             	sub    $0xc,%esp
+  801375:	8d 45 ec             	lea    -0x14(%ebp),%eax
+  801378:	50                   	push   %eax
+  801379:	e8 3e fc ff ff       	call   800fbc <sys_brk>
+  80137e:	83 c4 10             	add    $0x10,%esp
+  801381:	85 c0                	test   %eax,%eax
+  801383:	75 0e                	jne    801393 <sbrk+0x65>
+  801385:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  801389:	7e 0f                	jle    80139a <sbrk+0x6c>
+  80138b:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  80138e:	3b 45 f0             	cmp    -0x10(%ebp),%eax
+  801391:	73 07                	jae    80139a <sbrk+0x6c>
+            return (void *)-1;
+  801393:	b8 ff ff ff ff       	mov    $0xffffffff,%eax
+  801398:	eb 08                	jmp    8013a2 <sbrk+0x74>
+        }
+        return (void *)oldbrk;
+  80139a:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80139d:	eb 03                	jmp    8013a2 <sbrk+0x74>
+    }
+    return (void *)brk;
+  80139f:	8b 45 ec             	mov    -0x14(%ebp),%eax
+}
+  8013a2:	c9                   	leave
+  8013a3:	c3                   	ret
+
+008013a4 <mmap>:
+
+//mmap - map len bytes of anonymous memory (filled with zero), at addr if it isn't NULL,
+//     - return the start addr of the mapping, or NULL if failed
+void *
+mmap(void *addr, size_t len, uint32_t mmap_flags) {
+  8013a4:	55                   	push   %ebp
+  8013a5:	89 e5                	mov    %esp,%ebp
+  8013a7:	83 ec 18             	sub    $0x18,%esp
+    uintptr_t addr_store = (uintptr_t)addr;
+  8013aa:	8b 45 08             	mov    0x8(%ebp),%eax
+  8013ad:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (sys_mmap(&addr_store, len, mmap_flags) != 0) {
+  8013b0:	83 ec 04             	sub    $0x4,%esp
+  8013b3:	ff 75 10             	push   0x10(%ebp)
+  8013b6:	ff 75 0c             	push   0xc(%ebp)
+  8013b9:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  8013bc:	50                   	push   %eax
+  8013bd:	e8 0c fc ff ff       	call   800fce <sys_mmap>
+  8013c2:	83 c4 10             	add    $0x10,%esp
+  8013c5:	85 c0                	test   %eax,%eax
+  8013c7:	74 07                	je     8013d0 <mmap+0x2c>
+        return NULL;
+  8013c9:	b8 00 00 00 00       	mov    $0x0,%eax
+  8013ce:	eb 03                	jmp    8013d3 <mmap+0x2f>
+    }
+    return (void *)addr_store;
+  8013d0:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  8013d3:	c9                   	leave
+  8013d4:	c3                   	ret
+
+008013d5 <munmap>:
+
+int
+munmap(void *addr, size_t len) {
+  8013d5:	55                   	push   %ebp
+  8013d6:	89 e5                	mov    %esp,%ebp
+  8013d8:	83 ec 08             	sub    $0x8,%esp
+    return sys_munmap((uintptr_t)addr, len);
+  8013db:	8b 45 08             	mov    0x8(%ebp),%eax
+  8013de:	83 ec 08             	sub    $0x8,%esp
+  8013e1:	ff 75 0c             	push   0xc(%ebp)
+  8013e4:	50                   	push   %eax
+  8013e5:	e8 fc fb ff ff       	call   800fe6 <sys_munmap>
+  8013ea:	83 c4 10             	add    $0x10,%esp
+}
+  8013ed:	c9                   	leave
+  8013ee:	c3                   	ret
+
+008013ef <print_pgdir>:
+
+//print_pgdir - print the PDT&PT
+void
+print_pgdir(void) {
+  8013ef:	55                   	push   %ebp
+  8013f0:	89 e5                	mov    %esp,%ebp
+  8013f2:	83 ec 08             	sub    $0x8,%esp
+    sys_pgdir();
+  8013f5:	e8 13 fc ff ff       	call   80100d <sys_pgdir>
+}
+  8013fa:	90                   	nop
+  8013fb:	c9                   	leave
+  8013fc:	c3                   	ret
+
+008013fd <lab6_set_priority>:
+
+void
+lab6_set_priority(uint32_t priority)
+{
+  8013fd:	55                   	push   %ebp
+  8013fe:	89 e5                	mov    %esp,%ebp
+  801400:	83 ec 08             	sub    $0x8,%esp
+    sys_lab6_set_priority(priority);
+  801403:	83 ec 0c             	sub    $0xc,%esp
+  801406:	ff 75 08             	push   0x8(%ebp)
+  801409:	e8 0e fc ff ff       	call   80101c <sys_lab6_set_priority>
+  80140e:	83 c4 10             	add    $0x10,%esp
+}
+  801411:	90                   	nop
+  801412:	c9                   	leave
+  801413:	c3                   	ret
+
+00801414 <sleep>:
+
+int
+sleep(unsigned int time) {
+  801414:	55                   	push   %ebp
+  801415:	89 e5                	mov    %esp,%ebp
+  801417:	83 ec 08             	sub    $0x8,%esp
+    return sys_sleep(time);
+  80141a:	83 ec 0c             	sub    $0xc,%esp
+  80141d:	ff 75 08             	push   0x8(%ebp)
+  801420:	e8 0d fc ff ff       	call   801032 <sys_sleep>
+  801425:	83 c4 10             	add    $0x10,%esp
+}
+  801428:	c9                   	leave
+  801429:	c3                   	ret
+
+0080142a <gettime_msec>:
+
+unsigned int
+gettime_msec(void) {
+  80142a:	55                   	push   %ebp
+  80142b:	89 e5                	mov    %esp,%ebp
+  80142d:	83 ec 08             	sub    $0x8,%esp
+    return (unsigned int)sys_gettime();
+  801430:	e8 0f fc ff ff       	call   801044 <sys_gettime>
+}
+  801435:	c9                   	leave
+  801436:	c3                   	ret
+
+00801437 <__exec>:
+
+int
+__exec(const char *name, const char **argv) {
+  801437:	55                   	push   %ebp
+  801438:	89 e5                	mov    %esp,%ebp
+  80143a:	83 ec 18             	sub    $0x18,%esp
+    int argc = 0;
+  80143d:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    while (argv[argc] != NULL) {
+  801444:	eb 04                	jmp    80144a <__exec+0x13>
+        argc ++;
+  801446:	83 45 f4 01          	addl   $0x1,-0xc(%ebp)
+    while (argv[argc] != NULL) {
+  80144a:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80144d:	8d 14 85 00 00 00 00 	lea    0x0(,%eax,4),%edx
+  801454:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801457:	01 d0                	add    %edx,%eax
+  801459:	8b 00                	mov    (%eax),%eax
+  80145b:	85 c0                	test   %eax,%eax
+  80145d:	75 e7                	jne    801446 <__exec+0xf>
+    }
+    return sys_exec(name, argc, argv);
+  80145f:	83 ec 04             	sub    $0x4,%esp
+  801462:	ff 75 0c             	push   0xc(%ebp)
+  801465:	ff 75 f4             	push   -0xc(%ebp)
+  801468:	ff 75 08             	push   0x8(%ebp)
+  80146b:	e8 e3 fb ff ff       	call   801053 <sys_exec>
+  801470:	83 c4 10             	add    $0x10,%esp
+}
+  801473:	c9                   	leave
+  801474:	c3                   	ret
+
+00801475 <initfd>:
+#include <stat.h>
+
+int main(int argc, char *argv[]);
+
+static int
+initfd(int fd2, const char *path, uint32_t open_flags) {
+  801475:	55                   	push   %ebp
+  801476:	89 e5                	mov    %esp,%ebp
+  801478:	83 ec 18             	sub    $0x18,%esp
+    int fd1, ret;
+    if ((fd1 = open(path, open_flags)) < 0) {
+  80147b:	83 ec 08             	sub    $0x8,%esp
+  80147e:	ff 75 10             	push   0x10(%ebp)
+  801481:	ff 75 0c             	push   0xc(%ebp)
+  801484:	e8 72 ec ff ff       	call   8000fb <open>
+  801489:	83 c4 10             	add    $0x10,%esp
+  80148c:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  80148f:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  801493:	79 05                	jns    80149a <initfd+0x25>
+        return fd1;
+  801495:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801498:	eb 3b                	jmp    8014d5 <initfd+0x60>
+    }
+    if (fd1 != fd2) {
+  80149a:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80149d:	3b 45 08             	cmp    0x8(%ebp),%eax
+  8014a0:	74 30                	je     8014d2 <initfd+0x5d>
+        close(fd2);
+  8014a2:	83 ec 0c             	sub    $0xc,%esp
+  8014a5:	ff 75 08             	push   0x8(%ebp)
+  8014a8:	e8 67 ec ff ff       	call   800114 <close>
+  8014ad:	83 c4 10             	add    $0x10,%esp
+        ret = dup2(fd1, fd2);
+  8014b0:	83 ec 08             	sub    $0x8,%esp
+  8014b3:	ff 75 08             	push   0x8(%ebp)
+  8014b6:	ff 75 f0             	push   -0x10(%ebp)
+  8014b9:	e8 7b ed ff ff       	call   800239 <dup2>
+  8014be:	83 c4 10             	add    $0x10,%esp
+  8014c1:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        close(fd1);
+  8014c4:	83 ec 0c             	sub    $0xc,%esp
+  8014c7:	ff 75 f0             	push   -0x10(%ebp)
+  8014ca:	e8 45 ec ff ff       	call   800114 <close>
+  8014cf:	83 c4 10             	add    $0x10,%esp
+    }
+    return ret;
+  8014d2:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  8014d5:	c9                   	leave
+  8014d6:	c3                   	ret
+
+008014d7 <umain>:
+
+void
+umain(int argc, char *argv[]) {
+  8014d7:	55                   	push   %ebp
+  8014d8:	89 e5                	mov    %esp,%ebp
+  8014da:	83 ec 18             	sub    $0x18,%esp
+    int fd;
+    if ((fd = initfd(0, "stdin:", O_RDONLY)) < 0) {
+  8014dd:	83 ec 04             	sub    $0x4,%esp
+  8014e0:	6a 00                	push   $0x0
+  8014e2:	68 fc 22 80 00       	push   $0x8022fc
+  8014e7:	6a 00                	push   $0x0
+  8014e9:	e8 87 ff ff ff       	call   801475 <initfd>
+  8014ee:	83 c4 10             	add    $0x10,%esp
+  8014f1:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8014f4:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  8014f8:	79 17                	jns    801511 <umain+0x3a>
+        warn("open <stdin> failed: %e.\n", fd);
+  8014fa:	ff 75 f4             	push   -0xc(%ebp)
+  8014fd:	68 03 23 80 00       	push   $0x802303
+  801502:	6a 1a                	push   $0x1a
+  801504:	68 1d 23 80 00       	push   $0x80231d
+  801509:	e8 5a f8 ff ff       	call   800d68 <__warn>
+  80150e:	83 c4 10             	add    $0x10,%esp
+    }
+    if ((fd = initfd(1, "stdout:", O_WRONLY)) < 0) {
+  801511:	83 ec 04             	sub    $0x4,%esp
+  801514:	6a 01                	push   $0x1
+  801516:	68 2f 23 80 00       	push   $0x80232f
+  80151b:	6a 01                	push   $0x1
+  80151d:	e8 53 ff ff ff       	call   801475 <initfd>
+  801522:	83 c4 10             	add    $0x10,%esp
+  801525:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801528:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  80152c:	79 17                	jns    801545 <umain+0x6e>
+        warn("open <stdout> failed: %e.\n", fd);
+  80152e:	ff 75 f4             	push   -0xc(%ebp)
+  801531:	68 37 23 80 00       	push   $0x802337
+  801536:	6a 1d                	push   $0x1d
+  801538:	68 1d 23 80 00       	push   $0x80231d
+  80153d:	e8 26 f8 ff ff       	call   800d68 <__warn>
+  801542:	83 c4 10             	add    $0x10,%esp
+    }
+    int ret = main(argc, argv);
+  801545:	83 ec 08             	sub    $0x8,%esp
+  801548:	ff 75 0c             	push   0xc(%ebp)
+  80154b:	ff 75 08             	push   0x8(%ebp)
+  80154e:	e8 36 0c 00 00       	call   802189 <main>
+  801553:	83 c4 10             	add    $0x10,%esp
+  801556:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    exit(ret);
+  801559:	83 ec 0c             	sub    $0xc,%esp
+  80155c:	ff 75 f0             	push   -0x10(%ebp)
+  80155f:	e8 35 fd ff ff       	call   801299 <exit>
+
+00801564 <hash32>:
+ * @bits:   the number of bits in a return value
+ *
+ * High bits are more random, so we use them.
+ * */
+uint32_t
+hash32(uint32_t val, unsigned int bits) {
+  801564:	55                   	push   %ebp
+  801565:	89 e5                	mov    %esp,%ebp
+  801567:	83 ec 10             	sub    $0x10,%esp
+    uint32_t hash = val * GOLDEN_RATIO_PRIME_32;
+  80156a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80156d:	69 c0 01 00 37 9e    	imul   $0x9e370001,%eax,%eax
+  801573:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return (hash >> (32 - bits));
+  801576:	b8 20 00 00 00       	mov    $0x20,%eax
+  80157b:	2b 45 0c             	sub    0xc(%ebp),%eax
+  80157e:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  801581:	89 c1                	mov    %eax,%ecx
+  801583:	d3 ea                	shr    %cl,%edx
+  801585:	89 d0                	mov    %edx,%eax
+}
+  801587:	c9                   	leave
+  801588:	c3                   	ret
+
+00801589 <printnum>:
+ * @width:      maximum number of digits, if the actual width is less than @width, use @padc instead
+ * @padc:       character that padded on the left if the actual width is less than @width
+ * */
+static void
+printnum(void (*putch)(int, void*, int), int fd, void *putdat,
+        unsigned long long num, unsigned base, int width, int padc) {
+  801589:	55                   	push   %ebp
+  80158a:	89 e5                	mov    %esp,%ebp
+  80158c:	83 ec 38             	sub    $0x38,%esp
+  80158f:	8b 45 14             	mov    0x14(%ebp),%eax
+  801592:	89 45 d0             	mov    %eax,-0x30(%ebp)
+  801595:	8b 45 18             	mov    0x18(%ebp),%eax
+  801598:	89 45 d4             	mov    %eax,-0x2c(%ebp)
+    unsigned long long result = num;
+  80159b:	8b 45 d0             	mov    -0x30(%ebp),%eax
+  80159e:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+  8015a1:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  8015a4:	89 55 ec             	mov    %edx,-0x14(%ebp)
+    unsigned mod = do_div(result, base);
+  8015a7:	8b 45 1c             	mov    0x1c(%ebp),%eax
+  8015aa:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  8015ad:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8015b0:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  8015b3:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  8015b6:	89 55 f0             	mov    %edx,-0x10(%ebp)
+  8015b9:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8015bc:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8015bf:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  8015c3:	74 1c                	je     8015e1 <printnum+0x58>
+  8015c5:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8015c8:	ba 00 00 00 00       	mov    $0x0,%edx
+  8015cd:	f7 75 e4             	divl   -0x1c(%ebp)
+  8015d0:	89 55 f4             	mov    %edx,-0xc(%ebp)
+  8015d3:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8015d6:	ba 00 00 00 00       	mov    $0x0,%edx
+  8015db:	f7 75 e4             	divl   -0x1c(%ebp)
+  8015de:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8015e1:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  8015e4:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  8015e7:	f7 75 e4             	divl   -0x1c(%ebp)
+  8015ea:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  8015ed:	89 55 dc             	mov    %edx,-0x24(%ebp)
+  8015f0:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  8015f3:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  8015f6:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  8015f9:	89 55 ec             	mov    %edx,-0x14(%ebp)
+  8015fc:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  8015ff:	89 45 d8             	mov    %eax,-0x28(%ebp)
+
+    // first recursively print all preceding (more significant) digits
+    if (num >= base) {
+  801602:	8b 45 1c             	mov    0x1c(%ebp),%eax
+  801605:	ba 00 00 00 00       	mov    $0x0,%edx
+  80160a:	8b 4d d4             	mov    -0x2c(%ebp),%ecx
+  80160d:	39 45 d0             	cmp    %eax,-0x30(%ebp)
+  801610:	19 d1                	sbb    %edx,%ecx
+  801612:	72 3a                	jb     80164e <printnum+0xc5>
+        printnum(putch, fd, putdat, result, base, width - 1, padc);
+  801614:	8b 45 20             	mov    0x20(%ebp),%eax
+  801617:	83 e8 01             	sub    $0x1,%eax
+  80161a:	ff 75 24             	push   0x24(%ebp)
+  80161d:	50                   	push   %eax
+  80161e:	ff 75 1c             	push   0x1c(%ebp)
+  801621:	ff 75 ec             	push   -0x14(%ebp)
+  801624:	ff 75 e8             	push   -0x18(%ebp)
+  801627:	ff 75 10             	push   0x10(%ebp)
+  80162a:	ff 75 0c             	push   0xc(%ebp)
+  80162d:	ff 75 08             	push   0x8(%ebp)
+  801630:	e8 54 ff ff ff       	call   801589 <printnum>
+  801635:	83 c4 20             	add    $0x20,%esp
+  801638:	eb 1e                	jmp    801658 <printnum+0xcf>
+    } else {
+        // print any needed pad characters before first digit
+        while (-- width > 0)
+            putch(padc, putdat, fd);
+  80163a:	83 ec 04             	sub    $0x4,%esp
+  80163d:	ff 75 0c             	push   0xc(%ebp)
+  801640:	ff 75 10             	push   0x10(%ebp)
+  801643:	ff 75 24             	push   0x24(%ebp)
+  801646:	8b 45 08             	mov    0x8(%ebp),%eax
+  801649:	ff d0                	call   *%eax
+  80164b:	83 c4 10             	add    $0x10,%esp
+        while (-- width > 0)
+  80164e:	83 6d 20 01          	subl   $0x1,0x20(%ebp)
+  801652:	83 7d 20 00          	cmpl   $0x0,0x20(%ebp)
+  801656:	7f e2                	jg     80163a <printnum+0xb1>
+    }
+    // then print this (the least significant) digit
+    putch("0123456789abcdef"[mod], putdat, fd);
+  801658:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  80165b:	05 64 25 80 00       	add    $0x802564,%eax
+  801660:	0f b6 00             	movzbl (%eax),%eax
+  801663:	0f be c0             	movsbl %al,%eax
+  801666:	83 ec 04             	sub    $0x4,%esp
+  801669:	ff 75 0c             	push   0xc(%ebp)
+  80166c:	ff 75 10             	push   0x10(%ebp)
+  80166f:	50                   	push   %eax
+  801670:	8b 45 08             	mov    0x8(%ebp),%eax
+  801673:	ff d0                	call   *%eax
+  801675:	83 c4 10             	add    $0x10,%esp
+}
+  801678:	90                   	nop
+  801679:	c9                   	leave
+  80167a:	c3                   	ret
+
+0080167b <getuint>:
+ * getuint - get an unsigned int of various possible sizes from a varargs list
+ * @ap:         a varargs list pointer
+ * @lflag:      determines the size of the vararg that @ap points to
+ * */
+static unsigned long long
+getuint(va_list *ap, int lflag) {
+  80167b:	55                   	push   %ebp
+  80167c:	89 e5                	mov    %esp,%ebp
+    if (lflag >= 2) {
+  80167e:	83 7d 0c 01          	cmpl   $0x1,0xc(%ebp)
+  801682:	7e 14                	jle    801698 <getuint+0x1d>
+        return va_arg(*ap, unsigned long long);
+  801684:	8b 45 08             	mov    0x8(%ebp),%eax
+  801687:	8b 00                	mov    (%eax),%eax
+  801689:	8d 48 08             	lea    0x8(%eax),%ecx
+  80168c:	8b 55 08             	mov    0x8(%ebp),%edx
+  80168f:	89 0a                	mov    %ecx,(%edx)
+  801691:	8b 50 04             	mov    0x4(%eax),%edx
+  801694:	8b 00                	mov    (%eax),%eax
+  801696:	eb 30                	jmp    8016c8 <getuint+0x4d>
+    }
+    else if (lflag) {
+  801698:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  80169c:	74 16                	je     8016b4 <getuint+0x39>
+        return va_arg(*ap, unsigned long);
+  80169e:	8b 45 08             	mov    0x8(%ebp),%eax
+  8016a1:	8b 00                	mov    (%eax),%eax
+  8016a3:	8d 48 04             	lea    0x4(%eax),%ecx
+  8016a6:	8b 55 08             	mov    0x8(%ebp),%edx
+  8016a9:	89 0a                	mov    %ecx,(%edx)
+  8016ab:	8b 00                	mov    (%eax),%eax
+  8016ad:	ba 00 00 00 00       	mov    $0x0,%edx
+  8016b2:	eb 14                	jmp    8016c8 <getuint+0x4d>
+    }
+    else {
+        return va_arg(*ap, unsigned int);
+  8016b4:	8b 45 08             	mov    0x8(%ebp),%eax
+  8016b7:	8b 00                	mov    (%eax),%eax
+  8016b9:	8d 48 04             	lea    0x4(%eax),%ecx
+  8016bc:	8b 55 08             	mov    0x8(%ebp),%edx
+  8016bf:	89 0a                	mov    %ecx,(%edx)
+  8016c1:	8b 00                	mov    (%eax),%eax
+  8016c3:	ba 00 00 00 00       	mov    $0x0,%edx
+    }
+}
+  8016c8:	5d                   	pop    %ebp
+  8016c9:	c3                   	ret
+
+008016ca <getint>:
+ * getint - same as getuint but signed, we can't use getuint because of sign extension
+ * @ap:         a varargs list pointer
+ * @lflag:      determines the size of the vararg that @ap points to
+ * */
+static long long
+getint(va_list *ap, int lflag) {
+  8016ca:	55                   	push   %ebp
+  8016cb:	89 e5                	mov    %esp,%ebp
+    if (lflag >= 2) {
+  8016cd:	83 7d 0c 01          	cmpl   $0x1,0xc(%ebp)
+  8016d1:	7e 14                	jle    8016e7 <getint+0x1d>
+        return va_arg(*ap, long long);
+  8016d3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8016d6:	8b 00                	mov    (%eax),%eax
+  8016d8:	8d 48 08             	lea    0x8(%eax),%ecx
+  8016db:	8b 55 08             	mov    0x8(%ebp),%edx
+  8016de:	89 0a                	mov    %ecx,(%edx)
+  8016e0:	8b 50 04             	mov    0x4(%eax),%edx
+  8016e3:	8b 00                	mov    (%eax),%eax
+  8016e5:	eb 28                	jmp    80170f <getint+0x45>
+    }
+    else if (lflag) {
+  8016e7:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  8016eb:	74 12                	je     8016ff <getint+0x35>
+        return va_arg(*ap, long);
+  8016ed:	8b 45 08             	mov    0x8(%ebp),%eax
+  8016f0:	8b 00                	mov    (%eax),%eax
+  8016f2:	8d 48 04             	lea    0x4(%eax),%ecx
+  8016f5:	8b 55 08             	mov    0x8(%ebp),%edx
+  8016f8:	89 0a                	mov    %ecx,(%edx)
+  8016fa:	8b 00                	mov    (%eax),%eax
+  8016fc:	99                   	cltd
+  8016fd:	eb 10                	jmp    80170f <getint+0x45>
+    }
+    else {
+        return va_arg(*ap, int);
+  8016ff:	8b 45 08             	mov    0x8(%ebp),%eax
+  801702:	8b 00                	mov    (%eax),%eax
+  801704:	8d 48 04             	lea    0x4(%eax),%ecx
+  801707:	8b 55 08             	mov    0x8(%ebp),%edx
+  80170a:	89 0a                	mov    %ecx,(%edx)
+  80170c:	8b 00                	mov    (%eax),%eax
+  80170e:	99                   	cltd
+    }
+}
+  80170f:	5d                   	pop    %ebp
+  801710:	c3                   	ret
+
+00801711 <printfmt>:
+ * @fd:         file descriptor
+ * @putdat:     used by @putch function
+ * @fmt:        the format string to use
+ * */
+void
+printfmt(void (*putch)(int, void*, int), int fd, void *putdat, const char *fmt, ...) {
+  801711:	55                   	push   %ebp
+  801712:	89 e5                	mov    %esp,%ebp
+  801714:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  801717:	8d 45 18             	lea    0x18(%ebp),%eax
+  80171a:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    vprintfmt(putch, fd, putdat, fmt, ap);
+  80171d:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801720:	83 ec 0c             	sub    $0xc,%esp
+  801723:	50                   	push   %eax
+  801724:	ff 75 14             	push   0x14(%ebp)
+  801727:	ff 75 10             	push   0x10(%ebp)
+  80172a:	ff 75 0c             	push   0xc(%ebp)
+  80172d:	ff 75 08             	push   0x8(%ebp)
+  801730:	e8 06 00 00 00       	call   80173b <vprintfmt>
+  801735:	83 c4 20             	add    $0x20,%esp
+    va_end(ap);
+}
+  801738:	90                   	nop
+  801739:	c9                   	leave
+  80173a:	c3                   	ret
+
+0080173b <vprintfmt>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want printfmt() instead.
+ * */
+void
+vprintfmt(void (*putch)(int, void*, int), int fd, void *putdat, const char *fmt, va_list ap) {
+  80173b:	55                   	push   %ebp
+  80173c:	89 e5                	mov    %esp,%ebp
+  80173e:	56                   	push   %esi
+  80173f:	53                   	push   %ebx
+  801740:	83 ec 20             	sub    $0x20,%esp
+    register int ch, err;
+    unsigned long long num;
+    int base, width, precision, lflag, altflag;
+
+    while (1) {
+        while ((ch = *(unsigned char *)fmt ++) != '%') {
+  801743:	eb 1a                	jmp    80175f <vprintfmt+0x24>
+            if (ch == '\0') {
+  801745:	85 db                	test   %ebx,%ebx
+  801747:	0f 84 c2 03 00 00    	je     801b0f <vprintfmt+0x3d4>
+                return;
+            }
+            putch(ch, putdat, fd);
+  80174d:	83 ec 04             	sub    $0x4,%esp
+  801750:	ff 75 0c             	push   0xc(%ebp)
+  801753:	ff 75 10             	push   0x10(%ebp)
+  801756:	53                   	push   %ebx
+  801757:	8b 45 08             	mov    0x8(%ebp),%eax
+  80175a:	ff d0                	call   *%eax
+  80175c:	83 c4 10             	add    $0x10,%esp
+        while ((ch = *(unsigned char *)fmt ++) != '%') {
+  80175f:	8b 45 14             	mov    0x14(%ebp),%eax
+  801762:	8d 50 01             	lea    0x1(%eax),%edx
+  801765:	89 55 14             	mov    %edx,0x14(%ebp)
+  801768:	0f b6 00             	movzbl (%eax),%eax
+  80176b:	0f b6 d8             	movzbl %al,%ebx
+  80176e:	83 fb 25             	cmp    $0x25,%ebx
+  801771:	75 d2                	jne    801745 <vprintfmt+0xa>
+        }
+
+        // Process a %-escape sequence
+        char padc = ' ';
+  801773:	c6 45 db 20          	movb   $0x20,-0x25(%ebp)
+        width = precision = -1;
+  801777:	c7 45 e4 ff ff ff ff 	movl   $0xffffffff,-0x1c(%ebp)
+  80177e:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  801781:	89 45 e8             	mov    %eax,-0x18(%ebp)
+        lflag = altflag = 0;
+  801784:	c7 45 dc 00 00 00 00 	movl   $0x0,-0x24(%ebp)
+  80178b:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  80178e:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801791:	eb 04                	jmp    801797 <vprintfmt+0x5c>
+            goto process_precision;
+
+        case '.':
+            if (width < 0)
+                width = 0;
+            goto reswitch;
+  801793:	90                   	nop
+  801794:	eb 01                	jmp    801797 <vprintfmt+0x5c>
+            goto reswitch;
+
+        process_precision:
+            if (width < 0)
+                width = precision, precision = -1;
+            goto reswitch;
+  801796:	90                   	nop
+        switch (ch = *(unsigned char *)fmt ++) {
+  801797:	8b 45 14             	mov    0x14(%ebp),%eax
+  80179a:	8d 50 01             	lea    0x1(%eax),%edx
+  80179d:	89 55 14             	mov    %edx,0x14(%ebp)
+  8017a0:	0f b6 00             	movzbl (%eax),%eax
+  8017a3:	0f b6 d8             	movzbl %al,%ebx
+  8017a6:	8d 43 dd             	lea    -0x23(%ebx),%eax
+  8017a9:	83 f8 55             	cmp    $0x55,%eax
+  8017ac:	0f 87 2d 03 00 00    	ja     801adf <vprintfmt+0x3a4>
+  8017b2:	8b 04 85 88 25 80 00 	mov    0x802588(,%eax,4),%eax
+  8017b9:	ff e0                	jmp    *%eax
+            padc = '-';
+  8017bb:	c6 45 db 2d          	movb   $0x2d,-0x25(%ebp)
+            goto reswitch;
+  8017bf:	eb d6                	jmp    801797 <vprintfmt+0x5c>
+            padc = '0';
+  8017c1:	c6 45 db 30          	movb   $0x30,-0x25(%ebp)
+            goto reswitch;
+  8017c5:	eb d0                	jmp    801797 <vprintfmt+0x5c>
+            for (precision = 0; ; ++ fmt) {
+  8017c7:	c7 45 e4 00 00 00 00 	movl   $0x0,-0x1c(%ebp)
+                precision = precision * 10 + ch - '0';
+  8017ce:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  8017d1:	89 d0                	mov    %edx,%eax
+  8017d3:	c1 e0 02             	shl    $0x2,%eax
+  8017d6:	01 d0                	add    %edx,%eax
+  8017d8:	01 c0                	add    %eax,%eax
+  8017da:	01 d8                	add    %ebx,%eax
+  8017dc:	83 e8 30             	sub    $0x30,%eax
+  8017df:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+                ch = *fmt;
+  8017e2:	8b 45 14             	mov    0x14(%ebp),%eax
+  8017e5:	0f b6 00             	movzbl (%eax),%eax
+  8017e8:	0f be d8             	movsbl %al,%ebx
+                if (ch < '0' || ch > '9') {
+  8017eb:	83 fb 2f             	cmp    $0x2f,%ebx
+  8017ee:	7e 39                	jle    801829 <vprintfmt+0xee>
+  8017f0:	83 fb 39             	cmp    $0x39,%ebx
+  8017f3:	7f 34                	jg     801829 <vprintfmt+0xee>
+            for (precision = 0; ; ++ fmt) {
+  8017f5:	83 45 14 01          	addl   $0x1,0x14(%ebp)
+                precision = precision * 10 + ch - '0';
+  8017f9:	eb d3                	jmp    8017ce <vprintfmt+0x93>
+            precision = va_arg(ap, int);
+  8017fb:	8b 45 18             	mov    0x18(%ebp),%eax
+  8017fe:	8d 50 04             	lea    0x4(%eax),%edx
+  801801:	89 55 18             	mov    %edx,0x18(%ebp)
+  801804:	8b 00                	mov    (%eax),%eax
+  801806:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+            goto process_precision;
+  801809:	eb 1f                	jmp    80182a <vprintfmt+0xef>
+            if (width < 0)
+  80180b:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  80180f:	79 82                	jns    801793 <vprintfmt+0x58>
+                width = 0;
+  801811:	c7 45 e8 00 00 00 00 	movl   $0x0,-0x18(%ebp)
+            goto reswitch;
+  801818:	e9 76 ff ff ff       	jmp    801793 <vprintfmt+0x58>
+            altflag = 1;
+  80181d:	c7 45 dc 01 00 00 00 	movl   $0x1,-0x24(%ebp)
+            goto reswitch;
+  801824:	e9 6e ff ff ff       	jmp    801797 <vprintfmt+0x5c>
+            goto process_precision;
+  801829:	90                   	nop
+            if (width < 0)
+  80182a:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  80182e:	0f 89 62 ff ff ff    	jns    801796 <vprintfmt+0x5b>
+                width = precision, precision = -1;
+  801834:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  801837:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  80183a:	c7 45 e4 ff ff ff ff 	movl   $0xffffffff,-0x1c(%ebp)
+            goto reswitch;
+  801841:	e9 50 ff ff ff       	jmp    801796 <vprintfmt+0x5b>
+
+        // long flag (doubled for long long)
+        case 'l':
+            lflag ++;
+  801846:	83 45 e0 01          	addl   $0x1,-0x20(%ebp)
+            goto reswitch;
+  80184a:	e9 48 ff ff ff       	jmp    801797 <vprintfmt+0x5c>
+
+        // character
+        case 'c':
+            putch(va_arg(ap, int), putdat, fd);
+  80184f:	8b 45 18             	mov    0x18(%ebp),%eax
+  801852:	8d 50 04             	lea    0x4(%eax),%edx
+  801855:	89 55 18             	mov    %edx,0x18(%ebp)
+  801858:	8b 00                	mov    (%eax),%eax
+  80185a:	83 ec 04             	sub    $0x4,%esp
+  80185d:	ff 75 0c             	push   0xc(%ebp)
+  801860:	ff 75 10             	push   0x10(%ebp)
+  801863:	50                   	push   %eax
+  801864:	8b 45 08             	mov    0x8(%ebp),%eax
+  801867:	ff d0                	call   *%eax
+  801869:	83 c4 10             	add    $0x10,%esp
+            break;
+  80186c:	e9 99 02 00 00       	jmp    801b0a <vprintfmt+0x3cf>
+
+        // error message
+        case 'e':
+            err = va_arg(ap, int);
+  801871:	8b 45 18             	mov    0x18(%ebp),%eax
+  801874:	8d 50 04             	lea    0x4(%eax),%edx
+  801877:	89 55 18             	mov    %edx,0x18(%ebp)
+  80187a:	8b 18                	mov    (%eax),%ebx
+            if (err < 0) {
+  80187c:	85 db                	test   %ebx,%ebx
+  80187e:	79 02                	jns    801882 <vprintfmt+0x147>
+                err = -err;
+  801880:	f7 db                	neg    %ebx
+            }
+            if (err > MAXERROR || (p = error_string[err]) == NULL) {
+  801882:	83 fb 18             	cmp    $0x18,%ebx
+  801885:	7f 0b                	jg     801892 <vprintfmt+0x157>
+  801887:	8b 34 9d 00 25 80 00 	mov    0x802500(,%ebx,4),%esi
+  80188e:	85 f6                	test   %esi,%esi
+  801890:	75 1f                	jne    8018b1 <vprintfmt+0x176>
+                printfmt(putch, fd, putdat, "error %d", err);
+  801892:	83 ec 0c             	sub    $0xc,%esp
+  801895:	53                   	push   %ebx
+  801896:	68 75 25 80 00       	push   $0x802575
+  80189b:	ff 75 10             	push   0x10(%ebp)
+  80189e:	ff 75 0c             	push   0xc(%ebp)
+  8018a1:	ff 75 08             	push   0x8(%ebp)
+  8018a4:	e8 68 fe ff ff       	call   801711 <printfmt>
+  8018a9:	83 c4 20             	add    $0x20,%esp
+            }
+            else {
+                printfmt(putch, fd, putdat, "%s", p);
+            }
+            break;
+  8018ac:	e9 59 02 00 00       	jmp    801b0a <vprintfmt+0x3cf>
+                printfmt(putch, fd, putdat, "%s", p);
+  8018b1:	83 ec 0c             	sub    $0xc,%esp
+  8018b4:	56                   	push   %esi
+  8018b5:	68 7e 25 80 00       	push   $0x80257e
+  8018ba:	ff 75 10             	push   0x10(%ebp)
+  8018bd:	ff 75 0c             	push   0xc(%ebp)
+  8018c0:	ff 75 08             	push   0x8(%ebp)
+  8018c3:	e8 49 fe ff ff       	call   801711 <printfmt>
+  8018c8:	83 c4 20             	add    $0x20,%esp
+            break;
+  8018cb:	e9 3a 02 00 00       	jmp    801b0a <vprintfmt+0x3cf>
+
+        // string
+        case 's':
+            if ((p = va_arg(ap, char *)) == NULL) {
+  8018d0:	8b 45 18             	mov    0x18(%ebp),%eax
+  8018d3:	8d 50 04             	lea    0x4(%eax),%edx
+  8018d6:	89 55 18             	mov    %edx,0x18(%ebp)
+  8018d9:	8b 30                	mov    (%eax),%esi
+  8018db:	85 f6                	test   %esi,%esi
+  8018dd:	75 05                	jne    8018e4 <vprintfmt+0x1a9>
+                p = "(null)";
+  8018df:	be 81 25 80 00       	mov    $0x802581,%esi
+            }
+            if (width > 0 && padc != '-') {
+  8018e4:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  8018e8:	7e 7d                	jle    801967 <vprintfmt+0x22c>
+  8018ea:	80 7d db 2d          	cmpb   $0x2d,-0x25(%ebp)
+  8018ee:	74 77                	je     801967 <vprintfmt+0x22c>
+                for (width -= strnlen(p, precision); width > 0; width --) {
+  8018f0:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8018f3:	83 ec 08             	sub    $0x8,%esp
+  8018f6:	50                   	push   %eax
+  8018f7:	56                   	push   %esi
+  8018f8:	e8 d6 03 00 00       	call   801cd3 <strnlen>
+  8018fd:	83 c4 10             	add    $0x10,%esp
+  801900:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  801903:	29 c2                	sub    %eax,%edx
+  801905:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  801908:	eb 1a                	jmp    801924 <vprintfmt+0x1e9>
+                    putch(padc, putdat, fd);
+  80190a:	0f be 45 db          	movsbl -0x25(%ebp),%eax
+  80190e:	83 ec 04             	sub    $0x4,%esp
+  801911:	ff 75 0c             	push   0xc(%ebp)
+  801914:	ff 75 10             	push   0x10(%ebp)
+  801917:	50                   	push   %eax
+  801918:	8b 45 08             	mov    0x8(%ebp),%eax
+  80191b:	ff d0                	call   *%eax
+  80191d:	83 c4 10             	add    $0x10,%esp
+                for (width -= strnlen(p, precision); width > 0; width --) {
+  801920:	83 6d e8 01          	subl   $0x1,-0x18(%ebp)
+  801924:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  801928:	7f e0                	jg     80190a <vprintfmt+0x1cf>
+                }
+            }
+            for (; (ch = *p ++) != '\0' && (precision < 0 || -- precision >= 0); width --) {
+  80192a:	eb 3b                	jmp    801967 <vprintfmt+0x22c>
+                if (altflag && (ch < ' ' || ch > '~')) {
+  80192c:	83 7d dc 00          	cmpl   $0x0,-0x24(%ebp)
+  801930:	74 1f                	je     801951 <vprintfmt+0x216>
+  801932:	83 fb 1f             	cmp    $0x1f,%ebx
+  801935:	7e 05                	jle    80193c <vprintfmt+0x201>
+  801937:	83 fb 7e             	cmp    $0x7e,%ebx
+  80193a:	7e 15                	jle    801951 <vprintfmt+0x216>
+                    putch('?', putdat, fd);
+  80193c:	83 ec 04             	sub    $0x4,%esp
+  80193f:	ff 75 0c             	push   0xc(%ebp)
+  801942:	ff 75 10             	push   0x10(%ebp)
+  801945:	6a 3f                	push   $0x3f
+  801947:	8b 45 08             	mov    0x8(%ebp),%eax
+  80194a:	ff d0                	call   *%eax
+  80194c:	83 c4 10             	add    $0x10,%esp
+  80194f:	eb 12                	jmp    801963 <vprintfmt+0x228>
+                }
+                else {
+                    putch(ch, putdat, fd);
+  801951:	83 ec 04             	sub    $0x4,%esp
+  801954:	ff 75 0c             	push   0xc(%ebp)
+  801957:	ff 75 10             	push   0x10(%ebp)
+  80195a:	53                   	push   %ebx
+  80195b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80195e:	ff d0                	call   *%eax
+  801960:	83 c4 10             	add    $0x10,%esp
+            for (; (ch = *p ++) != '\0' && (precision < 0 || -- precision >= 0); width --) {
+  801963:	83 6d e8 01          	subl   $0x1,-0x18(%ebp)
+  801967:	89 f0                	mov    %esi,%eax
+  801969:	8d 70 01             	lea    0x1(%eax),%esi
+  80196c:	0f b6 00             	movzbl (%eax),%eax
+  80196f:	0f be d8             	movsbl %al,%ebx
+  801972:	85 db                	test   %ebx,%ebx
+  801974:	74 29                	je     80199f <vprintfmt+0x264>
+  801976:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  80197a:	78 b0                	js     80192c <vprintfmt+0x1f1>
+  80197c:	83 6d e4 01          	subl   $0x1,-0x1c(%ebp)
+  801980:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  801984:	79 a6                	jns    80192c <vprintfmt+0x1f1>
+                }
+            }
+            for (; width > 0; width --) {
+  801986:	eb 17                	jmp    80199f <vprintfmt+0x264>
+                putch(' ', putdat, fd);
+  801988:	83 ec 04             	sub    $0x4,%esp
+  80198b:	ff 75 0c             	push   0xc(%ebp)
+  80198e:	ff 75 10             	push   0x10(%ebp)
+  801991:	6a 20                	push   $0x20
+  801993:	8b 45 08             	mov    0x8(%ebp),%eax
+  801996:	ff d0                	call   *%eax
+  801998:	83 c4 10             	add    $0x10,%esp
+            for (; width > 0; width --) {
+  80199b:	83 6d e8 01          	subl   $0x1,-0x18(%ebp)
+  80199f:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  8019a3:	7f e3                	jg     801988 <vprintfmt+0x24d>
+            }
+            break;
+  8019a5:	e9 60 01 00 00       	jmp    801b0a <vprintfmt+0x3cf>
+
+        // (signed) decimal
+        case 'd':
+            num = getint(&ap, lflag);
+  8019aa:	83 ec 08             	sub    $0x8,%esp
+  8019ad:	ff 75 e0             	push   -0x20(%ebp)
+  8019b0:	8d 45 18             	lea    0x18(%ebp),%eax
+  8019b3:	50                   	push   %eax
+  8019b4:	e8 11 fd ff ff       	call   8016ca <getint>
+  8019b9:	83 c4 10             	add    $0x10,%esp
+  8019bc:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8019bf:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            if ((long long)num < 0) {
+  8019c2:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8019c5:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  8019c8:	85 d2                	test   %edx,%edx
+  8019ca:	79 26                	jns    8019f2 <vprintfmt+0x2b7>
+                putch('-', putdat, fd);
+  8019cc:	83 ec 04             	sub    $0x4,%esp
+  8019cf:	ff 75 0c             	push   0xc(%ebp)
+  8019d2:	ff 75 10             	push   0x10(%ebp)
+  8019d5:	6a 2d                	push   $0x2d
+  8019d7:	8b 45 08             	mov    0x8(%ebp),%eax
+  8019da:	ff d0                	call   *%eax
+  8019dc:	83 c4 10             	add    $0x10,%esp
+                num = -(long long)num;
+  8019df:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8019e2:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  8019e5:	f7 d8                	neg    %eax
+  8019e7:	83 d2 00             	adc    $0x0,%edx
+  8019ea:	f7 da                	neg    %edx
+  8019ec:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8019ef:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            }
+            base = 10;
+  8019f2:	c7 45 ec 0a 00 00 00 	movl   $0xa,-0x14(%ebp)
+            goto number;
+  8019f9:	e9 a8 00 00 00       	jmp    801aa6 <vprintfmt+0x36b>
+
+        // unsigned decimal
+        case 'u':
+            num = getuint(&ap, lflag);
+  8019fe:	83 ec 08             	sub    $0x8,%esp
+  801a01:	ff 75 e0             	push   -0x20(%ebp)
+  801a04:	8d 45 18             	lea    0x18(%ebp),%eax
+  801a07:	50                   	push   %eax
+  801a08:	e8 6e fc ff ff       	call   80167b <getuint>
+  801a0d:	83 c4 10             	add    $0x10,%esp
+  801a10:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801a13:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 10;
+  801a16:	c7 45 ec 0a 00 00 00 	movl   $0xa,-0x14(%ebp)
+            goto number;
+  801a1d:	e9 84 00 00 00       	jmp    801aa6 <vprintfmt+0x36b>
+
+        // (unsigned) octal
+        case 'o':
+            num = getuint(&ap, lflag);
+  801a22:	83 ec 08             	sub    $0x8,%esp
+  801a25:	ff 75 e0             	push   -0x20(%ebp)
+  801a28:	8d 45 18             	lea    0x18(%ebp),%eax
+  801a2b:	50                   	push   %eax
+  801a2c:	e8 4a fc ff ff       	call   80167b <getuint>
+  801a31:	83 c4 10             	add    $0x10,%esp
+  801a34:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801a37:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 8;
+  801a3a:	c7 45 ec 08 00 00 00 	movl   $0x8,-0x14(%ebp)
+            goto number;
+  801a41:	eb 63                	jmp    801aa6 <vprintfmt+0x36b>
+
+        // pointer
+        case 'p':
+            putch('0', putdat, fd);
+  801a43:	83 ec 04             	sub    $0x4,%esp
+  801a46:	ff 75 0c             	push   0xc(%ebp)
+  801a49:	ff 75 10             	push   0x10(%ebp)
+  801a4c:	6a 30                	push   $0x30
+  801a4e:	8b 45 08             	mov    0x8(%ebp),%eax
+  801a51:	ff d0                	call   *%eax
+  801a53:	83 c4 10             	add    $0x10,%esp
+            putch('x', putdat, fd);
+  801a56:	83 ec 04             	sub    $0x4,%esp
+  801a59:	ff 75 0c             	push   0xc(%ebp)
+  801a5c:	ff 75 10             	push   0x10(%ebp)
+  801a5f:	6a 78                	push   $0x78
+  801a61:	8b 45 08             	mov    0x8(%ebp),%eax
+  801a64:	ff d0                	call   *%eax
+  801a66:	83 c4 10             	add    $0x10,%esp
+            num = (unsigned long long)(uintptr_t)va_arg(ap, void *);
+  801a69:	8b 45 18             	mov    0x18(%ebp),%eax
+  801a6c:	8d 50 04             	lea    0x4(%eax),%edx
+  801a6f:	89 55 18             	mov    %edx,0x18(%ebp)
+  801a72:	8b 00                	mov    (%eax),%eax
+  801a74:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801a77:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+            base = 16;
+  801a7e:	c7 45 ec 10 00 00 00 	movl   $0x10,-0x14(%ebp)
+            goto number;
+  801a85:	eb 1f                	jmp    801aa6 <vprintfmt+0x36b>
+
+        // (unsigned) hexadecimal
+        case 'x':
+            num = getuint(&ap, lflag);
+  801a87:	83 ec 08             	sub    $0x8,%esp
+  801a8a:	ff 75 e0             	push   -0x20(%ebp)
+  801a8d:	8d 45 18             	lea    0x18(%ebp),%eax
+  801a90:	50                   	push   %eax
+  801a91:	e8 e5 fb ff ff       	call   80167b <getuint>
+  801a96:	83 c4 10             	add    $0x10,%esp
+  801a99:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801a9c:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 16;
+  801a9f:	c7 45 ec 10 00 00 00 	movl   $0x10,-0x14(%ebp)
+        number:
+            printnum(putch, fd, putdat, num, base, width, padc);
+  801aa6:	0f be 55 db          	movsbl -0x25(%ebp),%edx
+  801aaa:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801aad:	52                   	push   %edx
+  801aae:	ff 75 e8             	push   -0x18(%ebp)
+  801ab1:	50                   	push   %eax
+  801ab2:	ff 75 f4             	push   -0xc(%ebp)
+  801ab5:	ff 75 f0             	push   -0x10(%ebp)
+  801ab8:	ff 75 10             	push   0x10(%ebp)
+  801abb:	ff 75 0c             	push   0xc(%ebp)
+  801abe:	ff 75 08             	push   0x8(%ebp)
+  801ac1:	e8 c3 fa ff ff       	call   801589 <printnum>
+  801ac6:	83 c4 20             	add    $0x20,%esp
+            break;
+  801ac9:	eb 3f                	jmp    801b0a <vprintfmt+0x3cf>
+
+        // escaped '%' character
+        case '%':
+            putch(ch, putdat, fd);
+  801acb:	83 ec 04             	sub    $0x4,%esp
+  801ace:	ff 75 0c             	push   0xc(%ebp)
+  801ad1:	ff 75 10             	push   0x10(%ebp)
+  801ad4:	53                   	push   %ebx
+  801ad5:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ad8:	ff d0                	call   *%eax
+  801ada:	83 c4 10             	add    $0x10,%esp
+            break;
+  801add:	eb 2b                	jmp    801b0a <vprintfmt+0x3cf>
+
+        // unrecognized escape sequence - just print it literally
+        default:
+            putch('%', putdat, fd);
+  801adf:	83 ec 04             	sub    $0x4,%esp
+  801ae2:	ff 75 0c             	push   0xc(%ebp)
+  801ae5:	ff 75 10             	push   0x10(%ebp)
+  801ae8:	6a 25                	push   $0x25
+  801aea:	8b 45 08             	mov    0x8(%ebp),%eax
+  801aed:	ff d0                	call   *%eax
+  801aef:	83 c4 10             	add    $0x10,%esp
+            for (fmt --; fmt[-1] != '%'; fmt --)
+  801af2:	83 6d 14 01          	subl   $0x1,0x14(%ebp)
+  801af6:	eb 04                	jmp    801afc <vprintfmt+0x3c1>
+  801af8:	83 6d 14 01          	subl   $0x1,0x14(%ebp)
+  801afc:	8b 45 14             	mov    0x14(%ebp),%eax
+  801aff:	83 e8 01             	sub    $0x1,%eax
+  801b02:	0f b6 00             	movzbl (%eax),%eax
+  801b05:	3c 25                	cmp    $0x25,%al
+  801b07:	75 ef                	jne    801af8 <vprintfmt+0x3bd>
+                /* do nothing */;
+            break;
+  801b09:	90                   	nop
+    while (1) {
+  801b0a:	e9 34 fc ff ff       	jmp    801743 <vprintfmt+0x8>
+                return;
+  801b0f:	90                   	nop
+        }
+    }
+}
+  801b10:	8d 65 f8             	lea    -0x8(%ebp),%esp
+  801b13:	5b                   	pop    %ebx
+  801b14:	5e                   	pop    %esi
+  801b15:	5d                   	pop    %ebp
+  801b16:	c3                   	ret
+
+00801b17 <sprintputch>:
+ * sprintputch - 'print' a single character in a buffer
+ * @ch:         the character will be printed
+ * @b:          the buffer to place the character @ch
+ * */
+static void
+sprintputch(int ch, struct sprintbuf *b) {
+  801b17:	55                   	push   %ebp
+  801b18:	89 e5                	mov    %esp,%ebp
+    b->cnt ++;
+  801b1a:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801b1d:	8b 40 08             	mov    0x8(%eax),%eax
+  801b20:	8d 50 01             	lea    0x1(%eax),%edx
+  801b23:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801b26:	89 50 08             	mov    %edx,0x8(%eax)
+    if (b->buf < b->ebuf) {
+  801b29:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801b2c:	8b 10                	mov    (%eax),%edx
+  801b2e:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801b31:	8b 40 04             	mov    0x4(%eax),%eax
+  801b34:	39 c2                	cmp    %eax,%edx
+  801b36:	73 12                	jae    801b4a <sprintputch+0x33>
+        *b->buf ++ = ch;
+  801b38:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801b3b:	8b 00                	mov    (%eax),%eax
+  801b3d:	8d 48 01             	lea    0x1(%eax),%ecx
+  801b40:	8b 55 0c             	mov    0xc(%ebp),%edx
+  801b43:	89 0a                	mov    %ecx,(%edx)
+  801b45:	8b 55 08             	mov    0x8(%ebp),%edx
+  801b48:	88 10                	mov    %dl,(%eax)
+    }
+}
+  801b4a:	90                   	nop
+  801b4b:	5d                   	pop    %ebp
+  801b4c:	c3                   	ret
+
+00801b4d <snprintf>:
+ * @str:        the buffer to place the result into
+ * @size:       the size of buffer, including the trailing null space
+ * @fmt:        the format string to use
+ * */
+int
+snprintf(char *str, size_t size, const char *fmt, ...) {
+  801b4d:	55                   	push   %ebp
+  801b4e:	89 e5                	mov    %esp,%ebp
+  801b50:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+    int cnt;
+    va_start(ap, fmt);
+  801b53:	8d 45 14             	lea    0x14(%ebp),%eax
+  801b56:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    cnt = vsnprintf(str, size, fmt, ap);
+  801b59:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801b5c:	50                   	push   %eax
+  801b5d:	ff 75 10             	push   0x10(%ebp)
+  801b60:	ff 75 0c             	push   0xc(%ebp)
+  801b63:	ff 75 08             	push   0x8(%ebp)
+  801b66:	e8 0b 00 00 00       	call   801b76 <vsnprintf>
+  801b6b:	83 c4 10             	add    $0x10,%esp
+  801b6e:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+    return cnt;
+  801b71:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801b74:	c9                   	leave
+  801b75:	c3                   	ret
+
+00801b76 <vsnprintf>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want snprintf() instead.
+ * */
+int
+vsnprintf(char *str, size_t size, const char *fmt, va_list ap) {
+  801b76:	55                   	push   %ebp
+  801b77:	89 e5                	mov    %esp,%ebp
+  801b79:	83 ec 18             	sub    $0x18,%esp
+    struct sprintbuf b = {str, str + size - 1, 0};
+  801b7c:	8b 45 08             	mov    0x8(%ebp),%eax
+  801b7f:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  801b82:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801b85:	8d 50 ff             	lea    -0x1(%eax),%edx
+  801b88:	8b 45 08             	mov    0x8(%ebp),%eax
+  801b8b:	01 d0                	add    %edx,%eax
+  801b8d:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801b90:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    if (str == NULL || b.buf > b.ebuf) {
+  801b97:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  801b9b:	74 0a                	je     801ba7 <vsnprintf+0x31>
+  801b9d:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801ba0:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  801ba3:	39 c2                	cmp    %eax,%edx
+  801ba5:	73 07                	jae    801bae <vsnprintf+0x38>
+        return -E_INVAL;
+  801ba7:	b8 fd ff ff ff       	mov    $0xfffffffd,%eax
+  801bac:	eb 28                	jmp    801bd6 <vsnprintf+0x60>
+    }
+    // print the string to the buffer
+    vprintfmt((void*)sprintputch, NO_FD, &b, fmt, ap);
+  801bae:	83 ec 0c             	sub    $0xc,%esp
+  801bb1:	ff 75 14             	push   0x14(%ebp)
+  801bb4:	ff 75 10             	push   0x10(%ebp)
+  801bb7:	8d 45 ec             	lea    -0x14(%ebp),%eax
+  801bba:	50                   	push   %eax
+  801bbb:	68 d9 6a ff ff       	push   $0xffff6ad9
+  801bc0:	68 17 1b 80 00       	push   $0x801b17
+  801bc5:	e8 71 fb ff ff       	call   80173b <vprintfmt>
+  801bca:	83 c4 20             	add    $0x20,%esp
+    // null terminate the buffer
+    *b.buf = '\0';
+  801bcd:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801bd0:	c6 00 00             	movb   $0x0,(%eax)
+    return b.cnt;
+  801bd3:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801bd6:	c9                   	leave
+  801bd7:	c3                   	ret
+
+00801bd8 <rand>:
+ * rand - returns a pseudo-random integer
+ *
+ * The rand() function return a value in the range [0, RAND_MAX].
+ * */
+int
+rand(void) {
+  801bd8:	55                   	push   %ebp
+  801bd9:	89 e5                	mov    %esp,%ebp
+  801bdb:	57                   	push   %edi
+  801bdc:	56                   	push   %esi
+  801bdd:	53                   	push   %ebx
+  801bde:	83 ec 24             	sub    $0x24,%esp
+    next = (next * 0x5DEECE66DLL + 0xBLL) & ((1LL << 48) - 1);
+  801be1:	a1 10 30 80 00       	mov    0x803010,%eax
+  801be6:	8b 15 14 30 80 00    	mov    0x803014,%edx
+  801bec:	69 fa 6d e6 ec de    	imul   $0xdeece66d,%edx,%edi
+  801bf2:	6b f0 05             	imul   $0x5,%eax,%esi
+  801bf5:	01 fe                	add    %edi,%esi
+  801bf7:	bf 6d e6 ec de       	mov    $0xdeece66d,%edi
+  801bfc:	f7 e7                	mul    %edi
+  801bfe:	01 d6                	add    %edx,%esi
+  801c00:	89 f2                	mov    %esi,%edx
+  801c02:	83 c0 0b             	add    $0xb,%eax
+  801c05:	83 d2 00             	adc    $0x0,%edx
+  801c08:	89 c1                	mov    %eax,%ecx
+  801c0a:	0f b7 da             	movzwl %dx,%ebx
+  801c0d:	89 0d 10 30 80 00    	mov    %ecx,0x803010
+  801c13:	89 1d 14 30 80 00    	mov    %ebx,0x803014
+    unsigned long long result = (next >> 12);
+  801c19:	a1 10 30 80 00       	mov    0x803010,%eax
+  801c1e:	8b 15 14 30 80 00    	mov    0x803014,%edx
+  801c24:	0f ac d0 0c          	shrd   $0xc,%edx,%eax
+  801c28:	c1 ea 0c             	shr    $0xc,%edx
+  801c2b:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801c2e:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+    return (int)do_div(result, RAND_MAX + 1);
+  801c31:	c7 45 dc 00 00 00 80 	movl   $0x80000000,-0x24(%ebp)
+  801c38:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  801c3b:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  801c3e:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  801c41:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  801c44:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801c47:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  801c4a:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  801c4e:	74 1c                	je     801c6c <rand+0x94>
+  801c50:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801c53:	ba 00 00 00 00       	mov    $0x0,%edx
+  801c58:	f7 75 dc             	divl   -0x24(%ebp)
+  801c5b:	89 55 ec             	mov    %edx,-0x14(%ebp)
+  801c5e:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801c61:	ba 00 00 00 00       	mov    $0x0,%edx
+  801c66:	f7 75 dc             	divl   -0x24(%ebp)
+  801c69:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  801c6c:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  801c6f:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  801c72:	f7 75 dc             	divl   -0x24(%ebp)
+  801c75:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  801c78:	89 55 d4             	mov    %edx,-0x2c(%ebp)
+  801c7b:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  801c7e:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  801c81:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801c84:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  801c87:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+}
+  801c8a:	83 c4 24             	add    $0x24,%esp
+  801c8d:	5b                   	pop    %ebx
+  801c8e:	5e                   	pop    %esi
+  801c8f:	5f                   	pop    %edi
+  801c90:	5d                   	pop    %ebp
+  801c91:	c3                   	ret
+
+00801c92 <srand>:
+/* *
+ * srand - seed the random number generator with the given number
+ * @seed:   the required seed number
+ * */
+void
+srand(unsigned int seed) {
+  801c92:	55                   	push   %ebp
+  801c93:	89 e5                	mov    %esp,%ebp
+    next = seed;
+  801c95:	8b 45 08             	mov    0x8(%ebp),%eax
+  801c98:	ba 00 00 00 00       	mov    $0x0,%edx
+  801c9d:	a3 10 30 80 00       	mov    %eax,0x803010
+  801ca2:	89 15 14 30 80 00    	mov    %edx,0x803014
+}
+  801ca8:	90                   	nop
+  801ca9:	5d                   	pop    %ebp
+  801caa:	c3                   	ret
+
+00801cab <strlen>:
+ * @s:      the input string
+ *
+ * The strlen() function returns the length of string @s.
+ * */
+size_t
+strlen(const char *s) {
+  801cab:	55                   	push   %ebp
+  801cac:	89 e5                	mov    %esp,%ebp
+  801cae:	83 ec 10             	sub    $0x10,%esp
+    size_t cnt = 0;
+  801cb1:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    while (*s ++ != '\0') {
+  801cb8:	eb 04                	jmp    801cbe <strlen+0x13>
+        cnt ++;
+  801cba:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+    while (*s ++ != '\0') {
+  801cbe:	8b 45 08             	mov    0x8(%ebp),%eax
+  801cc1:	8d 50 01             	lea    0x1(%eax),%edx
+  801cc4:	89 55 08             	mov    %edx,0x8(%ebp)
+  801cc7:	0f b6 00             	movzbl (%eax),%eax
+  801cca:	84 c0                	test   %al,%al
+  801ccc:	75 ec                	jne    801cba <strlen+0xf>
+    }
+    return cnt;
+  801cce:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  801cd1:	c9                   	leave
+  801cd2:	c3                   	ret
+
+00801cd3 <strnlen>:
+ * The return value is strlen(s), if that is less than @len, or
+ * @len if there is no '\0' character among the first @len characters
+ * pointed by @s.
+ * */
+size_t
+strnlen(const char *s, size_t len) {
+  801cd3:	55                   	push   %ebp
+  801cd4:	89 e5                	mov    %esp,%ebp
+  801cd6:	83 ec 10             	sub    $0x10,%esp
+    size_t cnt = 0;
+  801cd9:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    while (cnt < len && *s ++ != '\0') {
+  801ce0:	eb 04                	jmp    801ce6 <strnlen+0x13>
+        cnt ++;
+  801ce2:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+    while (cnt < len && *s ++ != '\0') {
+  801ce6:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801ce9:	3b 45 0c             	cmp    0xc(%ebp),%eax
+  801cec:	73 10                	jae    801cfe <strnlen+0x2b>
+  801cee:	8b 45 08             	mov    0x8(%ebp),%eax
+  801cf1:	8d 50 01             	lea    0x1(%eax),%edx
+  801cf4:	89 55 08             	mov    %edx,0x8(%ebp)
+  801cf7:	0f b6 00             	movzbl (%eax),%eax
+  801cfa:	84 c0                	test   %al,%al
+  801cfc:	75 e4                	jne    801ce2 <strnlen+0xf>
+    }
+    return cnt;
+  801cfe:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  801d01:	c9                   	leave
+  801d02:	c3                   	ret
+
+00801d03 <strcat>:
+ * @dst:    pointer to the @dst array, which should be large enough to contain the concatenated
+ *          resulting string.
+ * @src:    string to be appended, this should not overlap @dst
+ * */
+char *
+strcat(char *dst, const char *src) {
+  801d03:	55                   	push   %ebp
+  801d04:	89 e5                	mov    %esp,%ebp
+  801d06:	83 ec 08             	sub    $0x8,%esp
+    return strcpy(dst + strlen(dst), src);
+  801d09:	ff 75 08             	push   0x8(%ebp)
+  801d0c:	e8 9a ff ff ff       	call   801cab <strlen>
+  801d11:	83 c4 04             	add    $0x4,%esp
+  801d14:	8b 55 08             	mov    0x8(%ebp),%edx
+  801d17:	01 d0                	add    %edx,%eax
+  801d19:	83 ec 08             	sub    $0x8,%esp
+  801d1c:	ff 75 0c             	push   0xc(%ebp)
+  801d1f:	50                   	push   %eax
+  801d20:	e8 05 00 00 00       	call   801d2a <strcpy>
+  801d25:	83 c4 10             	add    $0x10,%esp
+}
+  801d28:	c9                   	leave
+  801d29:	c3                   	ret
+
+00801d2a <strcpy>:
+ * To avoid overflows, the size of array pointed by @dst should be long enough to
+ * contain the same string as @src (including the terminating null character), and
+ * should not overlap in memory with @src.
+ * */
+char *
+strcpy(char *dst, const char *src) {
+  801d2a:	55                   	push   %ebp
+  801d2b:	89 e5                	mov    %esp,%ebp
+  801d2d:	57                   	push   %edi
+  801d2e:	56                   	push   %esi
+  801d2f:	83 ec 20             	sub    $0x20,%esp
+  801d32:	8b 45 08             	mov    0x8(%ebp),%eax
+  801d35:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801d38:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801d3b:	89 45 f0             	mov    %eax,-0x10(%ebp)
+#ifndef __HAVE_ARCH_STRCPY
+#define __HAVE_ARCH_STRCPY
+static inline char *
+__strcpy(char *dst, const char *src) {
+    int d0, d1, d2;
+    asm volatile (
+  801d3e:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  801d41:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801d44:	89 d1                	mov    %edx,%ecx
+  801d46:	89 c2                	mov    %eax,%edx
+  801d48:	89 ce                	mov    %ecx,%esi
+  801d4a:	89 d7                	mov    %edx,%edi
+  801d4c:	ac                   	lods   %ds:(%esi),%al
+  801d4d:	aa                   	stos   %al,%es:(%edi)
+  801d4e:	84 c0                	test   %al,%al
+  801d50:	75 fa                	jne    801d4c <strcpy+0x22>
+  801d52:	89 fa                	mov    %edi,%edx
+  801d54:	89 f1                	mov    %esi,%ecx
+  801d56:	89 4d ec             	mov    %ecx,-0x14(%ebp)
+  801d59:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  801d5c:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+        "stosb;"
+        "testb %%al, %%al;"
+        "jne 1b;"
+        : "=&S" (d0), "=&D" (d1), "=&a" (d2)
+        : "0" (src), "1" (dst) : "memory");
+    return dst;
+  801d5f:	8b 45 f4             	mov    -0xc(%ebp),%eax
+    char *p = dst;
+    while ((*p ++ = *src ++) != '\0')
+        /* nothing */;
+    return dst;
+#endif /* __HAVE_ARCH_STRCPY */
+}
+  801d62:	83 c4 20             	add    $0x20,%esp
+  801d65:	5e                   	pop    %esi
+  801d66:	5f                   	pop    %edi
+  801d67:	5d                   	pop    %ebp
+  801d68:	c3                   	ret
+
+00801d69 <strncpy>:
+ * @len:    maximum number of characters to be copied from @src
+ *
+ * The return value is @dst
+ * */
+char *
+strncpy(char *dst, const char *src, size_t len) {
+  801d69:	55                   	push   %ebp
+  801d6a:	89 e5                	mov    %esp,%ebp
+  801d6c:	83 ec 10             	sub    $0x10,%esp
+    char *p = dst;
+  801d6f:	8b 45 08             	mov    0x8(%ebp),%eax
+  801d72:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    while (len > 0) {
+  801d75:	eb 21                	jmp    801d98 <strncpy+0x2f>
+        if ((*p = *src) != '\0') {
+  801d77:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801d7a:	0f b6 10             	movzbl (%eax),%edx
+  801d7d:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801d80:	88 10                	mov    %dl,(%eax)
+  801d82:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801d85:	0f b6 00             	movzbl (%eax),%eax
+  801d88:	84 c0                	test   %al,%al
+  801d8a:	74 04                	je     801d90 <strncpy+0x27>
+            src ++;
+  801d8c:	83 45 0c 01          	addl   $0x1,0xc(%ebp)
+        }
+        p ++, len --;
+  801d90:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+  801d94:	83 6d 10 01          	subl   $0x1,0x10(%ebp)
+    while (len > 0) {
+  801d98:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  801d9c:	75 d9                	jne    801d77 <strncpy+0xe>
+    }
+    return dst;
+  801d9e:	8b 45 08             	mov    0x8(%ebp),%eax
+}
+  801da1:	c9                   	leave
+  801da2:	c3                   	ret
+
+00801da3 <strcmp>:
+ * - A value greater than zero indicates that the first character that does
+ *   not match has a greater value in @s1 than in @s2;
+ * - And a value less than zero indicates the opposite.
+ * */
+int
+strcmp(const char *s1, const char *s2) {
+  801da3:	55                   	push   %ebp
+  801da4:	89 e5                	mov    %esp,%ebp
+  801da6:	57                   	push   %edi
+  801da7:	56                   	push   %esi
+  801da8:	83 ec 20             	sub    $0x20,%esp
+  801dab:	8b 45 08             	mov    0x8(%ebp),%eax
+  801dae:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801db1:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801db4:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    asm volatile (
+  801db7:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  801dba:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801dbd:	89 d1                	mov    %edx,%ecx
+  801dbf:	89 c2                	mov    %eax,%edx
+  801dc1:	89 ce                	mov    %ecx,%esi
+  801dc3:	89 d7                	mov    %edx,%edi
+  801dc5:	ac                   	lods   %ds:(%esi),%al
+  801dc6:	ae                   	scas   %es:(%edi),%al
+  801dc7:	75 08                	jne    801dd1 <strcmp+0x2e>
+  801dc9:	84 c0                	test   %al,%al
+  801dcb:	75 f8                	jne    801dc5 <strcmp+0x22>
+  801dcd:	31 c0                	xor    %eax,%eax
+  801dcf:	eb 04                	jmp    801dd5 <strcmp+0x32>
+  801dd1:	19 c0                	sbb    %eax,%eax
+  801dd3:	0c 01                	or     $0x1,%al
+  801dd5:	89 fa                	mov    %edi,%edx
+  801dd7:	89 f1                	mov    %esi,%ecx
+  801dd9:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  801ddc:	89 4d e8             	mov    %ecx,-0x18(%ebp)
+  801ddf:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+    return ret;
+  801de2:	8b 45 ec             	mov    -0x14(%ebp),%eax
+    while (*s1 != '\0' && *s1 == *s2) {
+        s1 ++, s2 ++;
+    }
+    return (int)((unsigned char)*s1 - (unsigned char)*s2);
+#endif /* __HAVE_ARCH_STRCMP */
+}
+  801de5:	83 c4 20             	add    $0x20,%esp
+  801de8:	5e                   	pop    %esi
+  801de9:	5f                   	pop    %edi
+  801dea:	5d                   	pop    %ebp
+  801deb:	c3                   	ret
+
+00801dec <strncmp>:
+ * they are equal to each other, it continues with the following pairs until
+ * the characters differ, until a terminating null-character is reached, or
+ * until @n characters match in both strings, whichever happens first.
+ * */
+int
+strncmp(const char *s1, const char *s2, size_t n) {
+  801dec:	55                   	push   %ebp
+  801ded:	89 e5                	mov    %esp,%ebp
+    while (n > 0 && *s1 != '\0' && *s1 == *s2) {
+  801def:	eb 0c                	jmp    801dfd <strncmp+0x11>
+        n --, s1 ++, s2 ++;
+  801df1:	83 6d 10 01          	subl   $0x1,0x10(%ebp)
+  801df5:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  801df9:	83 45 0c 01          	addl   $0x1,0xc(%ebp)
+    while (n > 0 && *s1 != '\0' && *s1 == *s2) {
+  801dfd:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  801e01:	74 1a                	je     801e1d <strncmp+0x31>
+  801e03:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e06:	0f b6 00             	movzbl (%eax),%eax
+  801e09:	84 c0                	test   %al,%al
+  801e0b:	74 10                	je     801e1d <strncmp+0x31>
+  801e0d:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e10:	0f b6 10             	movzbl (%eax),%edx
+  801e13:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801e16:	0f b6 00             	movzbl (%eax),%eax
+  801e19:	38 c2                	cmp    %al,%dl
+  801e1b:	74 d4                	je     801df1 <strncmp+0x5>
+    }
+    return (n == 0) ? 0 : (int)((unsigned char)*s1 - (unsigned char)*s2);
+  801e1d:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  801e21:	74 16                	je     801e39 <strncmp+0x4d>
+  801e23:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e26:	0f b6 00             	movzbl (%eax),%eax
+  801e29:	0f b6 d0             	movzbl %al,%edx
+  801e2c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801e2f:	0f b6 00             	movzbl (%eax),%eax
+  801e32:	0f b6 c0             	movzbl %al,%eax
+  801e35:	29 c2                	sub    %eax,%edx
+  801e37:	eb 05                	jmp    801e3e <strncmp+0x52>
+  801e39:	ba 00 00 00 00       	mov    $0x0,%edx
+  801e3e:	89 d0                	mov    %edx,%eax
+}
+  801e40:	5d                   	pop    %ebp
+  801e41:	c3                   	ret
+
+00801e42 <strchr>:
+ *
+ * The strchr() function returns a pointer to the first occurrence of
+ * character in @s. If the value is not found, the function returns 'NULL'.
+ * */
+char *
+strchr(const char *s, char c) {
+  801e42:	55                   	push   %ebp
+  801e43:	89 e5                	mov    %esp,%ebp
+  801e45:	83 ec 04             	sub    $0x4,%esp
+  801e48:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801e4b:	88 45 fc             	mov    %al,-0x4(%ebp)
+    while (*s != '\0') {
+  801e4e:	eb 14                	jmp    801e64 <strchr+0x22>
+        if (*s == c) {
+  801e50:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e53:	0f b6 00             	movzbl (%eax),%eax
+  801e56:	38 45 fc             	cmp    %al,-0x4(%ebp)
+  801e59:	75 05                	jne    801e60 <strchr+0x1e>
+            return (char *)s;
+  801e5b:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e5e:	eb 13                	jmp    801e73 <strchr+0x31>
+        }
+        s ++;
+  801e60:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+    while (*s != '\0') {
+  801e64:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e67:	0f b6 00             	movzbl (%eax),%eax
+  801e6a:	84 c0                	test   %al,%al
+  801e6c:	75 e2                	jne    801e50 <strchr+0xe>
+    }
+    return NULL;
+  801e6e:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  801e73:	c9                   	leave
+  801e74:	c3                   	ret
+
+00801e75 <strfind>:
+ * The strfind() function is like strchr() except that if @c is
+ * not found in @s, then it returns a pointer to the null byte at the
+ * end of @s, rather than 'NULL'.
+ * */
+char *
+strfind(const char *s, char c) {
+  801e75:	55                   	push   %ebp
+  801e76:	89 e5                	mov    %esp,%ebp
+  801e78:	83 ec 04             	sub    $0x4,%esp
+  801e7b:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801e7e:	88 45 fc             	mov    %al,-0x4(%ebp)
+    while (*s != '\0') {
+  801e81:	eb 0f                	jmp    801e92 <strfind+0x1d>
+        if (*s == c) {
+  801e83:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e86:	0f b6 00             	movzbl (%eax),%eax
+  801e89:	38 45 fc             	cmp    %al,-0x4(%ebp)
+  801e8c:	74 10                	je     801e9e <strfind+0x29>
+            break;
+        }
+        s ++;
+  801e8e:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+    while (*s != '\0') {
+  801e92:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e95:	0f b6 00             	movzbl (%eax),%eax
+  801e98:	84 c0                	test   %al,%al
+  801e9a:	75 e7                	jne    801e83 <strfind+0xe>
+  801e9c:	eb 01                	jmp    801e9f <strfind+0x2a>
+            break;
+  801e9e:	90                   	nop
+    }
+    return (char *)s;
+  801e9f:	8b 45 08             	mov    0x8(%ebp),%eax
+}
+  801ea2:	c9                   	leave
+  801ea3:	c3                   	ret
+
+00801ea4 <strtol>:
+ * an optional "0x" or "0X" prefix.
+ *
+ * The strtol() function returns the converted integral number as a long int value.
+ * */
+long
+strtol(const char *s, char **endptr, int base) {
+  801ea4:	55                   	push   %ebp
+  801ea5:	89 e5                	mov    %esp,%ebp
+  801ea7:	83 ec 10             	sub    $0x10,%esp
+    int neg = 0;
+  801eaa:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    long val = 0;
+  801eb1:	c7 45 f8 00 00 00 00 	movl   $0x0,-0x8(%ebp)
+
+    // gobble initial whitespace
+    while (*s == ' ' || *s == '\t') {
+  801eb8:	eb 04                	jmp    801ebe <strtol+0x1a>
+        s ++;
+  801eba:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+    while (*s == ' ' || *s == '\t') {
+  801ebe:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ec1:	0f b6 00             	movzbl (%eax),%eax
+  801ec4:	3c 20                	cmp    $0x20,%al
+  801ec6:	74 f2                	je     801eba <strtol+0x16>
+  801ec8:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ecb:	0f b6 00             	movzbl (%eax),%eax
+  801ece:	3c 09                	cmp    $0x9,%al
+  801ed0:	74 e8                	je     801eba <strtol+0x16>
+    }
+
+    // plus/minus sign
+    if (*s == '+') {
+  801ed2:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ed5:	0f b6 00             	movzbl (%eax),%eax
+  801ed8:	3c 2b                	cmp    $0x2b,%al
+  801eda:	75 06                	jne    801ee2 <strtol+0x3e>
+        s ++;
+  801edc:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  801ee0:	eb 15                	jmp    801ef7 <strtol+0x53>
+    }
+    else if (*s == '-') {
+  801ee2:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ee5:	0f b6 00             	movzbl (%eax),%eax
+  801ee8:	3c 2d                	cmp    $0x2d,%al
+  801eea:	75 0b                	jne    801ef7 <strtol+0x53>
+        s ++, neg = 1;
+  801eec:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  801ef0:	c7 45 fc 01 00 00 00 	movl   $0x1,-0x4(%ebp)
+    }
+
+    // hex or octal base prefix
+    if ((base == 0 || base == 16) && (s[0] == '0' && s[1] == 'x')) {
+  801ef7:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  801efb:	74 06                	je     801f03 <strtol+0x5f>
+  801efd:	83 7d 10 10          	cmpl   $0x10,0x10(%ebp)
+  801f01:	75 24                	jne    801f27 <strtol+0x83>
+  801f03:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f06:	0f b6 00             	movzbl (%eax),%eax
+  801f09:	3c 30                	cmp    $0x30,%al
+  801f0b:	75 1a                	jne    801f27 <strtol+0x83>
+  801f0d:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f10:	83 c0 01             	add    $0x1,%eax
+  801f13:	0f b6 00             	movzbl (%eax),%eax
+  801f16:	3c 78                	cmp    $0x78,%al
+  801f18:	75 0d                	jne    801f27 <strtol+0x83>
+        s += 2, base = 16;
+  801f1a:	83 45 08 02          	addl   $0x2,0x8(%ebp)
+  801f1e:	c7 45 10 10 00 00 00 	movl   $0x10,0x10(%ebp)
+  801f25:	eb 2a                	jmp    801f51 <strtol+0xad>
+    }
+    else if (base == 0 && s[0] == '0') {
+  801f27:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  801f2b:	75 17                	jne    801f44 <strtol+0xa0>
+  801f2d:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f30:	0f b6 00             	movzbl (%eax),%eax
+  801f33:	3c 30                	cmp    $0x30,%al
+  801f35:	75 0d                	jne    801f44 <strtol+0xa0>
+        s ++, base = 8;
+  801f37:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  801f3b:	c7 45 10 08 00 00 00 	movl   $0x8,0x10(%ebp)
+  801f42:	eb 0d                	jmp    801f51 <strtol+0xad>
+    }
+    else if (base == 0) {
+  801f44:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  801f48:	75 07                	jne    801f51 <strtol+0xad>
+        base = 10;
+  801f4a:	c7 45 10 0a 00 00 00 	movl   $0xa,0x10(%ebp)
+
+    // digits
+    while (1) {
+        int dig;
+
+        if (*s >= '0' && *s <= '9') {
+  801f51:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f54:	0f b6 00             	movzbl (%eax),%eax
+  801f57:	3c 2f                	cmp    $0x2f,%al
+  801f59:	7e 1b                	jle    801f76 <strtol+0xd2>
+  801f5b:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f5e:	0f b6 00             	movzbl (%eax),%eax
+  801f61:	3c 39                	cmp    $0x39,%al
+  801f63:	7f 11                	jg     801f76 <strtol+0xd2>
+            dig = *s - '0';
+  801f65:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f68:	0f b6 00             	movzbl (%eax),%eax
+  801f6b:	0f be c0             	movsbl %al,%eax
+  801f6e:	83 e8 30             	sub    $0x30,%eax
+  801f71:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801f74:	eb 48                	jmp    801fbe <strtol+0x11a>
+        }
+        else if (*s >= 'a' && *s <= 'z') {
+  801f76:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f79:	0f b6 00             	movzbl (%eax),%eax
+  801f7c:	3c 60                	cmp    $0x60,%al
+  801f7e:	7e 1b                	jle    801f9b <strtol+0xf7>
+  801f80:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f83:	0f b6 00             	movzbl (%eax),%eax
+  801f86:	3c 7a                	cmp    $0x7a,%al
+  801f88:	7f 11                	jg     801f9b <strtol+0xf7>
+            dig = *s - 'a' + 10;
+  801f8a:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f8d:	0f b6 00             	movzbl (%eax),%eax
+  801f90:	0f be c0             	movsbl %al,%eax
+  801f93:	83 e8 57             	sub    $0x57,%eax
+  801f96:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801f99:	eb 23                	jmp    801fbe <strtol+0x11a>
+        }
+        else if (*s >= 'A' && *s <= 'Z') {
+  801f9b:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f9e:	0f b6 00             	movzbl (%eax),%eax
+  801fa1:	3c 40                	cmp    $0x40,%al
+  801fa3:	7e 3c                	jle    801fe1 <strtol+0x13d>
+  801fa5:	8b 45 08             	mov    0x8(%ebp),%eax
+  801fa8:	0f b6 00             	movzbl (%eax),%eax
+  801fab:	3c 5a                	cmp    $0x5a,%al
+  801fad:	7f 32                	jg     801fe1 <strtol+0x13d>
+            dig = *s - 'A' + 10;
+  801faf:	8b 45 08             	mov    0x8(%ebp),%eax
+  801fb2:	0f b6 00             	movzbl (%eax),%eax
+  801fb5:	0f be c0             	movsbl %al,%eax
+  801fb8:	83 e8 37             	sub    $0x37,%eax
+  801fbb:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        }
+        else {
+            break;
+        }
+        if (dig >= base) {
+  801fbe:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801fc1:	3b 45 10             	cmp    0x10(%ebp),%eax
+  801fc4:	7d 1a                	jge    801fe0 <strtol+0x13c>
+            break;
+        }
+        s ++, val = (val * base) + dig;
+  801fc6:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  801fca:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801fcd:	0f af 45 10          	imul   0x10(%ebp),%eax
+  801fd1:	89 c2                	mov    %eax,%edx
+  801fd3:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801fd6:	01 d0                	add    %edx,%eax
+  801fd8:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    while (1) {
+  801fdb:	e9 71 ff ff ff       	jmp    801f51 <strtol+0xad>
+            break;
+  801fe0:	90                   	nop
+        // we don't properly detect overflow!
+    }
+
+    if (endptr) {
+  801fe1:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  801fe5:	74 08                	je     801fef <strtol+0x14b>
+        *endptr = (char *) s;
+  801fe7:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801fea:	8b 55 08             	mov    0x8(%ebp),%edx
+  801fed:	89 10                	mov    %edx,(%eax)
+    }
+    return (neg ? -val : val);
+  801fef:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  801ff3:	74 07                	je     801ffc <strtol+0x158>
+  801ff5:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801ff8:	f7 d8                	neg    %eax
+  801ffa:	eb 03                	jmp    801fff <strtol+0x15b>
+  801ffc:	8b 45 f8             	mov    -0x8(%ebp),%eax
+}
+  801fff:	c9                   	leave
+  802000:	c3                   	ret
+
+00802001 <memset>:
+ * @n:      number of bytes to be set to the value
+ *
+ * The memset() function returns @s.
+ * */
+void *
+memset(void *s, char c, size_t n) {
+  802001:	55                   	push   %ebp
+  802002:	89 e5                	mov    %esp,%ebp
+  802004:	57                   	push   %edi
+  802005:	83 ec 24             	sub    $0x24,%esp
+  802008:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80200b:	88 45 d8             	mov    %al,-0x28(%ebp)
+#ifdef __HAVE_ARCH_MEMSET
+    return __memset(s, c, n);
+  80200e:	0f be 45 d8          	movsbl -0x28(%ebp),%eax
+  802012:	8b 55 08             	mov    0x8(%ebp),%edx
+  802015:	89 55 f8             	mov    %edx,-0x8(%ebp)
+  802018:	88 45 f7             	mov    %al,-0x9(%ebp)
+  80201b:	8b 45 10             	mov    0x10(%ebp),%eax
+  80201e:	89 45 f0             	mov    %eax,-0x10(%ebp)
+#ifndef __HAVE_ARCH_MEMSET
+#define __HAVE_ARCH_MEMSET
+static inline void *
+__memset(void *s, char c, size_t n) {
+    int d0, d1;
+    asm volatile (
+  802021:	8b 4d f0             	mov    -0x10(%ebp),%ecx
+  802024:	0f b6 45 f7          	movzbl -0x9(%ebp),%eax
+  802028:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  80202b:	89 d7                	mov    %edx,%edi
+  80202d:	f3 aa                	rep stos %al,%es:(%edi)
+  80202f:	89 fa                	mov    %edi,%edx
+  802031:	89 4d ec             	mov    %ecx,-0x14(%ebp)
+  802034:	89 55 e8             	mov    %edx,-0x18(%ebp)
+        "rep; stosb;"
+        : "=&c" (d0), "=&D" (d1)
+        : "0" (n), "a" (c), "1" (s)
+        : "memory");
+    return s;
+  802037:	8b 45 f8             	mov    -0x8(%ebp),%eax
+    while (n -- > 0) {
+        *p ++ = c;
+    }
+    return s;
+#endif /* __HAVE_ARCH_MEMSET */
+}
+  80203a:	8b 7d fc             	mov    -0x4(%ebp),%edi
+  80203d:	c9                   	leave
+  80203e:	c3                   	ret
+
+0080203f <memmove>:
+ * @n:      number of bytes to copy
+ *
+ * The memmove() function returns @dst.
+ * */
+void *
+memmove(void *dst, const void *src, size_t n) {
+  80203f:	55                   	push   %ebp
+  802040:	89 e5                	mov    %esp,%ebp
+  802042:	57                   	push   %edi
+  802043:	56                   	push   %esi
+  802044:	53                   	push   %ebx
+  802045:	83 ec 30             	sub    $0x30,%esp
+  802048:	8b 45 08             	mov    0x8(%ebp),%eax
+  80204b:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  80204e:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802051:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  802054:	8b 45 10             	mov    0x10(%ebp),%eax
+  802057:	89 45 e8             	mov    %eax,-0x18(%ebp)
+
+#ifndef __HAVE_ARCH_MEMMOVE
+#define __HAVE_ARCH_MEMMOVE
+static inline void *
+__memmove(void *dst, const void *src, size_t n) {
+    if (dst < src) {
+  80205a:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80205d:	3b 45 ec             	cmp    -0x14(%ebp),%eax
+  802060:	73 42                	jae    8020a4 <memmove+0x65>
+  802062:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802065:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  802068:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  80206b:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  80206e:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802071:	89 45 dc             	mov    %eax,-0x24(%ebp)
+        "andl $3, %%ecx;"
+        "jz 1f;"
+        "rep; movsb;"
+        "1:"
+        : "=&c" (d0), "=&D" (d1), "=&S" (d2)
+        : "0" (n / 4), "g" (n), "1" (dst), "2" (src)
+  802074:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  802077:	c1 e8 02             	shr    $0x2,%eax
+  80207a:	89 c1                	mov    %eax,%ecx
+    asm volatile (
+  80207c:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  80207f:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  802082:	89 d7                	mov    %edx,%edi
+  802084:	89 c6                	mov    %eax,%esi
+  802086:	f3 a5                	rep movsl %ds:(%esi),%es:(%edi)
+  802088:	8b 4d dc             	mov    -0x24(%ebp),%ecx
+  80208b:	83 e1 03             	and    $0x3,%ecx
+  80208e:	74 02                	je     802092 <memmove+0x53>
+  802090:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  802092:	89 f0                	mov    %esi,%eax
+  802094:	89 fa                	mov    %edi,%edx
+  802096:	89 4d d8             	mov    %ecx,-0x28(%ebp)
+  802099:	89 55 d4             	mov    %edx,-0x2c(%ebp)
+  80209c:	89 45 d0             	mov    %eax,-0x30(%ebp)
+        : "memory");
+    return dst;
+  80209f:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+        return __memcpy(dst, src, n);
+  8020a2:	eb 36                	jmp    8020da <memmove+0x9b>
+        : "0" (n), "1" (n - 1 + src), "2" (n - 1 + dst)
+  8020a4:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8020a7:	8d 50 ff             	lea    -0x1(%eax),%edx
+  8020aa:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8020ad:	01 c2                	add    %eax,%edx
+  8020af:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8020b2:	8d 48 ff             	lea    -0x1(%eax),%ecx
+  8020b5:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8020b8:	8d 1c 01             	lea    (%ecx,%eax,1),%ebx
+    asm volatile (
+  8020bb:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8020be:	89 c1                	mov    %eax,%ecx
+  8020c0:	89 d8                	mov    %ebx,%eax
+  8020c2:	89 d6                	mov    %edx,%esi
+  8020c4:	89 c7                	mov    %eax,%edi
+  8020c6:	fd                   	std
+  8020c7:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  8020c9:	fc                   	cld
+  8020ca:	89 f8                	mov    %edi,%eax
+  8020cc:	89 f2                	mov    %esi,%edx
+  8020ce:	89 4d cc             	mov    %ecx,-0x34(%ebp)
+  8020d1:	89 55 c8             	mov    %edx,-0x38(%ebp)
+  8020d4:	89 45 c4             	mov    %eax,-0x3c(%ebp)
+    return dst;
+  8020d7:	8b 45 f0             	mov    -0x10(%ebp),%eax
+            *d ++ = *s ++;
+        }
+    }
+    return dst;
+#endif /* __HAVE_ARCH_MEMMOVE */
+}
+  8020da:	83 c4 30             	add    $0x30,%esp
+  8020dd:	5b                   	pop    %ebx
+  8020de:	5e                   	pop    %esi
+  8020df:	5f                   	pop    %edi
+  8020e0:	5d                   	pop    %ebp
+  8020e1:	c3                   	ret
+
+008020e2 <memcpy>:
+ * it always copies exactly @n bytes. To avoid overflows, the size of arrays pointed
+ * by both @src and @dst, should be at least @n bytes, and should not overlap
+ * (for overlapping memory area, memmove is a safer approach).
+ * */
+void *
+memcpy(void *dst, const void *src, size_t n) {
+  8020e2:	55                   	push   %ebp
+  8020e3:	89 e5                	mov    %esp,%ebp
+  8020e5:	57                   	push   %edi
+  8020e6:	56                   	push   %esi
+  8020e7:	83 ec 20             	sub    $0x20,%esp
+  8020ea:	8b 45 08             	mov    0x8(%ebp),%eax
+  8020ed:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8020f0:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8020f3:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8020f6:	8b 45 10             	mov    0x10(%ebp),%eax
+  8020f9:	89 45 ec             	mov    %eax,-0x14(%ebp)
+        : "0" (n / 4), "g" (n), "1" (dst), "2" (src)
+  8020fc:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8020ff:	c1 e8 02             	shr    $0x2,%eax
+  802102:	89 c1                	mov    %eax,%ecx
+    asm volatile (
+  802104:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  802107:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80210a:	89 d7                	mov    %edx,%edi
+  80210c:	89 c6                	mov    %eax,%esi
+  80210e:	f3 a5                	rep movsl %ds:(%esi),%es:(%edi)
+  802110:	8b 4d ec             	mov    -0x14(%ebp),%ecx
+  802113:	83 e1 03             	and    $0x3,%ecx
+  802116:	74 02                	je     80211a <memcpy+0x38>
+  802118:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  80211a:	89 f0                	mov    %esi,%eax
+  80211c:	89 fa                	mov    %edi,%edx
+  80211e:	89 4d e8             	mov    %ecx,-0x18(%ebp)
+  802121:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  802124:	89 45 e0             	mov    %eax,-0x20(%ebp)
+    return dst;
+  802127:	8b 45 f4             	mov    -0xc(%ebp),%eax
+    while (n -- > 0) {
+        *d ++ = *s ++;
+    }
+    return dst;
+#endif /* __HAVE_ARCH_MEMCPY */
+}
+  80212a:	83 c4 20             	add    $0x20,%esp
+  80212d:	5e                   	pop    %esi
+  80212e:	5f                   	pop    %edi
+  80212f:	5d                   	pop    %ebp
+  802130:	c3                   	ret
+
+00802131 <memcmp>:
+ *   match in both memory blocks has a greater value in @v1 than in @v2
+ *   as if evaluated as unsigned char values;
+ * - And a value less than zero indicates the opposite.
+ * */
+int
+memcmp(const void *v1, const void *v2, size_t n) {
+  802131:	55                   	push   %ebp
+  802132:	89 e5                	mov    %esp,%ebp
+  802134:	83 ec 10             	sub    $0x10,%esp
+    const char *s1 = (const char *)v1;
+  802137:	8b 45 08             	mov    0x8(%ebp),%eax
+  80213a:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    const char *s2 = (const char *)v2;
+  80213d:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802140:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    while (n -- > 0) {
+  802143:	eb 2e                	jmp    802173 <memcmp+0x42>
+        if (*s1 != *s2) {
+  802145:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802148:	0f b6 10             	movzbl (%eax),%edx
+  80214b:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80214e:	0f b6 00             	movzbl (%eax),%eax
+  802151:	38 c2                	cmp    %al,%dl
+  802153:	74 16                	je     80216b <memcmp+0x3a>
+            return (int)((unsigned char)*s1 - (unsigned char)*s2);
+  802155:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802158:	0f b6 00             	movzbl (%eax),%eax
+  80215b:	0f b6 d0             	movzbl %al,%edx
+  80215e:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802161:	0f b6 00             	movzbl (%eax),%eax
+  802164:	0f b6 c0             	movzbl %al,%eax
+  802167:	29 c2                	sub    %eax,%edx
+  802169:	eb 1a                	jmp    802185 <memcmp+0x54>
+        }
+        s1 ++, s2 ++;
+  80216b:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+  80216f:	83 45 f8 01          	addl   $0x1,-0x8(%ebp)
+    while (n -- > 0) {
+  802173:	8b 45 10             	mov    0x10(%ebp),%eax
+  802176:	8d 50 ff             	lea    -0x1(%eax),%edx
+  802179:	89 55 10             	mov    %edx,0x10(%ebp)
+  80217c:	85 c0                	test   %eax,%eax
+  80217e:	75 c5                	jne    802145 <memcmp+0x14>
+    }
+    return 0;
+  802180:	ba 00 00 00 00       	mov    $0x0,%edx
+}
+  802185:	89 d0                	mov    %edx,%eax
+  802187:	c9                   	leave
+  802188:	c3                   	ret
+
+00802189 <main>:
+#include <ulib.h>
+
+int zero;
+
+int
+main(void) {
+  802189:	8d 4c 24 04          	lea    0x4(%esp),%ecx
+  80218d:	83 e4 f0             	and    $0xfffffff0,%esp
+  802190:	ff 71 fc             	push   -0x4(%ecx)
+  802193:	55                   	push   %ebp
+  802194:	89 e5                	mov    %esp,%ebp
+  802196:	51                   	push   %ecx
+  802197:	83 ec 04             	sub    $0x4,%esp
+    cprintf("value is %d.\n", 1 / zero);
+  80219a:	a1 bc 31 80 00       	mov    0x8031bc,%eax
+  80219f:	89 c2                	mov    %eax,%edx
+  8021a1:	83 c2 01             	add    $0x1,%edx
+  8021a4:	83 fa 02             	cmp    $0x2,%edx
+  8021a7:	0f 96 c2             	setbe  %dl
+  8021aa:	b9 00 00 00 00       	mov    $0x0,%ecx
+  8021af:	84 d2                	test   %dl,%dl
+  8021b1:	0f 44 c1             	cmove  %ecx,%eax
+  8021b4:	83 ec 08             	sub    $0x8,%esp
+  8021b7:	50                   	push   %eax
+  8021b8:	68 e0 26 80 00       	push   $0x8026e0
+  8021bd:	e8 42 ec ff ff       	call   800e04 <cprintf>
+  8021c2:	83 c4 10             	add    $0x10,%esp
+    panic("FAIL: T.T\n");
+  8021c5:	83 ec 04             	sub    $0x4,%esp
+  8021c8:	68 ee 26 80 00       	push   $0x8026ee
+  8021cd:	6a 09                	push   $0x9
+  8021cf:	68 f9 26 80 00       	push   $0x8026f9
+  8021d4:	e8 41 eb ff ff       	call   800d1a <__panic>
@@ -19,6 +19,7 @@ For example:
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <limits.h>
 #include <dirent.h>
 #include <unistd.h>
@@ -142,6 +143,29 @@ safe_fchdir(int fd) {
 #define SFS_BLKN_SUPER                          0
 #define SFS_BLKN_ROOT                           1
 #define SFS_BLKN_FREEMAP                        2
+#define SFS_INO_ROOT                            1
+
+#define SFS_VERSION_BLKINODE                    0                                       // one inode per block
+#define SFS_VERSION_PACKED                      1                                       // inodes in inode table
+#define SFS_VERSION_DIRPACK                     2                                       // and packed dir entries
+#define SFS_VERSION_EXTENT                      3                                       // and extent mapped blocks
+#define SFS_VERSION_INLINE                      4                                       // and tiny files in inode
+#define SFS_VERSION_JOURNAL                     5                                       // and metadata journal
+
+#define SFS_JOURNAL_MAGIC                       0x6c6e726a                              // "jrnl", header of journal
+#define SFS_JOURNAL_BLOCKS                      256                                     // # of blocks of journal
+#define SFS_DINODE_SIZE                         64                                      // size of inode in table
+#define SFS_BLK_NINODE                          (SFS_BLKSIZE / SFS_DINODE_SIZE)
+#define SFS_BLKS_PER_INODE                      2                                       // 1 inode per 8K
+
+struct sfs_extent {
+    uint32_t lblk;
+    uint32_t start;
+    uint32_t len;
+};
+
+#define SFS_NEXTENT                             4                                       // extents in inode
+#define SFS_BLK_NEXTENT                         (SFS_BLKSIZE / sizeof(struct sfs_extent))
 
 struct cache_block {
     uint32_t ino;
@@ -155,14 +179,31 @@ struct cache_inode {
         uint16_t type;
         uint16_t nlinks;
         uint32_t blocks;
-        uint32_t direct[SFS_NDIRECT];
-        uint32_t indirect;
+        union {
+            struct {
+                uint32_t direct[SFS_NDIRECT];
+                uint32_t indirect;
+            };
+            struct {
+                uint16_t nextents;
+                uint16_t depth;
+                struct sfs_extent extents[SFS_NEXTENT];
+            };
+            char inline_data[(SFS_NDIRECT + 1) * sizeof(uint32_t)];
+        };
         uint32_t db_indirect;
     } inode;
     ino_t real;
     uint32_t ino;
     uint32_t nblks;
     struct cache_block *l1, *l2;
+    struct cache_block *dirblk;
+    uint32_t dirpos, dirlast;
+    struct dir_entry {
+        uint32_t ino, hash;
+        char *name;
+    } *ents;
+    uint32_t nents, maxents;
     struct cache_inode *hash_next;
 };
 
@@ -172,6 +213,13 @@ struct sfs_fs {
         uint32_t blocks;
         uint32_t unused_blocks;
         char info[SFS_MAX_INFO_LEN + 1];
+        uint32_t version;
+        uint32_t ninodes;
+        uint32_t inode_start;
+        uint32_t inode_blocks;
+        uint32_t journal_start;
+        uint32_t journal_blocks;
+        uint32_t mounted;
     } super;
     struct subpath {
         struct subpath *next, *prev;
@@ -179,6 +227,7 @@ struct sfs_fs {
     } __sp_nil, *sp_root, *sp_end;
     int imgfd;
     uint32_t ninos, next_ino;
+    uint32_t next_inum;
     struct cache_inode *root;
     struct cache_inode *inodes[HASH_LIST_SIZE];
     struct cache_block *blocks[HASH_LIST_SIZE];
@@ -189,6 +238,39 @@ struct sfs_entry {
     char name[SFS_MAX_FNAME_LEN + 1];
 };
 
+struct sfs_dirent {
+    uint32_t ino;
+    uint16_t rec_len;
+    uint16_t name_len;
+    char name[0];
+};
+
+#define SFS_DIRENT_RECLEN(name_len)             ((sizeof(struct sfs_dirent) + (name_len) + 3) & ~3)
+
+#define SFS_DX_MAGIC                            0x78646673                              // "sfdx"
+
+struct sfs_dx_entry {
+    uint32_t hash;
+    uint32_t block;
+};
+
+struct sfs_dx_root {
+    uint32_t magic;
+    uint32_t nleaves;
+    struct sfs_dx_entry entries[0];
+};
+
+// 32-bit FNV-1a, the same as sfs_dx_hash in kernel
+static uint32_t
+sfs_dx_hash(const char *name) {
+    uint32_t hash = 2166136261U;
+    while (*name != '\0') {
+        hash ^= (uint8_t)(*name ++);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
 static uint32_t
 sfs_alloc_ino(struct sfs_fs *sfs) {
     if (sfs->next_ino < sfs->ninos) {
@@ -198,6 +280,18 @@ sfs_alloc_ino(struct sfs_fs *sfs) {
     bug("out of disk space.\n");
 }
 
+// sfs_alloc_inum - alloc an inode number, a slot of inode table or a whole block
+static uint32_t
+sfs_alloc_inum(struct sfs_fs *sfs) {
+    if (sfs->super.version < SFS_VERSION_PACKED) {
+        return sfs_alloc_ino(sfs);
+    }
+    if (sfs->next_inum < sfs->super.ninodes) {
+        return sfs->next_inum ++;
+    }
+    bug("out of inodes.\n");
+}
+
 static struct cache_block *
 alloc_cache_block(struct sfs_fs *sfs, uint32_t ino) {
     struct cache_block *cb = safe_malloc(sizeof(struct cache_block));
@@ -220,8 +314,10 @@ search_cache_block(struct sfs_fs *sfs, uint32_t ino) {
 static struct cache_inode *
 alloc_cache_inode(struct sfs_fs *sfs, ino_t real, uint32_t ino, uint16_t type) {
     struct cache_inode *ci = safe_malloc(sizeof(struct cache_inode));
-    ci->ino = (ino != 0) ? ino : sfs_alloc_ino(sfs);
+    ci->ino = (ino != 0) ? ino : sfs_alloc_inum(sfs);
     ci->real = real, ci->nblks = 0, ci->l1 = ci->l2 = NULL;
+    ci->dirblk = NULL, ci->dirpos = ci->dirlast = 0;
+    ci->ents = NULL, ci->nents = ci->maxents = 0;
     struct inode *inode = &(ci->inode);
     memset(inode, 0, sizeof(struct inode));
     inode->type = type;
@@ -240,8 +336,8 @@ search_cache_inode(struct sfs_fs *sfs, ino_t real) {
 }
 
 struct sfs_fs *
-create_sfs(int imgfd) {
-    uint32_t ninos, next_ino;
+create_sfs(int imgfd, uint32_t version) {
+    uint32_t ninos, next_ino, ninodes = 0, inode_blocks = 0, journal_blocks = 0;
     struct stat *stat = safe_fstat(imgfd);
     if ((ninos = stat->st_size / SFS_BLKSIZE) > SFS_MAX_NBLKS) {
         ninos = SFS_MAX_NBLKS;
@@ -252,11 +348,31 @@ create_sfs(int imgfd) {
         bug("img file is too small (%llu bytes, %u blocks, bitmap use at least %u blocks).\n",
                 (unsigned long long)stat->st_size, ninos, next_ino - 2);
     }
+    if (version >= SFS_VERSION_PACKED) {
+        inode_blocks = (ninos / SFS_BLKS_PER_INODE + SFS_BLK_NINODE - 1) / SFS_BLK_NINODE;
+        ninodes = inode_blocks * SFS_BLK_NINODE;
+        if (next_ino + inode_blocks >= ninos) {
+            bug("img file is too small (%u blocks, inode table use %u blocks).\n", ninos, inode_blocks);
+        }
+    }
+    if (version >= SFS_VERSION_JOURNAL) {
+        journal_blocks = SFS_JOURNAL_BLOCKS;
+        if (next_ino + inode_blocks + journal_blocks >= ninos) {
+            bug("img file is too small (%u blocks, journal use %u blocks).\n", ninos, journal_blocks);
+        }
+    }
 
     struct sfs_fs *sfs = safe_malloc(sizeof(struct sfs_fs));
     sfs->super.magic = SFS_MAGIC;
-    sfs->super.blocks = ninos, sfs->super.unused_blocks = ninos - next_ino;
+    sfs->super.blocks = ninos, sfs->super.unused_blocks = ninos - next_ino - inode_blocks - journal_blocks;
     snprintf(sfs->super.info, SFS_MAX_INFO_LEN, "simple file system");
+    sfs->super.version = version, sfs->super.ninodes = ninodes;
+    sfs->super.inode_start = (version >= SFS_VERSION_PACKED) ? next_ino : 0;
+    sfs->super.inode_blocks = inode_blocks;
+    sfs->super.journal_start = (version >= SFS_VERSION_JOURNAL) ? next_ino + inode_blocks : 0;
+    sfs->super.journal_blocks = journal_blocks, sfs->super.mounted = 0;
+    sfs->next_inum = SFS_INO_ROOT + 1;
+    next_ino += inode_blocks + journal_blocks;
 
     sfs->ninos = ninos, sfs->next_ino = next_ino, sfs->imgfd = imgfd;
     sfs->sp_root = sfs->sp_end = &(sfs->__sp_nil);
@@ -268,7 +384,7 @@ create_sfs(int imgfd) {
         sfs->blocks[i] = NULL;
     }
 
-    sfs->root = alloc_cache_inode(sfs, 0, SFS_BLKN_ROOT, SFS_TYPE_DIR);
+    sfs->root = alloc_cache_inode(sfs, 0, (version >= SFS_VERSION_PACKED) ? SFS_INO_ROOT : SFS_BLKN_ROOT, SFS_TYPE_DIR);
     return sfs;
 }
 
@@ -325,7 +441,20 @@ flush_cache_block(struct sfs_fs *sfs, struct cache_block *cb) {
 
 static void
 flush_cache_inode(struct sfs_fs *sfs, struct cache_inode *ci) {
-    write_block(sfs, &(ci->inode), sizeof(ci->inode), ci->ino);
+    if (sfs->super.version < SFS_VERSION_PACKED) {
+        write_block(sfs, &(ci->inode), sizeof(ci->inode), ci->ino);
+        return;
+    }
+    // the slot has no room for db_indirect, which isn't used by ucore either
+    if (ci->inode.db_indirect != 0) {
+        bug("file is too big for packed inode %u.\n", ci->ino);
+    }
+    off_t offset = (off_t)(sfs->super.inode_start + ci->ino / SFS_BLK_NINODE) * SFS_BLKSIZE;
+    offset += (ci->ino % SFS_BLK_NINODE) * SFS_DINODE_SIZE;
+    ssize_t ret;
+    if ((ret = pwrite(sfs->imgfd, &(ci->inode), SFS_DINODE_SIZE, offset)) != SFS_DINODE_SIZE) {
+        bug("write inode %u failed: (%d/%d).\n", ci->ino, (int)ret, SFS_DINODE_SIZE);
+    }
 }
 
 void
@@ -353,6 +482,19 @@ close_sfs(struct sfs_fs *sfs) {
     }
     write_block(sfs, &(sfs->super), sizeof(sfs->super), SFS_BLKN_SUPER);
 
+    memset(buffer, 0, sizeof(buffer));
+    for (i = 0; i < sfs->super.inode_blocks; i ++) {
+        write_block(sfs, buffer, sizeof(buffer), sfs->super.inode_start + i);
+    }
+    for (i = 1; i < sfs->super.journal_blocks; i ++) {
+        write_block(sfs, buffer, sizeof(buffer), sfs->super.journal_start + i);
+    }
+    if (sfs->super.journal_blocks != 0) {
+        // header of the empty journal: magic, then seq of the 1st transaction
+        uint32_t header[2] = {SFS_JOURNAL_MAGIC, 1};
+        write_block(sfs, header, sizeof(header), sfs->super.journal_start);
+    }
+
     for (i = 0; i < HASH_LIST_SIZE; i ++) {
         struct cache_block *cb = sfs->blocks[i];
         while (cb != NULL) {
@@ -368,7 +510,7 @@ close_sfs(struct sfs_fs *sfs) {
 }
 
 struct sfs_fs *
-open_img(const char *imgname) {
+open_img(const char *imgname, uint32_t version) {
     const char *expect = ".img", *ext = imgname + strlen(imgname) - strlen(expect);
     if (ext <= imgname || strcmp(ext, expect) != 0) {
         bug("invalid .img file name '%s'.\n", imgname);
@@ -377,7 +519,7 @@ open_img(const char *imgname) {
     if ((imgfd = open(imgname, O_WRONLY)) < 0) {
         bug("open '%s' failed.\n", imgname);
     }
-    return create_sfs(imgfd);
+    return create_sfs(imgfd, version);
 }
 
 #define open_bug(sfs, name, ...)                                                        \
@@ -413,6 +555,55 @@ update_cache(struct sfs_fs *sfs, struct cache_block **cbp, uint32_t *inop) {
     *cbp = cb, *inop = ino;
 }
 
+/*
+ * append_extent - map block ino as the next block of file (SFS_VERSION_EXTENT), grow the last
+ * extent if ino follows it, or add a new extent. file->l1 is the last leaf block if depth is 1.
+ */
+static void
+append_extent(struct sfs_fs *sfs, struct cache_inode *file, uint32_t ino, const char *filename) {
+    struct inode *inode = &(file->inode);
+    struct sfs_extent *root = inode->extents, *leaf, ext = {file->nblks, ino, 1};
+    uint32_t n = inode->nextents;
+    if (n != 0) {
+        struct sfs_extent *last = root + n - 1;
+        if (inode->depth != 0) {
+            last = (struct sfs_extent *)file->l1->cache + last->len - 1;
+        }
+        if (last->start + last->len == ino) {
+            last->len ++;
+            return;
+        }
+    }
+    if (inode->depth == 0 && n < SFS_NEXTENT) {
+        root[inode->nextents ++] = ext;
+        return;
+    }
+    if (inode->depth == 0) {
+        // move the extents of inode into a leaf
+        file->l1 = alloc_cache_block(sfs, 0);
+        leaf = file->l1->cache;
+        memcpy(leaf, root, sizeof(struct sfs_extent) * n);
+        leaf[n] = ext;
+        memset(root, 0, sizeof(struct sfs_extent) * SFS_NEXTENT);
+        root[0].lblk = 0, root[0].start = file->l1->ino, root[0].len = n + 1;
+        inode->nextents = 1, inode->depth = 1;
+        return;
+    }
+    if (root[n - 1].len < SFS_BLK_NEXTENT) {
+        leaf = file->l1->cache;
+        leaf[root[n - 1].len ++] = ext;
+        return;
+    }
+    if (n == SFS_NEXTENT) {
+        open_bug(sfs, filename, "file is too fragmented.\n");
+    }
+    file->l1 = alloc_cache_block(sfs, 0);
+    leaf = file->l1->cache;
+    leaf[0] = ext;
+    root[n].lblk = ext.lblk, root[n].start = file->l1->ino, root[n].len = 1;
+    inode->nextents ++;
+}
+
 static void
 append_block(struct sfs_fs *sfs, struct cache_inode *file, size_t size, uint32_t ino, const char *filename) {
     static_assert(SFS_LN_NBLKS <= SFS_L2_NBLKS, "SFS_LN_NBLKS <= SFS_L2_NBLKS");
@@ -422,7 +613,10 @@ append_block(struct sfs_fs *sfs, struct cache_inode *file, size_t size, uint32_t
     if (nblks >= SFS_LN_NBLKS) {
         open_bug(sfs, filename, "file is too big.\n");
     }
-    if (nblks < SFS_L0_NBLKS) {
+    if (sfs->super.version >= SFS_VERSION_EXTENT) {
+        append_extent(sfs, file, ino, filename);
+    }
+    else if (nblks < SFS_L0_NBLKS) {
         inode->direct[nblks] = ino;
     }
     else if (nblks < SFS_L1_NBLKS) {
@@ -444,10 +638,125 @@ append_block(struct sfs_fs *sfs, struct cache_inode *file, size_t size, uint32_t
     inode->blocks ++;
 }
 
+/*
+ * add_dirent - append a record to the last dir block, or to a new block if newblk is set or
+ * there isn't enough room. the last record of a block always covers the rest of the block.
+ */
+static void
+add_dirent(struct sfs_fs *sfs, struct cache_inode *current, uint32_t ino, const char *name, int newblk) {
+    struct sfs_dirent *rec;
+    size_t name_len = strlen(name), rec_len = SFS_DIRENT_RECLEN(name_len);
+    if (newblk || current->dirblk == NULL || current->dirpos + rec_len > SFS_BLKSIZE) {
+        current->dirblk = alloc_cache_block(sfs, 0);
+        current->dirpos = current->dirlast = 0;
+        append_block(sfs, current, SFS_BLKSIZE, current->dirblk->ino, name);
+    }
+    else {
+        rec = (struct sfs_dirent *)((char *)current->dirblk->cache + current->dirlast);
+        rec->rec_len = current->dirpos - current->dirlast;
+    }
+    rec = (struct sfs_dirent *)((char *)current->dirblk->cache + current->dirpos);
+    rec->ino = ino, rec->rec_len = SFS_BLKSIZE - current->dirpos, rec->name_len = name_len;
+    memcpy(rec->name, name, name_len);
+    current->dirlast = current->dirpos, current->dirpos += rec_len;
+}
+
+static int
+dir_entry_cmp(const void *a, const void *b) {
+    const struct dir_entry *ea = a, *eb = b;
+    if (ea->hash != eb->hash) {
+        return (ea->hash < eb->hash) ? -1 : 1;
+    }
+    return strcmp(ea->name, eb->name);
+}
+
+/*
+ * flush_dirents - write the entries of a dir collected by add_entry. if they don't fit in one
+ * block, entries (but "." and "..") are sorted by hash and cut into leaf blocks, and a hashed
+ * index (struct sfs_dx_root) pointing to the leaves is put in block 0 after "..".
+ */
+static void
+flush_dirents(struct sfs_fs *sfs, struct cache_inode *current) {
+    struct dir_entry *ents = current->ents;
+    uint32_t i, k, n = current->nents, size = 0, nleaves = 0;
+    assert(n >= 2 && strcmp(ents[0].name, ".") == 0 && strcmp(ents[1].name, "..") == 0);
+    for (i = 0; i < n; i ++) {
+        size += SFS_DIRENT_RECLEN(strlen(ents[i].name));
+    }
+
+    const uint32_t root_off = SFS_DIRENT_RECLEN(1) + SFS_DIRENT_RECLEN(2);
+    const uint32_t max_leaves = (SFS_BLKSIZE - root_off - sizeof(struct sfs_dx_root)) / sizeof(struct sfs_dx_entry);
+    uint32_t *first = safe_malloc(sizeof(uint32_t) * (n + 1));
+    if (size > SFS_BLKSIZE) {
+        qsort(ents + 2, n - 2, sizeof(struct dir_entry), dir_entry_cmp);
+        uint32_t used = SFS_BLKSIZE;
+        for (i = 2; i < n; i ++) {
+            if (used + SFS_DIRENT_RECLEN(strlen(ents[i].name)) > SFS_BLKSIZE) {
+                // names with the same hash must be in the same leaf
+                uint32_t start = i;
+                if (nleaves > 0) {
+                    while (start > first[nleaves - 1] && ents[start - 1].hash == ents[i].hash) {
+                        start --;
+                    }
+                    if (start == first[nleaves - 1]) {
+                        open_bug(sfs, ents[i].name, "too many names with the same hash.\n");
+                    }
+                }
+                first[nleaves ++] = i = start, used = 0;
+            }
+            used += SFS_DIRENT_RECLEN(strlen(ents[i].name));
+        }
+        if (nleaves > max_leaves) {
+            show_fullpath(sfs, NULL);
+            warn("too many entries (%u) to index, use linear dir.\n", n);
+            nleaves = 0;
+        }
+    }
+
+    if (nleaves == 0) {
+        for (i = 0; i < n; i ++) {
+            add_dirent(sfs, current, ents[i].ino, ents[i].name, 0);
+        }
+    }
+    else {
+        add_dirent(sfs, current, ents[0].ino, ents[0].name, 1);
+        add_dirent(sfs, current, ents[1].ino, ents[1].name, 0);
+        assert(current->dirpos == root_off);
+        struct sfs_dx_root *root = (struct sfs_dx_root *)((char *)current->dirblk->cache + root_off);
+        root->magic = SFS_DX_MAGIC, root->nleaves = nleaves;
+        first[nleaves] = n;
+        for (k = 0; k < nleaves; k ++) {
+            root->entries[k].hash = (k == 0) ? 0 : ents[first[k]].hash;
+            root->entries[k].block = k + 1;
+            for (i = first[k]; i < first[k + 1]; i ++) {
+                add_dirent(sfs, current, ents[i].ino, ents[i].name, i == first[k]);
+            }
+        }
+    }
+
+    for (i = 0; i < n; i ++) {
+        free(ents[i].name);
+    }
+    free(first), free(ents);
+    current->ents = NULL, current->nents = current->maxents = 0;
+}
+
 static void
 add_entry(struct sfs_fs *sfs, struct cache_inode *current, struct cache_inode *file, const char *name) {
     static struct sfs_entry __entry, *entry = &__entry;
     assert(current->inode.type == SFS_TYPE_DIR && strlen(name) <= SFS_MAX_FNAME_LEN);
+    if (sfs->super.version >= SFS_VERSION_DIRPACK) {
+        if (current->nents == current->maxents) {
+            current->maxents = (current->maxents == 0) ? 16 : current->maxents * 2;
+            if ((current->ents = realloc(current->ents, sizeof(struct dir_entry) * current->maxents)) == NULL) {
+                bug("realloc %u entries failed.\n", current->maxents);
+            }
+        }
+        struct dir_entry *ent = current->ents + current->nents ++;
+        ent->ino = file->ino, ent->hash = sfs_dx_hash(name), ent->name = safe_strdup(name);
+        file->inode.nlinks ++;
+        return;
+    }
     entry->ino = file->ino, strcpy(entry->name, name);
     uint32_t entry_ino = sfs_alloc_ino(sfs);
     write_block(sfs, entry, sizeof(struct sfs_entry), entry_ino);
@@ -530,12 +839,24 @@ open_dir(struct sfs_fs *sfs, struct cache_inode *current, struct cache_inode *pa
         }
     }
     closedir(dir);
+    if (sfs->super.version >= SFS_VERSION_DIRPACK) {
+        flush_dirents(sfs, current);
+    }
 }
 
 void
 open_file(struct sfs_fs *sfs, struct cache_inode *file, const char *filename, int fd) {
     static char buffer[SFS_BLKSIZE];
     ssize_t ret, last = SFS_BLKSIZE;
+    // a tiny file is kept in its inode, with no blocks
+    struct inode *inode = &(file->inode);
+    if (sfs->super.version >= SFS_VERSION_INLINE && safe_fstat(fd)->st_size <= sizeof(inode->inline_data)) {
+        if ((ret = read(fd, inode->inline_data, sizeof(inode->inline_data))) < 0) {
+            open_bug(sfs, filename, "read file failed.\n");
+        }
+        inode->size = ret;
+        return;
+    }
     while ((ret = read(fd, buffer, sizeof(buffer))) != 0) {
         assert(last == SFS_BLKSIZE);
         uint32_t ino = sfs_alloc_ino(sfs);
@@ -593,16 +914,33 @@ static_check(void) {
 #endif
     static_assert(SFS_MAX_NBLKS <= 0x80000000UL, "SFS_MAX_NBLKS <= 0x80000000UL");
     static_assert(SFS_MAX_FILE_SIZE <= 0x80000000UL,"SFS_MAX_FILE_SIZE <= 0x80000000UL");
+    static_assert(offsetof(struct inode, db_indirect) == SFS_DINODE_SIZE, "offsetof db_indirect == SFS_DINODE_SIZE");
 }
 
 int
 main(int argc, char **argv) {
     static_check();
+    uint32_t version = SFS_VERSION_JOURNAL;
+    if (argc == 4 && strcmp(argv[1], "-v0") == 0) {
+        version = SFS_VERSION_BLKINODE, argc --, argv ++;
+    }
+    else if (argc == 4 && strcmp(argv[1], "-v1") == 0) {
+        version = SFS_VERSION_PACKED, argc --, argv ++;
+    }
+    else if (argc == 4 && strcmp(argv[1], "-v2") == 0) {
+        version = SFS_VERSION_DIRPACK, argc --, argv ++;
+    }
+    else if (argc == 4 && strcmp(argv[1], "-v3") == 0) {
+        version = SFS_VERSION_EXTENT, argc --, argv ++;
+    }
+    else if (argc == 4 && strcmp(argv[1], "-v4") == 0) {
+        version = SFS_VERSION_INLINE, argc --, argv ++;
+    }
     if (argc != 3) {
-        bug("usage: <input *.img> <input dirname>\n");
+        bug("usage: [-v0|-v1|-v2|-v3|-v4] <input *.img> <input dirname>\n");
     }
     const char *imgname = argv[1], *home = argv[2];
-    if (create_img(open_img(imgname), home) != 0) {
+    if (create_img(open_img(imgname, version), home) != 0) {
         bug("create img failed.\n");
     }
     printf("create %s (%s) successfully.\n", imgname, home);
@@ -0,0 +1,76 @@
+#include <ulib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <dir.h>
+#include <file.h>
+#include <unistd.h>
+
+#define NLOOKUP         10000
+#define MAXNAMES        10000
+#define BENCHDIR        "dirbench.d"
+
+static char *names[MAXNAMES];
+static char pathbuf[FS_MAX_FPATH_LEN + 1];
+
+// lookup - open and close dir/name, return 0 if it exists
+static int
+lookup(const char *dir, const char *name) {
+    int fd;
+    snprintf(pathbuf, sizeof(pathbuf), "%s/%s", dir, name);
+    if ((fd = open(pathbuf, O_RDONLY)) < 0) {
+        return fd;
+    }
+    close(fd);
+    return 0;
+}
+
+static void
+report(const char *what, int n, unsigned int msec) {
+    cprintf("dirbench: %d %s lookups in %d msec, %d lookups/sec.\n", n, what, msec,
+            (msec == 0) ? 0 : n * 1000 / (int)msec);
+}
+
+/*
+ * looks up NLOOKUP names which exist and NLOOKUP names which don't in a dir,
+ * BENCHDIR by default. the Makefile puts DIRBENCH_NENTRY empty files into
+ * disk0/BENCHDIR, and mksfs builds the hashed index for it.
+ */
+int
+main(int argc, char **argv) {
+    const char *dir = (argc > 1) ? argv[1] : BENCHDIR;
+    DIR *dirp;
+    if ((dirp = opendir(dir)) == NULL) {
+        cprintf("dirbench: open %s failed.\n", dir);
+        return -1;
+    }
+
+    int i, n = 0;
+    struct dirent *direntp;
+    while (n < MAXNAMES && (direntp = readdir(dirp)) != NULL) {
+        assert((names[n] = malloc(strlen(direntp->name) + 1)) != NULL);
+        strcpy(names[n ++], direntp->name);
+    }
+    closedir(dirp);
+    cprintf("dirbench: %s, lookup %d names.\n", dir, n);
+
+    unsigned int begin = gettime_msec();
+    for (i = 0; i < NLOOKUP; i ++) {
+        assert(lookup(dir, names[i % n]) == 0);
+    }
+    report("positive", NLOOKUP, gettime_msec() - begin);
+
+    char name[32];
+    begin = gettime_msec();
+    for (i = 0; i < NLOOKUP; i ++) {
+        snprintf(name, sizeof(name), "nonexistent.%d", i);
+        assert(lookup(dir, name) != 0);
+    }
+    report("negative", NLOOKUP, gettime_msec() - begin);
+
+    for (i = 0; i < n; i ++) {
+        free(names[i]);
+    }
+    cprintf("dirbench pass.\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <string.h>
+#include <ulib.h>
+#include <file.h>
+#include <stat.h>
+#include <unistd.h>
+
+#define BLKSIZE         4096
+#define BUFSIZE         (BLKSIZE * 2)
+
+static char buf[BUFSIZE], rbuf[BUFSIZE], zero[BUFSIZE];
+
+static size_t
+file_size(int fd) {
+    struct stat __stat, *stat = &__stat;
+    assert(fstat(fd, stat) == 0);
+    return stat->st_size;
+}
+
+// check_zero - the file reads 0 in [pos, pos + len)
+static void
+check_zero(int fd, off_t pos, size_t len) {
+    while (len > 0) {
+        size_t n = (len < BUFSIZE) ? len : BUFSIZE;
+        memset(rbuf, 0xFF, n);
+        assert(pread(fd, rbuf, n, pos) == n && memcmp(rbuf, zero, n) == 0);
+        pos += n, len -= n;
+    }
+}
+
+int
+main(void) {
+    int i, fd;
+    for (i = 0; i < BUFSIZE; i ++) {
+        buf[i] = (char)(i * 7 + 1);
+    }
+    assert((fd = open("holetest.tmp", O_RDWR | O_TRUNC)) >= 0);
+
+    // blocks 1 ~ 4 are never written, and read as 0
+    assert(pwrite(fd, buf, BLKSIZE, 0) == BLKSIZE);
+    assert(pwrite(fd, buf, 100, BLKSIZE * 5 + 10) == 100);
+    assert(file_size(fd) == BLKSIZE * 5 + 110);
+    check_zero(fd, BLKSIZE, BLKSIZE * 4 + 10);
+    assert(pread(fd, rbuf, BLKSIZE, 0) == BLKSIZE && memcmp(rbuf, buf, BLKSIZE) == 0);
+    assert(pread(fd, rbuf, BUFSIZE, BLKSIZE * 5 + 10) == 100 && memcmp(rbuf, buf, 100) == 0);
+    assert(seek(fd, BLKSIZE - 10, LSEEK_SET) == 0);
+    assert(read(fd, rbuf, 20) == 20 && memcmp(rbuf, buf + BLKSIZE - 10, 10) == 0 && memcmp(rbuf + 10, zero, 10) == 0);
+    cprintf("hole pass.\n");
+
+    // fallocate inside the file fills the hole with 0 blocks, the size is not changed
+    assert(fallocate(fd, BLKSIZE * 2, BLKSIZE) == 0);
+    assert(file_size(fd) == BLKSIZE * 5 + 110);
+    check_zero(fd, BLKSIZE, BLKSIZE * 4 + 10);
+
+    // a write across the end of the allocated block goes on into the hole
+    assert(pwrite(fd, buf, 100, BLKSIZE * 3 - 50) == 100);
+    check_zero(fd, BLKSIZE, BLKSIZE * 2 - 50);
+    assert(pread(fd, rbuf, 100, BLKSIZE * 3 - 50) == 100 && memcmp(rbuf, buf, 100) == 0);
+    check_zero(fd, BLKSIZE * 3 + 50, BLKSIZE * 2 - 40);
+
+    // fallocate beyond the end extends the file, the new part reads 0
+    size_t size = file_size(fd);
+    assert(fallocate(fd, size + BLKSIZE, BLKSIZE * 2 + 5) == 0);
+    assert(file_size(fd) == size + BLKSIZE * 3 + 5);
+    check_zero(fd, size, BLKSIZE * 3 + 5);
+    assert(pread(fd, rbuf, BUFSIZE, size + BLKSIZE * 3 + 5) == 0);
+    assert(fallocate(fd, -1, BLKSIZE) < 0 && fallocate(fd, 0, 0) < 0);
+    cprintf("fallocate pass.\n");
+
+    // all of it is still there when the file is opened again
+    close(fd);
+    assert((fd = open("holetest.tmp", O_RDONLY)) >= 0);
+    assert(file_size(fd) == size + BLKSIZE * 3 + 5);
+    assert(pread(fd, rbuf, BLKSIZE, 0) == BLKSIZE && memcmp(rbuf, buf, BLKSIZE) == 0);
+    check_zero(fd, BLKSIZE, BLKSIZE * 2 - 50);
+    assert(pread(fd, rbuf, 100, BLKSIZE * 3 - 50) == 100 && memcmp(rbuf, buf, 100) == 0);
+    check_zero(fd, BLKSIZE * 3 + 50, BLKSIZE * 2 - 40);
+    assert(pread(fd, rbuf, 100, BLKSIZE * 5 + 10) == 100 && memcmp(rbuf, buf, 100) == 0);
+    check_zero(fd, size, BLKSIZE * 3 + 5);
+    close(fd);
+    cprintf("holetest pass.\n");
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include <stdio.h>
+#include <string.h>
+#include <ulib.h>
+#include <file.h>
+#include <uio.h>
+#include <unistd.h>
+
+#define BUFSIZE         10000
+
+static char buf[BUFSIZE], rbuf[BUFSIZE];
+
+int
+main(void) {
+    int i, fd;
+    for (i = 0; i < BUFSIZE; i ++) {
+        buf[i] = (char)(i * 7 + 1);
+    }
+    assert((fd = open("iotest.tmp", O_RDWR | O_TRUNC)) >= 0);
+
+    // pwrite/pread don't move the file position
+    assert(pwrite(fd, buf + 5000, 5000, 5000) == 5000);
+    assert(pwrite(fd, buf, 5000, 0) == 5000);
+    assert(pread(fd, rbuf, BUFSIZE, 0) == BUFSIZE && memcmp(rbuf, buf, BUFSIZE) == 0);
+    assert(pread(fd, rbuf, 100, 9950) == 50 && memcmp(rbuf, buf + 9950, 50) == 0);
+    assert(pread(fd, rbuf, 100, -1) < 0);
+    assert(read(fd, rbuf, 3) == 3 && memcmp(rbuf, buf, 3) == 0);
+    cprintf("pread/pwrite pass.\n");
+
+    // segments are transferred in order, empty ones are skipped
+    struct iovec iov[3] = {{buf + 3, 4093}, {buf, 0}, {buf + 4096, 5904}};
+    assert(writev(fd, iov, 3) == BUFSIZE - 3);
+    assert(seek(fd, 0, LSEEK_SET) == 0);
+    memset(rbuf, 0, sizeof(rbuf));
+    iov[0].iov_base = rbuf, iov[0].iov_len = 1;
+    iov[1].iov_base = rbuf + 1, iov[1].iov_len = 6000;
+    iov[2].iov_base = rbuf + 6001, iov[2].iov_len = BUFSIZE - 6001;
+    assert(readv(fd, iov, 3) == BUFSIZE && memcmp(rbuf, buf, BUFSIZE) == 0);
+    assert(readv(fd, iov, 3) == 0 && readv(fd, iov, UIO_MAXIOV + 1) < 0);
+    close(fd);
+    cprintf("iotest pass.\n");
+    return 0;
+}
@@ -26,6 +26,26 @@ write(int fd, void *base, size_t len) {
     return sys_write(fd, base, len);
 }
 
+int
+pread(int fd, void *base, size_t len, off_t pos) {
+    return sys_pread(fd, base, len, pos);
+}
+
+int
+pwrite(int fd, void *base, size_t len, off_t pos) {
+    return sys_pwrite(fd, base, len, pos);
+}
+
+int
+readv(int fd, struct iovec *iov, int iovcnt) {
+    return sys_readv(fd, iov, iovcnt);
+}
+
+int
+writev(int fd, struct iovec *iov, int iovcnt) {
+    return sys_writev(fd, iov, iovcnt);
+}
+
 int
 seek(int fd, off_t pos, int whence) {
     return sys_seek(fd, pos, whence);
@@ -41,6 +61,11 @@ fsync(int fd) {
     return sys_fsync(fd);
 }
 
+int
+fallocate(int fd, off_t pos, off_t len) {
+    return sys_fallocate(fd, pos, len);
+}
+
 int
 dup2(int fd1, int fd2) {
     return sys_dup(fd1, fd2);
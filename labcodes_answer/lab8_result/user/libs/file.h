@@ -4,14 +4,20 @@
 #include <defs.h>
 
 struct stat;
+struct iovec;
 
 int open(const char *path, uint32_t open_flags);
 int close(int fd);
 int read(int fd, void *base, size_t len);
 int write(int fd, void *base, size_t len);
+int pread(int fd, void *base, size_t len, off_t pos);
+int pwrite(int fd, void *base, size_t len, off_t pos);
+int readv(int fd, struct iovec *iov, int iovcnt);
+int writev(int fd, struct iovec *iov, int iovcnt);
 int seek(int fd, off_t pos, int whence);
 int fstat(int fd, struct stat *stat);
 int fsync(int fd);
+int fallocate(int fd, off_t pos, off_t len);
 int dup(int fd);
 int dup2(int fd1, int fd2);
 int pipe(int *fd_store);
@@ -0,0 +1,328 @@
+#include <defs.h>
+#include <list.h>
+#include <string.h>
+#include <unistd.h>
+#include <ulib.h>
+#include <lock.h>
+
+/* malloc/free for user programs, memory comes from three places:
+ *  - small objects (<= SMALL_MAX bytes) are served from per size-class bins.
+ *    A bin is a singly linked list of free objects of the same size, refilled
+ *    by carving a run of SMALL_RUN bytes taken from the heap. Objects in a run
+ *    never go back to the heap, they are reused by the same size class.
+ *  - medium objects come from the heap grown by sbrk. Blocks of the heap have
+ *    a boundary tag (header and footer word), free blocks are kept in a list
+ *    (first fit) and merged with free neighbours when they are freed.
+ *  - large objects (>= LARGE_MIN bytes) are mapped by mmap directly, and are
+ *    given back to the kernel by munmap when they are freed.
+ *
+ * The word just before every pointer returned by malloc tells where it comes
+ * from: a heap block stores its size | HEAP_ALLOC, a small object stores its
+ * class << 3 | SMALL_OBJ, a large one stores its mapped length | LARGE_OBJ.
+ * All pointers are aligned to ALIGN (8) bytes.
+ */
+
+#define PGSIZE          4096
+#define ALIGN           8
+
+#define HEAP_ALLOC      0x1             // heap block in use
+#define SMALL_OBJ       0x2             // object of a size-class bin
+#define LARGE_OBJ       0x4             // object mapped by mmap
+#define FLAG_MASK       (ALIGN - 1)
+
+#define SMALL_MAX       2048
+#define SMALL_RUN       (4 * PGSIZE)
+#define LARGE_MIN       (64 * 1024)
+#define HEAP_CHUNK      (16 * PGSIZE)
+
+// the smallest heap block: header + free list link + footer
+#define HEAP_MIN_BLOCK  (sizeof(size_t) * 2 + sizeof(list_entry_t))
+
+#define TAG(bp)         (*((size_t *)(bp) - 1))
+#define SIZE(tag)       ((tag) & ~FLAG_MASK)
+
+// for heap blocks: header/footer of a block & the blocks around it
+#define HDR(bp)         TAG(bp)
+#define FTR(bp)         (*(size_t *)((char *)(bp) + SIZE(HDR(bp)) - 2 * sizeof(size_t)))
+#define NEXT_BLK(bp)    ((char *)(bp) + SIZE(HDR(bp)))
+#define PREV_BLK(bp)    ((char *)(bp) - SIZE(*((size_t *)(bp) - 2)))
+
+#define le2blk(le)      ((void *)(le))
+#define blk2le(bp)      ((list_entry_t *)(bp))
+
+static const size_t class_size[] = {
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048,
+};
+
+#define NR_CLASS        (sizeof(class_size) / sizeof(class_size[0]))
+
+struct bin {
+    void *free_list;                    // free objects, linked by their first word
+    size_t nr_free;                     // # of objects in free_list
+};
+
+static struct bin bins[NR_CLASS];
+static list_entry_t heap_free_list = {&heap_free_list, &heap_free_list};
+static char *heap_end;                  // end of the last heap region, right after its epilogue
+static lock_t malloc_lock = INIT_LOCK;
+
+static inline int
+size2class(size_t size) {
+    int cls = 0;
+    while (class_size[cls] < size) {
+        cls ++;
+    }
+    return cls;
+}
+
+/* *
+ * heap_coalesce - merge the free block bp with its free neighbours, and put
+ * the result in the free list
+ * */
+static void *
+heap_coalesce(void *bp) {
+    size_t size = SIZE(HDR(bp));
+    void *next = NEXT_BLK(bp);
+    if (!(HDR(next) & HEAP_ALLOC)) {
+        list_del(blk2le(next));
+        size += SIZE(HDR(next));
+    }
+    if (!(*((size_t *)bp - 2) & HEAP_ALLOC)) {
+        void *prev = PREV_BLK(bp);
+        list_del(blk2le(prev));
+        size += SIZE(HDR(prev));
+        bp = prev;
+    }
+    HDR(bp) = size;
+    FTR(bp) = size;
+    list_add(&heap_free_list, blk2le(bp));
+    return bp;
+}
+
+/* *
+ * heap_extend - get at least size bytes from the kernel by sbrk, if the new memory
+ * follows the last region, the old epilogue becomes the header of the new block.
+ * otherwise a new region is made as: [pad][prologue hdr|ftr][block ...][epilogue]
+ * */
+static void *
+heap_extend(size_t size) {
+    size_t len = ROUNDUP(size + 4 * sizeof(size_t), HEAP_CHUNK);
+    char *p = sbrk(len), *bp;
+    if (p == (void *)-1) {
+        return NULL;
+    }
+    if (p == heap_end) {
+        bp = p, size = len;
+    }
+    else {
+        *(size_t *)(p + sizeof(size_t)) = (2 * sizeof(size_t)) | HEAP_ALLOC;
+        *(size_t *)(p + 2 * sizeof(size_t)) = (2 * sizeof(size_t)) | HEAP_ALLOC;
+        bp = p + 4 * sizeof(size_t), size = len - 4 * sizeof(size_t);
+    }
+    HDR(bp) = size;
+    FTR(bp) = size;
+    HDR(NEXT_BLK(bp)) = 0 | HEAP_ALLOC;
+    heap_end = p + len;
+    return heap_coalesce(bp);
+}
+
+/* *
+ * heap_alloc - alloc a block with at least size bytes payload from the free list
+ * (first fit), split the block if the rest is large enough to be a block.
+ * */
+static void *
+heap_alloc(size_t size) {
+    size_t asize = ROUNDUP(size + 2 * sizeof(size_t), ALIGN);
+    if (asize < HEAP_MIN_BLOCK) {
+        asize = HEAP_MIN_BLOCK;
+    }
+
+    void *bp = NULL;
+    list_entry_t *le = &heap_free_list;
+    while ((le = list_next(le)) != &heap_free_list) {
+        if (SIZE(HDR(le2blk(le))) >= asize) {
+            bp = le2blk(le);
+            break;
+        }
+    }
+    if (bp == NULL && (bp = heap_extend(asize)) == NULL) {
+        return NULL;
+    }
+
+    list_del(blk2le(bp));
+    size_t bsize = SIZE(HDR(bp));
+    if (bsize - asize >= HEAP_MIN_BLOCK) {
+        HDR(bp) = asize | HEAP_ALLOC;
+        FTR(bp) = asize | HEAP_ALLOC;
+        void *rest = NEXT_BLK(bp);
+        HDR(rest) = bsize - asize;
+        FTR(rest) = bsize - asize;
+        list_add(&heap_free_list, blk2le(rest));
+    }
+    else {
+        HDR(bp) = bsize | HEAP_ALLOC;
+        FTR(bp) = bsize | HEAP_ALLOC;
+    }
+    return bp;
+}
+
+static void
+heap_free(void *bp) {
+    size_t size = SIZE(HDR(bp));
+    HDR(bp) = size;
+    FTR(bp) = size;
+    heap_coalesce(bp);
+}
+
+/* *
+ * bin_refill - carve a run from the heap into objects of class cls. every object
+ * has its own tag word, so objects are laid out with a stride of size + ALIGN.
+ * */
+static bool
+bin_refill(int cls) {
+    size_t stride = class_size[cls] + ALIGN;
+    char *run;
+    if ((run = heap_alloc(SMALL_RUN)) == NULL) {
+        return 0;
+    }
+    struct bin *bin = bins + cls;
+    size_t i, n = SMALL_RUN / stride;
+    for (i = 0; i < n; i ++) {
+        void *obj = run + i * stride + ALIGN;
+        TAG(obj) = (cls << 3) | SMALL_OBJ;
+        *(void **)obj = bin->free_list;
+        bin->free_list = obj;
+    }
+    bin->nr_free += n;
+    return 1;
+}
+
+static void *
+small_alloc(size_t size) {
+    int cls = size2class(size);
+    struct bin *bin = bins + cls;
+    if (bin->free_list == NULL && !bin_refill(cls)) {
+        return NULL;
+    }
+    void *obj = bin->free_list;
+    bin->free_list = *(void **)obj;
+    bin->nr_free --;
+    return obj;
+}
+
+static void
+small_free(void *obj) {
+    struct bin *bin = bins + (TAG(obj) >> 3);
+    *(void **)obj = bin->free_list;
+    bin->free_list = obj;
+    bin->nr_free ++;
+}
+
+static void *
+large_alloc(size_t size) {
+    size_t len = ROUNDUP(size + ALIGN, PGSIZE);
+    char *p;
+    if ((p = mmap(NULL, len, MMAP_WRITE)) == NULL) {
+        return NULL;
+    }
+    TAG(p + ALIGN) = len | LARGE_OBJ;
+    return p + ALIGN;
+}
+
+static void
+large_free(void *obj) {
+    munmap((char *)obj - ALIGN, SIZE(TAG(obj)));
+}
+
+// usable_size - # of bytes can be used in the object ptr
+static size_t
+usable_size(void *ptr) {
+    size_t tag = TAG(ptr);
+    if (tag & SMALL_OBJ) {
+        return class_size[tag >> 3];
+    }
+    if (tag & LARGE_OBJ) {
+        return SIZE(tag) - ALIGN;
+    }
+    return SIZE(tag) - 2 * sizeof(size_t);
+}
+
+void *
+malloc(size_t size) {
+    // no user space is that large, and the sizes below can't overflow
+    if (size == 0 || size > ((size_t)-1 >> 1)) {
+        return NULL;
+    }
+    void *ptr;
+    if (size >= LARGE_MIN) {
+        // mmap doesn't touch the heap, no lock needed
+        if ((ptr = large_alloc(size)) != NULL) {
+            return ptr;
+        }
+    }
+    lock(&malloc_lock);
+    if (size <= SMALL_MAX) {
+        ptr = small_alloc(size);
+    }
+    else {
+        // also the fallback of large objects when there is no room for mmap
+        ptr = heap_alloc(size);
+    }
+    unlock(&malloc_lock);
+    return ptr;
+}
+
+void
+free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    size_t tag = TAG(ptr);
+    if (tag & LARGE_OBJ) {
+        large_free(ptr);
+        return;
+    }
+    lock(&malloc_lock);
+    if (tag & SMALL_OBJ) {
+        small_free(ptr);
+    }
+    else {
+        assert(tag & HEAP_ALLOC);
+        heap_free(ptr);
+    }
+    unlock(&malloc_lock);
+}
+
+void *
+calloc(size_t nmemb, size_t size) {
+    if (nmemb != 0 && size > (size_t)-1 / nmemb) {
+        return NULL;
+    }
+    void *ptr;
+    if ((ptr = malloc(nmemb * size)) != NULL) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+
+void *
+realloc(void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return malloc(size);
+    }
+    if (size == 0) {
+        free(ptr);
+        return NULL;
+    }
+    size_t old_size = usable_size(ptr);
+    if (size <= old_size && (size > SMALL_MAX || old_size <= SMALL_MAX)) {
+        return ptr;
+    }
+    void *nptr;
+    if ((nptr = malloc(size)) != NULL) {
+        memcpy(nptr, ptr, (size < old_size) ? size : old_size);
+        free(ptr);
+    }
+    return nptr;
+}
+
@@ -4,6 +4,7 @@
 #include <syscall.h>
 #include <stat.h>
 #include <dirent.h>
+#include <uio.h>
 
 
 #define MAX_ARGS            5
@@ -63,6 +64,21 @@ sys_getpid(void) {
     return syscall(SYS_getpid);
 }
 
+int
+sys_brk(uintptr_t *brk_store) {
+    return syscall(SYS_brk, brk_store);
+}
+
+int
+sys_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags) {
+    return syscall(SYS_mmap, addr_store, len, mmap_flags);
+}
+
+int
+sys_munmap(uintptr_t addr, size_t len) {
+    return syscall(SYS_munmap, addr, len);
+}
+
 int
 sys_putc(int c) {
     return syscall(SYS_putc, c);
@@ -114,6 +130,26 @@ sys_write(int fd, void *base, size_t len) {
     return syscall(SYS_write, fd, base, len);
 }
 
+int
+sys_pread(int fd, void *base, size_t len, off_t pos) {
+    return syscall(SYS_pread, fd, base, len, pos);
+}
+
+int
+sys_pwrite(int fd, void *base, size_t len, off_t pos) {
+    return syscall(SYS_pwrite, fd, base, len, pos);
+}
+
+int
+sys_readv(int fd, struct iovec *iov, int iovcnt) {
+    return syscall(SYS_readv, fd, iov, iovcnt);
+}
+
+int
+sys_writev(int fd, struct iovec *iov, int iovcnt) {
+    return syscall(SYS_writev, fd, iov, iovcnt);
+}
+
 int
 sys_seek(int fd, off_t pos, int whence) {
     return syscall(SYS_seek, fd, pos, whence);
@@ -129,6 +165,11 @@ sys_fsync(int fd) {
     return syscall(SYS_fsync, fd);
 }
 
+int
+sys_fallocate(int fd, off_t pos, off_t len) {
+    return syscall(SYS_fallocate, fd, pos, len);
+}
+
 int
 sys_getcwd(char *buffer, size_t len) {
     return syscall(SYS_getcwd, buffer, len);
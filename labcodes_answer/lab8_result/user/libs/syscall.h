@@ -8,6 +8,9 @@ int sys_exec(const char *name, int argc, const char **argv);
 int sys_yield(void);
 int sys_kill(int pid);
 int sys_getpid(void);
+int sys_brk(uintptr_t *brk_store);
+int sys_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags);
+int sys_munmap(uintptr_t addr, size_t len);
 int sys_putc(int c);
 int sys_pgdir(void);
 int sys_sleep(unsigned int time);
@@ -15,14 +18,20 @@ size_t sys_gettime(void);
 
 struct stat;
 struct dirent;
+struct iovec;
 
 int sys_open(const char *path, uint32_t open_flags);
 int sys_close(int fd);
 int sys_read(int fd, void *base, size_t len);
 int sys_write(int fd, void *base, size_t len);
+int sys_pread(int fd, void *base, size_t len, off_t pos);
+int sys_pwrite(int fd, void *base, size_t len, off_t pos);
+int sys_readv(int fd, struct iovec *iov, int iovcnt);
+int sys_writev(int fd, struct iovec *iov, int iovcnt);
 int sys_seek(int fd, off_t pos, int whence);
 int sys_fstat(int fd, struct stat *stat);
 int sys_fsync(int fd);
+int sys_fallocate(int fd, off_t pos, off_t len);
 int sys_getcwd(char *buffer, size_t len);
 int sys_getdirentry(int fd, struct dirent *dirent);
 int sys_dup(int fd1, int fd2);
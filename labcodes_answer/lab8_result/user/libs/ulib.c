@@ -55,6 +55,41 @@ getpid(void) {
     return sys_getpid();
 }
 
+//sbrk - move the program break by increment bytes, the kernel keeps the break page aligned,
+//     - so the heap may shrink less than asked. return the old break, or (void *)-1 if failed
+void *
+sbrk(intptr_t increment) {
+    uintptr_t brk = 0;
+    if (sys_brk(&brk) != 0) {
+        return (void *)-1;
+    }
+    if (increment != 0) {
+        uintptr_t oldbrk = brk, newbrk = brk + increment;
+        brk = newbrk;
+        if (sys_brk(&brk) != 0 || (increment > 0 && brk < newbrk)) {
+            return (void *)-1;
+        }
+        return (void *)oldbrk;
+    }
+    return (void *)brk;
+}
+
+//mmap - map len bytes of anonymous memory (filled with zero), at addr if it isn't NULL,
+//     - return the start addr of the mapping, or NULL if failed
+void *
+mmap(void *addr, size_t len, uint32_t mmap_flags) {
+    uintptr_t addr_store = (uintptr_t)addr;
+    if (sys_mmap(&addr_store, len, mmap_flags) != 0) {
+        return NULL;
+    }
+    return (void *)addr_store;
+}
+
+int
+munmap(void *addr, size_t len) {
+    return sys_munmap((uintptr_t)addr, len);
+}
+
 //print_pgdir - print the PDT&PT
 void
 print_pgdir(void) {
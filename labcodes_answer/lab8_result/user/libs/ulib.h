@@ -32,6 +32,14 @@ int waitpid(int pid, int *store);
 void yield(void);
 int kill(int pid);
 int getpid(void);
+void *sbrk(intptr_t increment);
+void *mmap(void *addr, size_t len, uint32_t mmap_flags);
+int munmap(void *addr, size_t len);
+
+void *malloc(size_t size);
+void free(void *ptr);
+void *calloc(size_t nmemb, size_t size);
+void *realloc(void *ptr, size_t size);
 void print_pgdir(void);
 int sleep(unsigned int time);
 unsigned int gettime_msec(void);
@@ -0,0 +1,85 @@
+#include <ulib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define NSLOT           512
+#define ROUNDS          20000
+
+static void *slots[NSLOT];
+static size_t sizes[NSLOT];
+
+// rand_size - mostly small objects, some medium ones, and a few large ones
+static size_t
+rand_size(void) {
+    int r = rand() % 100;
+    if (r < 80) {
+        return rand() % 256 + 1;
+    }
+    if (r < 98) {
+        return rand() % 8192 + 257;
+    }
+    return rand() % (256 * 1024) + 64 * 1024;
+}
+
+static void
+fill(void *ptr, size_t size, int i) {
+    memset(ptr, (char)i, (size < 64) ? size : 64);
+}
+
+static void
+check(void *ptr, size_t size, int i) {
+    size_t j, n = (size < 64) ? size : 64;
+    for (j = 0; j < n; j ++) {
+        assert(((char *)ptr)[j] == (char)i);
+    }
+}
+
+int
+main(void) {
+    int i, j, ops = 0;
+    srand(0x9527);
+
+    unsigned int begin = gettime_msec();
+    for (i = 0; i < ROUNDS; i ++) {
+        j = rand() % NSLOT;
+        if (slots[j] == NULL) {
+            sizes[j] = rand_size();
+            assert((slots[j] = malloc(sizes[j])) != NULL);
+            fill(slots[j], sizes[j], j);
+        }
+        else if (rand() % 4 == 0) {
+            size_t size = rand_size();
+            assert((slots[j] = realloc(slots[j], size)) != NULL);
+            check(slots[j], (size < sizes[j]) ? size : sizes[j], j);
+            sizes[j] = size;
+            fill(slots[j], sizes[j], j);
+        }
+        else {
+            check(slots[j], sizes[j], j);
+            free(slots[j]);
+            slots[j] = NULL;
+        }
+        ops ++;
+    }
+    for (j = 0; j < NSLOT; j ++) {
+        if (slots[j] != NULL) {
+            check(slots[j], sizes[j], j);
+            free(slots[j]);
+            ops ++;
+        }
+    }
+
+    int *zero = calloc(1024, sizeof(int));
+    assert(zero != NULL);
+    for (i = 0; i < 1024; i ++) {
+        assert(zero[i] == 0);
+    }
+    free(zero);
+
+    unsigned int msec = gettime_msec() - begin;
+    cprintf("mallocbench: %d ops in %d msec, %d ops/sec.\n", ops, msec,
+            (msec == 0) ? 0 : ops * 1000 / (int)msec);
+    cprintf("mallocbench pass.\n");
+    return 0;
+}
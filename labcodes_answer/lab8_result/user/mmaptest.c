@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <unistd.h>
+
+#define PGSIZE          4096
+#define NPAGE           16
+
+int
+main(void) {
+    int i, pid;
+
+    char *heap = sbrk(NPAGE * PGSIZE);
+    assert(heap != (void *)-1 && (uintptr_t)heap % PGSIZE == 0);
+    for (i = 0; i < NPAGE * PGSIZE; i ++) {
+        assert(heap[i] == 0);
+        heap[i] = (char)i;
+    }
+    assert(sbrk(0) == heap + NPAGE * PGSIZE);
+    cprintf("sbrk pass.\n");
+
+    char *p = mmap(NULL, NPAGE * PGSIZE, MMAP_WRITE);
+    assert(p != NULL && p > heap);
+    for (i = 0; i < NPAGE * PGSIZE; i += PGSIZE) {
+        assert(p[i] == 0);
+        p[i] = heap[i] = 'a';
+    }
+
+    // the child sees the same content, its writes are not seen by parent
+    if ((pid = fork()) == 0) {
+        for (i = 0; i < NPAGE * PGSIZE; i += PGSIZE) {
+            assert(p[i] == 'a' && heap[i] == 'a');
+            p[i] = heap[i] = 'b';
+        }
+        assert(munmap(p + PGSIZE, PGSIZE) == 0);
+        exit(0);
+    }
+    assert(pid > 0 && waitpid(pid, NULL) == 0);
+    for (i = 0; i < NPAGE * PGSIZE; i += PGSIZE) {
+        assert(p[i] == 'a' && heap[i] == 'a');
+    }
+    cprintf("mmap pass.\n");
+
+    // punch a hole in the middle, the pages around are kept
+    assert(munmap(p + 4 * PGSIZE, 4 * PGSIZE) == 0);
+    assert(p[3 * PGSIZE] == 'a' && p[8 * PGSIZE] == 'a');
+    assert(mmap(p + 4 * PGSIZE, 2 * PGSIZE, 0) == p + 4 * PGSIZE);
+    assert(p[4 * PGSIZE] == 0);
+    assert(mmap(p + 5 * PGSIZE, 2 * PGSIZE, 0) == NULL);
+    assert(munmap(p, NPAGE * PGSIZE) == 0);
+
+    assert(sbrk(-NPAGE * PGSIZE) == heap + NPAGE * PGSIZE);
+    assert(sbrk(0) == heap);
+    cprintf("mmaptest pass.\n");
+    return 0;
+}